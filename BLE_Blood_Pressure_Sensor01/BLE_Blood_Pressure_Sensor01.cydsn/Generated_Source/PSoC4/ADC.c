@@ -30,7 +30,7 @@ volatile int32 ADC_countsPer10Volt[ADC_TOTAL_CHANNELS_NUM];   /* Gain compensati
 * Local data allocation
 ***************************************/
 /* Channels configuration generated by customiser */
-static const uint32 CYCODE ADC_channelsConfig[] = { 0x00000400u };
+static const uint32 CYCODE ADC_channelsConfig[] = { 0x00000400u, 0x00000400u };
 
 
 /*******************************************************************************
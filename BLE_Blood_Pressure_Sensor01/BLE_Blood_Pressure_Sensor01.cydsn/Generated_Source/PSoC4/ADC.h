@@ -112,14 +112,14 @@ typedef struct
 *    Initial Parameter Constants
 ***************************************/
 #define ADC_DEFAULT_SAMPLE_MODE_SEL        (1u)
-#define ADC_DEFAULT_VREF_SEL               (1u)
+#define ADC_DEFAULT_VREF_SEL               (2u)
 #define ADC_DEFAULT_NEG_INPUT_SEL          (0u)
 #define ADC_DEFAULT_ALT_RESOLUTION_SEL     (0u)
 #define ADC_DEFAULT_JUSTIFICATION_SEL      (0u)
 #define ADC_DEFAULT_DIFF_RESULT_FORMAT_SEL (0u)
 #define ADC_DEFAULT_SE_RESULT_FORMAT_SEL   (1u)
 #define ADC_DEFAULT_CLOCK_SOURCE           (1u)
-#define ADC_DEFAULT_VREF_MV_VALUE          (3300)
+#define ADC_DEFAULT_VREF_MV_VALUE          (1024)
 #define ADC_DEFAULT_BUFFER_GAIN            (0u)
 #define ADC_DEFAULT_AVG_SAMPLES_NUM        (4u)
 #define ADC_DEFAULT_AVG_SAMPLES_DIV        (int16)(0x100u >> (7u - 4u))
@@ -132,11 +132,11 @@ typedef struct
 #define ADC_DEFAULT_BCLKS_NUM              (4u)
 #define ADC_DEFAULT_CCLKS_NUM              (4u)
 #define ADC_DEFAULT_DCLKS_NUM              (4u)
-#define ADC_TOTAL_CHANNELS_NUM             (1u)
+#define ADC_TOTAL_CHANNELS_NUM             (2u)
 #define ADC_SEQUENCED_CHANNELS_NUM         (1u)
 #define ADC_DEFAULT_EN_CHANNELS            (1u)
 #define ADC_NOMINAL_CLOCK_FREQ             (1600000)
-#define ADC_INJ_CHANNEL_ENABLED            (0u)
+#define ADC_INJ_CHANNEL_ENABLED            (1u)
 #define ADC_IRQ_REMOVE                     (0u)
 
 /* Determines whether the configuration contains external negative input. */
@@ -0,0 +1,151 @@
+/*******************************************************************************
+* File Name: Battery_Sense.c  
+* Version 2.10
+*
+* Description:
+*  This file contains API to enable firmware control of a Pins component.
+*
+* Note:
+*
+********************************************************************************
+* Copyright 2008-2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions, 
+* disclaimers, and limitations in the end user license agreement accompanying 
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "cytypes.h"
+#include "Battery_Sense.h"
+
+#define SetP4PinDriveMode(shift, mode)  \
+    do { \
+        Battery_Sense_PC =   (Battery_Sense_PC & \
+                                (uint32)(~(uint32)(Battery_Sense_DRIVE_MODE_IND_MASK << (Battery_Sense_DRIVE_MODE_BITS * (shift))))) | \
+                                (uint32)((uint32)(mode) << (Battery_Sense_DRIVE_MODE_BITS * (shift))); \
+    } while (0)
+
+
+/*******************************************************************************
+* Function Name: Battery_Sense_Write
+********************************************************************************
+*
+* Summary:
+*  Assign a new value to the digital port's data output register.  
+*
+* Parameters:  
+*  prtValue:  The value to be assigned to the Digital Port. 
+*
+* Return: 
+*  None 
+*  
+*******************************************************************************/
+void Battery_Sense_Write(uint8 value) 
+{
+    uint8 drVal = (uint8)(Battery_Sense_DR & (uint8)(~Battery_Sense_MASK));
+    drVal = (drVal | ((uint8)(value << Battery_Sense_SHIFT) & Battery_Sense_MASK));
+    Battery_Sense_DR = (uint32)drVal;
+}
+
+
+/*******************************************************************************
+* Function Name: Battery_Sense_SetDriveMode
+********************************************************************************
+*
+* Summary:
+*  Change the drive mode on the pins of the port.
+* 
+* Parameters:  
+*  mode:  Change the pins to one of the following drive modes.
+*
+*  Battery_Sense_DM_STRONG     Strong Drive 
+*  Battery_Sense_DM_OD_HI      Open Drain, Drives High 
+*  Battery_Sense_DM_OD_LO      Open Drain, Drives Low 
+*  Battery_Sense_DM_RES_UP     Resistive Pull Up 
+*  Battery_Sense_DM_RES_DWN    Resistive Pull Down 
+*  Battery_Sense_DM_RES_UPDWN  Resistive Pull Up/Down 
+*  Battery_Sense_DM_DIG_HIZ    High Impedance Digital 
+*  Battery_Sense_DM_ALG_HIZ    High Impedance Analog 
+*
+* Return: 
+*  None
+*
+*******************************************************************************/
+void Battery_Sense_SetDriveMode(uint8 mode) 
+{
+	SetP4PinDriveMode(Battery_Sense__0__SHIFT, mode);
+}
+
+
+/*******************************************************************************
+* Function Name: Battery_Sense_Read
+********************************************************************************
+*
+* Summary:
+*  Read the current value on the pins of the Digital Port in right justified 
+*  form.
+*
+* Parameters:  
+*  None 
+*
+* Return: 
+*  Returns the current value of the Digital Port as a right justified number
+*  
+* Note:
+*  Macro Battery_Sense_ReadPS calls this function. 
+*  
+*******************************************************************************/
+uint8 Battery_Sense_Read(void) 
+{
+    return (uint8)((Battery_Sense_PS & Battery_Sense_MASK) >> Battery_Sense_SHIFT);
+}
+
+
+/*******************************************************************************
+* Function Name: Battery_Sense_ReadDataReg
+********************************************************************************
+*
+* Summary:
+*  Read the current value assigned to a Digital Port's data output register
+*
+* Parameters:  
+*  None 
+*
+* Return: 
+*  Returns the current value assigned to the Digital Port's data output register
+*  
+*******************************************************************************/
+uint8 Battery_Sense_ReadDataReg(void) 
+{
+    return (uint8)((Battery_Sense_DR & Battery_Sense_MASK) >> Battery_Sense_SHIFT);
+}
+
+
+/* If Interrupts Are Enabled for this Pins component */ 
+#if defined(Battery_Sense_INTSTAT) 
+
+    /*******************************************************************************
+    * Function Name: Battery_Sense_ClearInterrupt
+    ********************************************************************************
+    *
+    * Summary:
+    *  Clears any active interrupts attached to port and returns the value of the 
+    *  interrupt status register.
+    *
+    * Parameters:  
+    *  None 
+    *
+    * Return: 
+    *  Returns the value of the interrupt status register
+    *  
+    *******************************************************************************/
+    uint8 Battery_Sense_ClearInterrupt(void) 
+    {
+		uint8 maskedStatus = (uint8)(Battery_Sense_INTSTAT & Battery_Sense_MASK);
+		Battery_Sense_INTSTAT = maskedStatus;
+        return maskedStatus >> Battery_Sense_SHIFT;
+    }
+
+#endif /* If Interrupts Are Enabled for this Pins component */ 
+
+
+/* [] END OF FILE */
@@ -23,6 +23,12 @@
 #define ADC_cy_psoc4_sar__SAR_SATURATE_INTR_SET CYREG_SAR_SATURATE_INTR_SET
 #define ADC_cy_psoc4_sar__SAR_STATUS CYREG_SAR_STATUS
 
+/* ADC_cy_psoc4_sarmux_8 */
+#define ADC_cy_psoc4_sarmux_8__CH_0_PIN 0
+#define ADC_cy_psoc4_sarmux_8__CH_0_PORT 0
+#define ADC_cy_psoc4_sarmux_8__CH_1_PIN 1
+#define ADC_cy_psoc4_sarmux_8__CH_1_PORT 0
+
 /* ADC_intClock */
 #define ADC_intClock__CTRL_REGISTER CYREG_PERI_PCLK_CTL06
 #define ADC_intClock__DIV_ID 0x00000041u
@@ -104,6 +110,69 @@
 #define SW2__SHIFT 7
 #define SW2__SNAP CYREG_GPIO_PRT2_INTR
 
+/* Battery_Sense */
+#define Battery_Sense__0__DR CYREG_GPIO_PRT3_DR
+#define Battery_Sense__0__DR_CLR CYREG_GPIO_PRT3_DR_CLR
+#define Battery_Sense__0__DR_INV CYREG_GPIO_PRT3_DR_INV
+#define Battery_Sense__0__DR_SET CYREG_GPIO_PRT3_DR_SET
+#define Battery_Sense__0__HSIOM CYREG_HSIOM_PORT_SEL3
+#define Battery_Sense__0__HSIOM_MASK 0x000000F0u
+#define Battery_Sense__0__HSIOM_SHIFT 4u
+#define Battery_Sense__0__INTCFG CYREG_GPIO_PRT3_INTR_CFG
+#define Battery_Sense__0__INTR CYREG_GPIO_PRT3_INTR
+#define Battery_Sense__0__INTR_CFG CYREG_GPIO_PRT3_INTR_CFG
+#define Battery_Sense__0__INTSTAT CYREG_GPIO_PRT3_INTR
+#define Battery_Sense__0__MASK 0x02u
+#define Battery_Sense__0__PA__CFG0 CYREG_UDB_PA3_CFG0
+#define Battery_Sense__0__PA__CFG1 CYREG_UDB_PA3_CFG1
+#define Battery_Sense__0__PA__CFG10 CYREG_UDB_PA3_CFG10
+#define Battery_Sense__0__PA__CFG11 CYREG_UDB_PA3_CFG11
+#define Battery_Sense__0__PA__CFG12 CYREG_UDB_PA3_CFG12
+#define Battery_Sense__0__PA__CFG13 CYREG_UDB_PA3_CFG13
+#define Battery_Sense__0__PA__CFG14 CYREG_UDB_PA3_CFG14
+#define Battery_Sense__0__PA__CFG2 CYREG_UDB_PA3_CFG2
+#define Battery_Sense__0__PA__CFG3 CYREG_UDB_PA3_CFG3
+#define Battery_Sense__0__PA__CFG4 CYREG_UDB_PA3_CFG4
+#define Battery_Sense__0__PA__CFG5 CYREG_UDB_PA3_CFG5
+#define Battery_Sense__0__PA__CFG6 CYREG_UDB_PA3_CFG6
+#define Battery_Sense__0__PA__CFG7 CYREG_UDB_PA3_CFG7
+#define Battery_Sense__0__PA__CFG8 CYREG_UDB_PA3_CFG8
+#define Battery_Sense__0__PA__CFG9 CYREG_UDB_PA3_CFG9
+#define Battery_Sense__0__PC CYREG_GPIO_PRT3_PC
+#define Battery_Sense__0__PC2 CYREG_GPIO_PRT3_PC2
+#define Battery_Sense__0__PORT 3u
+#define Battery_Sense__0__PS CYREG_GPIO_PRT3_PS
+#define Battery_Sense__0__SHIFT 1
+#define Battery_Sense__DR CYREG_GPIO_PRT3_DR
+#define Battery_Sense__DR_CLR CYREG_GPIO_PRT3_DR_CLR
+#define Battery_Sense__DR_INV CYREG_GPIO_PRT3_DR_INV
+#define Battery_Sense__DR_SET CYREG_GPIO_PRT3_DR_SET
+#define Battery_Sense__INTCFG CYREG_GPIO_PRT3_INTR_CFG
+#define Battery_Sense__INTR CYREG_GPIO_PRT3_INTR
+#define Battery_Sense__INTR_CFG CYREG_GPIO_PRT3_INTR_CFG
+#define Battery_Sense__INTSTAT CYREG_GPIO_PRT3_INTR
+#define Battery_Sense__MASK 0x02u
+#define Battery_Sense__PA__CFG0 CYREG_UDB_PA3_CFG0
+#define Battery_Sense__PA__CFG1 CYREG_UDB_PA3_CFG1
+#define Battery_Sense__PA__CFG10 CYREG_UDB_PA3_CFG10
+#define Battery_Sense__PA__CFG11 CYREG_UDB_PA3_CFG11
+#define Battery_Sense__PA__CFG12 CYREG_UDB_PA3_CFG12
+#define Battery_Sense__PA__CFG13 CYREG_UDB_PA3_CFG13
+#define Battery_Sense__PA__CFG14 CYREG_UDB_PA3_CFG14
+#define Battery_Sense__PA__CFG2 CYREG_UDB_PA3_CFG2
+#define Battery_Sense__PA__CFG3 CYREG_UDB_PA3_CFG3
+#define Battery_Sense__PA__CFG4 CYREG_UDB_PA3_CFG4
+#define Battery_Sense__PA__CFG5 CYREG_UDB_PA3_CFG5
+#define Battery_Sense__PA__CFG6 CYREG_UDB_PA3_CFG6
+#define Battery_Sense__PA__CFG7 CYREG_UDB_PA3_CFG7
+#define Battery_Sense__PA__CFG8 CYREG_UDB_PA3_CFG8
+#define Battery_Sense__PA__CFG9 CYREG_UDB_PA3_CFG9
+#define Battery_Sense__PC CYREG_GPIO_PRT3_PC
+#define Battery_Sense__PC2 CYREG_GPIO_PRT3_PC2
+#define Battery_Sense__PORT 3u
+#define Battery_Sense__PS CYREG_GPIO_PRT3_PS
+#define Battery_Sense__SHIFT 1
+
 /* Vref */
 #define Vref__0__DR CYREG_GPIO_PRT3_DR
 #define Vref__0__DR_CLR CYREG_GPIO_PRT3_DR_CLR
@@ -36,6 +36,8 @@
 #include <CYBLE_bls.h>
 #include <Vref.h>
 #include <Vref_aliases.h>
+#include <Battery_Sense.h>
+#include <Battery_Sense_aliases.h>
 #include <UART_DEB.h>
 #include <UART_DEB_SPI_UART.h>
 #include <UART_DEB_PINS.h>
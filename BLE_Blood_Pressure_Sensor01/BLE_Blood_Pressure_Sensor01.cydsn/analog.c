@@ -0,0 +1,137 @@
+/*******************************************************************************
+* File Name: analog.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the analog front end power gating. The SAR and the
+*  pressure transducer are powered only while a measurement needs them: the
+*  battery read, a calibration capture or the waveform stream. The SAR is
+*  started on its first use and then put to sleep and woken with ADC_Sleep()
+*  and ADC_Wakeup(); the transducer is switched by a GPIO.
+*
+*  Settling: ADC_Enable() waits for the SAR to settle on the VDDA reference.
+*  The transducer needs ANALOG_SENSOR_SETTLE_MS after power up, which is
+*  waited for before the first sample. A rail that is already powered for
+*  another user needs no settling.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "analog.h"
+#include "boot.h"
+#include "energy.h"
+
+
+static const uint8 analogUserRails[ANALOG_USER_COUNT] =
+{
+    ANALOG_RAIL_SAR,
+    ANALOG_RAIL_SAR | ANALOG_RAIL_SENSOR,
+    ANALOG_RAIL_SAR | ANALOG_RAIL_SENSOR
+};
+
+static uint8 analogUsers;                               /* Bitmask of ANALOG_USER_T */
+static uint8 analogRails;                               /* Powered rails */
+
+
+/*******************************************************************************
+* Function Name: AnalogSetRails
+********************************************************************************
+*
+* Summary:
+*   Powers the rails the users need and gates the others.
+*
+*******************************************************************************/
+static void AnalogSetRails(void)
+{
+    uint8 rails = 0u;
+    uint8 up;
+    uint8 down;
+    uint32 i;
+
+    for(i = 0u; i < ANALOG_USER_COUNT; i++)
+    {
+        if((analogUsers & (1u << i)) != 0u)
+        {
+            rails |= analogUserRails[i];
+        }
+    }
+    up = rails & (uint8)~analogRails;
+    down = analogRails & (uint8)~rails;
+    analogRails = rails;
+
+    if((down & ANALOG_RAIL_SENSOR) != 0u)
+    {
+    #if (ANALOG_SENSOR_SWITCH != 0u)
+        Sensor_Power_Write(ANALOG_SENSOR_OFF);
+    #endif /* (ANALOG_SENSOR_SWITCH != 0u) */
+        EnergySubsystemStop(ENERGY_SUB_SENSOR);
+    }
+    if((down & ANALOG_RAIL_SAR) != 0u)
+    {
+        ADC_Sleep();
+        EnergySubsystemStop(ENERGY_SUB_SAR);
+    }
+
+    if((up & ANALOG_RAIL_SAR) != 0u)
+    {
+        EnergySubsystemStart(ENERGY_SUB_SAR);
+        if(BootAdcStart() == DISABLED)
+        {
+            ADC_Wakeup();
+        }
+    }
+    if((up & ANALOG_RAIL_SENSOR) != 0u)
+    {
+        EnergySubsystemStart(ENERGY_SUB_SENSOR);
+    #if (ANALOG_SENSOR_SWITCH != 0u)
+        Sensor_Power_Write(ANALOG_SENSOR_ON);
+        CyDelay(ANALOG_SENSOR_SETTLE_MS);
+    #endif /* (ANALOG_SENSOR_SWITCH != 0u) */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: AnalogAcquire
+********************************************************************************
+*
+* Summary:
+*   Powers the front end for a measurement and returns once it has settled.
+*   Must be called from the main loop.
+*
+* Parameters:
+*   user - the measurement.
+*
+*******************************************************************************/
+void AnalogAcquire(ANALOG_USER_T user)
+{
+    analogUsers |= (uint8)(1u << user);
+    AnalogSetRails();
+}
+
+
+/*******************************************************************************
+* Function Name: AnalogRelease
+********************************************************************************
+*
+* Summary:
+*   Ends a measurement of AnalogAcquire() and gates the rails no other
+*   measurement needs.
+*
+*******************************************************************************/
+void AnalogRelease(ANALOG_USER_T user)
+{
+    analogUsers &= (uint8)~(uint8)(1u << user);
+    AnalogSetRails();
+}
+
+
+/* [] END OF FILE */
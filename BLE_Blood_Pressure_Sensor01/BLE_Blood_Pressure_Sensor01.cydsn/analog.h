@@ -0,0 +1,73 @@
+/*******************************************************************************
+* File Name: analog.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the analog front end
+*  power gating.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ANALOG_H)
+#define ANALOG_H
+
+#include "common.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+
+/* The transducer supply is switched by a Sensor_Power pin when the design
+*  has one. Without it the transducer stays powered and the energy
+*  accounting shows the saving the pin would give. */
+#if defined(Sensor_Power__PC)
+    #define ANALOG_SENSOR_SWITCH    (1u)
+#else
+    #define ANALOG_SENSOR_SWITCH    (0u)
+#endif /* defined(Sensor_Power__PC) */
+
+#define ANALOG_SENSOR_SETTLE_MS     (20u)       /* Transducer and amplifier settling after power up */
+
+
+/***************************************
+*          Constants
+***************************************/
+#define ANALOG_RAIL_SAR             (0x01u)
+#define ANALOG_RAIL_SENSOR          (0x02u)
+
+#define ANALOG_SENSOR_ON            (1u)
+#define ANALOG_SENSOR_OFF           (0u)
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef enum
+{
+    ANALOG_USER_BATTERY,                        /* SAR only */
+    ANALOG_USER_CALIB,                          /* SAR and transducer */
+    ANALOG_USER_WAVE,                           /* SAR and transducer */
+    ANALOG_USER_COUNT
+}ANALOG_USER_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void AnalogAcquire(ANALOG_USER_T user);
+void AnalogRelease(ANALOG_USER_T user);
+
+
+#endif /* ANALOG_H */
+
+/* [] END OF FILE */
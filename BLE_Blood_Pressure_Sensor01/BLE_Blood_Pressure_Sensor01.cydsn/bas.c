@@ -18,6 +18,10 @@
 
 #include "common.h"
 #include "bas.h"
+#include "energy.h"
+#include "profile.h"
+#include "analog.h"
+#include "wave.h"
 
 #if (BAS_SIMULATE_ENABLE != 0u)
 uint16 batterySimulation = DISABLED;
@@ -25,6 +29,33 @@ uint16 batterySimulation = DISABLED;
 
 #if (BAS_MEASURE_ENABLE != 0u)
 uint16 batteryMeasure = DISABLED;
+uint8 batteryNtfLevel = BATTERY_LEVEL_INVALID;  /* Last notified Battery Level */
+uint32 batteryNtfSuppressed = 0u;               /* Notifications suppressed in the current hour */
+uint32 batteryNtfSuppressedLastHour = 0u;       /* Notifications suppressed in the previous hour */
+
+static uint32 basStaleTimer = 0u;               /* Seconds since the last notification */
+static uint32 basStatTimer = BATTERY_NTF_STAT_PERIOD;
+static uint8 basNtfPending = DISABLED;          /* Notification waiting for a free stack */
+#if (BAS_MEASURE_INJ != 0u)
+static uint8 basInjPending = DISABLED;          /* Injection conversion armed, holding the SAR */
+#endif /* (BAS_MEASURE_INJ != 0u) */
+
+/* VDD in mV at every 16th ADC code, generated at compile time */
+static const uint16 basMvoltsLut[BAS_LUT_SIZE] =
+{
+    BAS_LUT_ENTRY(0u), BAS_LUT_ENTRY(1u), BAS_LUT_ENTRY(2u), BAS_LUT_ENTRY(3u),
+    BAS_LUT_ENTRY(4u), BAS_LUT_ENTRY(5u), BAS_LUT_ENTRY(6u), BAS_LUT_ENTRY(7u),
+    BAS_LUT_ENTRY(8u), BAS_LUT_ENTRY(9u), BAS_LUT_ENTRY(10u), BAS_LUT_ENTRY(11u),
+    BAS_LUT_ENTRY(12u), BAS_LUT_ENTRY(13u), BAS_LUT_ENTRY(14u), BAS_LUT_ENTRY(15u),
+    BAS_LUT_ENTRY(16u), BAS_LUT_ENTRY(17u), BAS_LUT_ENTRY(18u), BAS_LUT_ENTRY(19u),
+    BAS_LUT_ENTRY(20u), BAS_LUT_ENTRY(21u), BAS_LUT_ENTRY(22u), BAS_LUT_ENTRY(23u),
+    BAS_LUT_ENTRY(24u), BAS_LUT_ENTRY(25u), BAS_LUT_ENTRY(26u), BAS_LUT_ENTRY(27u),
+    BAS_LUT_ENTRY(28u), BAS_LUT_ENTRY(29u), BAS_LUT_ENTRY(30u), BAS_LUT_ENTRY(31u),
+    BAS_LUT_ENTRY(32u), BAS_LUT_ENTRY(33u), BAS_LUT_ENTRY(34u), BAS_LUT_ENTRY(35u),
+    BAS_LUT_ENTRY(36u), BAS_LUT_ENTRY(37u)
+};
+
+static void BasMeasureStop(void);
 #endif /* (BAS_MEASURE_ENABLE != 0) */
 
 
@@ -65,6 +96,7 @@ void BasCallBack(uint32 event, void *eventParam)
             if(BAS_SERVICE_MEASURE == locServiceIndex)
             {
                 batteryMeasure = ENABLED;
+                batteryNtfLevel = BATTERY_LEVEL_INVALID;
             }
         #endif /*  (BAS_MEASURE_ENABLE != 0) */     
             break;
@@ -80,7 +112,7 @@ void BasCallBack(uint32 event, void *eventParam)
         #if (BAS_MEASURE_ENABLE != 0)
             if(BAS_SERVICE_MEASURE == locServiceIndex)
             {
-                batteryMeasure = DISABLED;
+                BasMeasureStop();
             }
         #endif /*  (BAS_MEASURE_ENABLE != 0) */     
             break;
@@ -102,105 +134,345 @@ void BasCallBack(uint32 event, void *eventParam)
 *******************************************************************************/
 void BasInit(void)
 {
-    CYBLE_API_RESULT_T apiResult;
-    uint16 cccdValue;
-    
     /* Register service specific callback function */
     CyBle_BasRegisterAttrCallback(BasCallBack);
+}
+
+
+/*******************************************************************************
+* Function Name: BasConnected()
+********************************************************************************
+*
+* Summary:
+*   Takes over the subscriptions of the connected peer from the CCCDs in the
+*   GATT database, restored by ServerConnected(), so a bonded collector gets
+*   the battery level without rewriting the CCCD.
+*
+*******************************************************************************/
+void BasConnected(void)
+{
+    CYBLE_API_RESULT_T apiResult;
+    uint16 cccdValue;
 
-    /* Read CCCD configurations from flash */
 #if (BAS_SIMULATE_ENABLE != 0)
+    batterySimulation = DISABLED;
     apiResult = CyBle_BassGetCharacteristicDescriptor(BAS_SERVICE_SIMULATE, CYBLE_BAS_BATTERY_LEVEL,
         CYBLE_BAS_BATTERY_LEVEL_CCCD, CYBLE_CCCD_LEN, (uint8 *)&cccdValue);
     if((apiResult == CYBLE_ERROR_OK) && (cccdValue != 0u))
     {
-        batterySimulation |= ENABLED;
+        batterySimulation = ENABLED;
     }
 #endif /* (BAS_SIMULATE_ENABLE != 0) */
 #if (BAS_MEASURE_ENABLE != 0)
+    BasMeasureStop();
     apiResult = CyBle_BassGetCharacteristicDescriptor(BAS_SERVICE_MEASURE, CYBLE_BAS_BATTERY_LEVEL,
         CYBLE_BAS_BATTERY_LEVEL_CCCD, CYBLE_CCCD_LEN, (uint8 *)&cccdValue);
     if((apiResult == CYBLE_ERROR_OK) && (cccdValue != 0u))
     {
-        batteryMeasure |= ENABLED;
+        batteryMeasure = ENABLED;
+        batteryNtfLevel = BATTERY_LEVEL_INVALID;
     }
 #endif /* (BAS_MEASURE_ENABLE != 0) */
 }
 
 
+/*******************************************************************************
+* Function Name: BasDisconnected()
+********************************************************************************
+*
+* Summary:
+*   Stops the battery reporting when the link drops.
+*
+*******************************************************************************/
+void BasDisconnected(void)
+{
+#if (BAS_MEASURE_ENABLE != 0)
+    BasMeasureStop();
+#endif /* (BAS_MEASURE_ENABLE != 0) */
+}
+
+
 #if (BAS_MEASURE_ENABLE != 0)
     
 
+/*******************************************************************************
+* Function Name: BasMeasureStop()
+********************************************************************************
+*
+* Summary:
+*   Stops the battery reporting and drops a notification still waiting for
+*   the stack, so it is not sent on the next connection. An injection
+*   conversion still pending is abandoned: the injection channel is
+*   disarmed, its end of conversion cleared, and the SAR rail vote and the
+*   ADC busy time it holds are released.
+*
+*******************************************************************************/
+static void BasMeasureStop(void)
+{
+    batteryMeasure = DISABLED;
+    basNtfPending = DISABLED;
+#if (BAS_MEASURE_INJ != 0u)
+    if(basInjPending != DISABLED)
+    {
+        /* The component has no call to disable the injection channel */
+        ADC_SAR_INJ_CHAN_CONFIG_REG &= ~ADC_INJ_CHAN_EN;
+        (void)ADC_IsEndConversion(ADC_RETURN_STATUS_INJ);
+        EnergySubsystemStop(ENERGY_SUB_ADC);
+        AnalogRelease(ANALOG_USER_BATTERY);
+        basInjPending = DISABLED;
+    }
+#endif /* (BAS_MEASURE_INJ != 0u) */
+}
+
+
+/*******************************************************************************
+* Function Name: BasAdcToMvolts()
+********************************************************************************
+*
+* Summary:
+*   Converts ADC counts of the 1.024V reference measured against VDD to the
+*   VDD voltage. Uses the reciprocal lookup table with linear interpolation
+*   between entries instead of a division.
+*
+* Parameters:
+*  adcResult - ADC counts.
+*
+* Return:
+*  Battery voltage in mV.
+*
+*******************************************************************************/
+uint16 BasAdcToMvolts(int16 adcResult)
+{
+    uint32 code;
+    uint32 idx;
+    uint32 frac;
+    uint16 mvolts;
+    
+    if(adcResult <= BAS_LUT_ADC_MIN)
+    {
+        code = 0u;
+    }
+    else
+    {
+        code = (uint32)adcResult - BAS_LUT_ADC_MIN;
+        if(code > BAS_LUT_CODE_MAX)
+        {
+            code = BAS_LUT_CODE_MAX;
+        }
+    }
+    
+    idx = code >> BAS_LUT_SHIFT;
+    frac = code & ((1u << BAS_LUT_SHIFT) - 1u);
+    mvolts = basMvoltsLut[idx];
+    if(frac != 0u)
+    {
+        /* The table is descending: interpolate down from the lower code */
+        mvolts -= (uint16)(((uint32)(mvolts - basMvoltsLut[idx + 1u]) * frac) >> BAS_LUT_SHIFT);
+    }
+    return(mvolts);
+}
+
+
+/*******************************************************************************
+* Function Name: BasMvoltsToLevel()
+********************************************************************************
+*
+* Summary:
+*   Converts battery voltage to percentage using linear approximation divided
+*   to two sections according to the selected battery profile. The slopes are
+*   compile time constants, so no division is performed.
+*
+* Parameters:
+*  mvolts - battery voltage in mV.
+*
+* Return:
+*  Battery level in percent.
+*
+*******************************************************************************/
+uint8 BasMvoltsToLevel(uint16 mvolts)
+{
+    uint8 batteryLevel;
+    
+    if(mvolts < MEASURE_BATTERY_MIN)
+    {
+        batteryLevel = 0u;
+    }
+    else if(mvolts < MEASURE_BATTERY_MID)
+    {
+        batteryLevel = (uint8)(((uint32)(mvolts - MEASURE_BATTERY_MIN) * BAS_SLOPE_LOW) >> 16u);
+    }
+    else if(mvolts < MEASURE_BATTERY_MAX)
+    {
+        batteryLevel = (uint8)(MEASURE_BATTERY_MID_PERCENT + 
+                       (((uint32)(mvolts - MEASURE_BATTERY_MID) * BAS_SLOPE_HIGH) >> 16u));
+    }
+    else
+    {
+        batteryLevel = CYBLE_BAS_MAX_BATTERY_LEVEL_VALUE;
+    }
+    return(batteryLevel);
+}
+
+
+/*******************************************************************************
+* Function Name: BasReadMvolts
+********************************************************************************
+*
+* Summary:
+*   Measures the battery voltage.
+*
+*   Injection channel: the conversion is enabled for the next scan. While
+*   the pressure stream runs it tailgates one of the stream scans, which
+*   keeps its sample and its reference, and the result is polled on the
+*   following calls. Otherwise a scan is started and waited for. The
+*   counts scale to mV with a multiply, the reference being fixed.
+*
+*   Reference capacitor: the bypass capacitor is charged to VBG, then the
+*   reference is switched back to VDDA and the capacitor voltage converted.
+*   Blocks for 26 ms and must not run while the stream does.
+*
+* Parameters:
+*   mvolts - receives the battery voltage.
+*
+* Return:
+*   ENABLED if the voltage was measured, DISABLED if the injection
+*   conversion is still pending.
+*
+*******************************************************************************/
+static uint8 BasReadMvolts(uint16 *mvolts)
+{
+    int16 adcResult;
+    uint8 measured = ENABLED;
+#if (BAS_MEASURE_INJ != 0u)
+    if(basInjPending == DISABLED)
+    {
+        AnalogAcquire(ANALOG_USER_BATTERY);
+        EnergySubsystemStart(ENERGY_SUB_ADC);
+        ADC_EnableInjection();
+        basInjPending = ENABLED;
+    }
+
+    if(WaveRunning() == DISABLED)
+    {
+        /* No stream scan to tailgate */
+        ADC_StartConvert();
+        (void)ADC_IsEndConversion(ADC_WAIT_FOR_RESULT_INJ);
+    }
+    else if(ADC_IsEndConversion(ADC_RETURN_STATUS_INJ) == 0u)
+    {
+        measured = DISABLED;
+    }
+    else
+    {
+        /* Converted after the pressure channel of a stream scan */
+    }
+
+    if(measured != DISABLED)
+    {
+        adcResult = ADC_GetResult16(ADC_BATTERY_INJ_CHANNEL);
+        EnergySubsystemStop(ENERGY_SUB_ADC);
+        AnalogRelease(ANALOG_USER_BATTERY);
+        basInjPending = DISABLED;
+        *mvolts = (adcResult > 0) ? (uint16)(((uint32)adcResult * BAS_INJ_MV_PER_COUNT) >> 16u) : 0u;
+    }
+#else
+    uint32 sarControlReg;
+
+    AnalogAcquire(ANALOG_USER_BATTERY);
+    EnergySubsystemStart(ENERGY_SUB_ADC);
+    
+	/* Set the reference to VBG and enable reference bypass */
+	sarControlReg = ADC_SAR_CTRL_REG & ~ADC_VREF_MASK;
+	ADC_SAR_CTRL_REG = sarControlReg | ADC_VREF_INTERNAL1024BYPASSED;
+	
+	/* 25 ms delay for reference capacitor to charge */
+	CyDelay(25);             
+	
+	/* Set the reference to VDD and disable reference bypass */
+	sarControlReg = ADC_SAR_CTRL_REG & ~ADC_VREF_MASK;
+	ADC_SAR_CTRL_REG = sarControlReg | ADC_VREF_VDDA;
+
+	/* Perform a measurement. Store this value in Vref. */
+	CyDelay(1);
+	ADC_StartConvert();
+	ADC_IsEndConversion(ADC_WAIT_FOR_RESULT);
+
+    adcResult = ADC_GetResult16(ADC_BATTERY_CHANNEL);
+    EnergySubsystemStop(ENERGY_SUB_ADC);
+    AnalogRelease(ANALOG_USER_BATTERY);
+	/* Calculate input voltage by using ratio of ADC counts from reference
+	*  and ADC Full Scale counts. 
+    */
+	*mvolts = BasAdcToMvolts(adcResult);
+#endif /* (BAS_MEASURE_INJ != 0u) */
+    return(measured);
+}
+
+
+/*******************************************************************************
+* Function Name: BasTick()
+********************************************************************************
+*
+* Summary:
+*   Advances the notification age and the suppressed notification statistics
+*   by one second. Called on every 1 second timer event, whether or not a
+*   client is subscribed, so the statistics cover wall clock hours.
+*
+*******************************************************************************/
+void BasTick(void)
+{
+    if(--basStatTimer == 0u)
+    {
+        basStatTimer = BATTERY_NTF_STAT_PERIOD;
+        batteryNtfSuppressedLastHour = batteryNtfSuppressed;
+        batteryNtfSuppressed = 0u;
+        printf("Battery Level notifications suppressed last hour: %ld \r\n", batteryNtfSuppressedLastHour);
+    }
+    
+    if(basStaleTimer < BATTERY_NTF_MAX_STALE)
+    {
+        basStaleTimer++;
+    }
+}
+
+
 /*******************************************************************************
 * Function Name: MeasureBattery()
 ********************************************************************************
 *
 * Summary:
 *   This function measures the battery voltage and sends it to the client.
+*   The Battery Level is notified only when it moved by the hysteresis band
+*   since the last notification or when the last notification is older than
+*   BATTERY_NTF_MAX_STALE. A notification refused by a busy stack is retried
+*   on the next call instead of disabling the measurement.
 *
 *******************************************************************************/
 void MeasureBattery(void)
 {
-	int16 adcResult;
-    int32 mvolts;
-	uint32 sarControlReg;
-    uint8 batteryLevel;
     CYBLE_API_RESULT_T apiResult;
+    uint8 measured = DISABLED;
     
     static uint32 batteryTimer = BATTERY_TIMEOUT;
+    static uint16 mvolts;
+    static uint8 batteryLevel;
     
+    PROFILE_ENTER(PROFILE_MEASURE_BATTERY);
+
     if(--batteryTimer == 0u) 
     {
         batteryTimer = BATTERY_TIMEOUT;
-        
-    	/* Set the reference to VBG and enable reference bypass */
-    	sarControlReg = ADC_SAR_CTRL_REG & ~ADC_VREF_MASK;
-    	ADC_SAR_CTRL_REG = sarControlReg | ADC_VREF_INTERNAL1024BYPASSED;
-    	
-    	/* 25 ms delay for reference capacitor to charge */
-    	CyDelay(25);             
-    	
-    	/* Set the reference to VDD and disable reference bypass */
-    	sarControlReg = ADC_SAR_CTRL_REG & ~ADC_VREF_MASK;
-    	ADC_SAR_CTRL_REG = sarControlReg | ADC_VREF_VDDA;
-
-    	/* Perform a measurement. Store this value in Vref. */
-    	CyDelay(1);
-    	ADC_StartConvert();
-    	ADC_IsEndConversion(ADC_WAIT_FOR_RESULT);
-
-        adcResult = ADC_GetResult16(ADC_BATTERY_CHANNEL);
-    	/* Calculate input voltage by using ratio of ADC counts from reference
-    	*  and ADC Full Scale counts. 
-        */
-    	mvolts = (1024 * 2048) / adcResult;
-        
-        /* Convert battery level voltage to percentage using linear approximation
-        *  divided to two sections according to typical performance of 
-        *  CR2033 battery specification:
-        *  3V - 100%
-        *  2.8V - 29%
-        *  2.0V - 0%
-        */
-        if(mvolts < MEASURE_BATTERY_MIN)
-        {
-            batteryLevel = 0;
-        }
-        else if(mvolts < MEASURE_BATTERY_MID)
-        {
-            batteryLevel = (mvolts - MEASURE_BATTERY_MIN) * MEASURE_BATTERY_MID_PERCENT / 
-                           (MEASURE_BATTERY_MID - MEASURE_BATTERY_MIN); 
-        }
-        else if(mvolts < MEASURE_BATTERY_MAX)
-        {
-            batteryLevel = MEASURE_BATTERY_MID_PERCENT +
-                           (mvolts - MEASURE_BATTERY_MID) * (100 - MEASURE_BATTERY_MID_PERCENT) / 
-                           (MEASURE_BATTERY_MAX - MEASURE_BATTERY_MID); 
-        }
-        else
+        measured = BasReadMvolts(&mvolts);
+        if(measured == DISABLED)
         {
-            batteryLevel = CYBLE_BAS_MAX_BATTERY_LEVEL_VALUE;
+            /* The injection conversion tailgates the next scan of the stream, poll it next second */
+            batteryTimer = 1u;
         }
+    }
+
+    if(measured != DISABLED)
+    {
+        batteryLevel = BasMvoltsToLevel(mvolts);
         
     #if (BAS_MEASURE_LP_LED != 0u)
         if(batteryLevel < LOW_BATTERY_LIMIT)
@@ -213,19 +485,47 @@ void MeasureBattery(void)
         }
     #endif /* (BAS_MEASURE_LP_LED != 0u) */
 
+        /* Keep the readable value current even when the notification is suppressed */
+        (void)CyBle_BassSetCharacteristicValue(BAS_SERVICE_MEASURE, CYBLE_BAS_BATTERY_LEVEL, 
+                        sizeof(batteryLevel), &batteryLevel);
+        
+        if((batteryNtfLevel == BATTERY_LEVEL_INVALID) || (basStaleTimer >= BATTERY_NTF_MAX_STALE) ||
+           (batteryLevel >= (batteryNtfLevel + BATTERY_NTF_HYSTERESIS)) ||
+           ((batteryLevel + BATTERY_NTF_HYSTERESIS) <= batteryNtfLevel))
+        {
+            basNtfPending = ENABLED;
+        }
+        else
+        {
+            batteryNtfSuppressed++;
+        }
+    }
+    
+    if((basNtfPending == ENABLED) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
         /* Update Battery Level characteristic value */
         apiResult = CyBle_BassSendNotification(cyBle_connHandle, BAS_SERVICE_MEASURE, CYBLE_BAS_BATTERY_LEVEL, 
                         sizeof(batteryLevel), &batteryLevel);
-        if(apiResult != CYBLE_ERROR_OK)
+        if(apiResult == CYBLE_ERROR_OK)
         {
-            printf("BassSendNotification API Error: %x \r\n", apiResult);
-            batteryMeasure = DISABLED;
+            printf("MeasureBatteryLevelUpdate: %d, %d mV \r\n", batteryLevel, mvolts);
+            batteryNtfLevel = batteryLevel;
+            basNtfPending = DISABLED;
+            basStaleTimer = 0u;
+        }
+        else if((apiResult == CYBLE_ERROR_MEMORY_ALLOCATION_FAILED) || (apiResult == CYBLE_ERROR_INVALID_STATE))
+        {
+            /* Stack has no free buffers, retry on the next call */
+            printf("BassSendNotification busy: %x \r\n", apiResult);
         }
         else
         {
-            printf("MeasureBatteryLevelUpdate: %d \r\n",batteryLevel);
+            printf("BassSendNotification API Error: %x \r\n", apiResult);
+            BasMeasureStop();
         }
     }
+
+    PROFILE_EXIT(PROFILE_MEASURE_BATTERY);
 }
 
 #endif /*  (BAS_MEASURE_ENABLE != 0) */
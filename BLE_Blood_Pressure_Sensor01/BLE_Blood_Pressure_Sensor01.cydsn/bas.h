@@ -28,22 +28,98 @@
 #define ADC_BATTERY_CHANNEL         (0x00u)
 #endif /* (BAS_MEASURE_ENABLE != 0) */
 
+/* With the injection channel enabled in the ADC customizer, the battery is
+*  sensed on Battery_Sense through a divider and converted against the SAR
+*  reference, which must not follow the battery: against VDDA, which is the
+*  battery, the divider converts to the same count at any voltage. The ADC
+*  is configured for the internal 1.024V reference, and a VDDA reference is
+*  refused at compile time. The conversion tailgates a scan of the pressure
+*  stream, so neither stream nor reference are disturbed. Otherwise the
+*  reference capacitor method is used and the measurement waits while the
+*  stream runs.
+*/
+#if (BAS_MEASURE_ENABLE != 0) && (ADC_INJ_CHANNEL_ENABLED)
+#define BAS_MEASURE_INJ             (1u)
+#define ADC_BATTERY_INJ_CHANNEL     (ADC_SEQUENCED_CHANNELS_NUM)    /* Result index of the injection channel */
+#define BAS_INJ_DIVIDER             (4u)    /* Battery sense divider ratio */
+#define BAS_INJ_COUNTS_SHIFT        (11u)   /* A single-ended 12-bit result spans the reference in 2^11 counts */
+
+/* Battery mV per count, Q16 */
+#define BAS_INJ_MV_PER_COUNT        (((uint32)ADC_DEFAULT_VREF_MV_VALUE * BAS_INJ_DIVIDER) << \
+                                     (16u - BAS_INJ_COUNTS_SHIFT))
+
+#if (ADC_DEFAULT_VREF_SEL == ADC__VDDA) || (ADC_DEFAULT_VREF_SEL == ADC__VDDA_2) || \
+    (ADC_DEFAULT_VREF_SEL == ADC__VDDA_2BYPASSED)
+#error "The battery on the injection channel needs a reference that does not follow VDDA"
+#endif /* VDDA reference */
+#else
+#define BAS_MEASURE_INJ             (0u)
+#endif /* (BAS_MEASURE_ENABLE != 0) && (ADC_INJ_CHANNEL_ENABLED) */
+
 /***************************************
 *          Constants
 ***************************************/
 
 #define BATTERY_TIMEOUT             (3u)       /* Counts of 1 second */
+#if !defined(BATTERY_NTF_HYSTERESIS)
+#define BATTERY_NTF_HYSTERESIS      (2u)       /* Notify when the level moved by this many percent */
+#endif /* !defined(BATTERY_NTF_HYSTERESIS) */
+#define BATTERY_NTF_MAX_STALE       (300u)     /* Counts of 1 second between notifications at most */
+#define BATTERY_NTF_STAT_PERIOD     (3600u)    /* Counts of 1 second for suppressed notification statistics */
+#define BATTERY_LEVEL_INVALID       (0xFFu)    /* Nothing notified yet on this subscription */
 
 #define SIM_BATTERY_MIN             (2u)        /* Minimum simulated battery level measurement */
 #define SIM_BATTERY_MAX             (20u)       /* Maximum simulated battery level measurement */
 #define SIM_BATTERY_INCREMENT       (1u)        /* Value by which the battery level is incremented */
 
+/* Battery chemistry profiles: discharge curve approximated by two linear sections */
+#define BAS_PROFILE_CR2032          (0u)
+#define BAS_PROFILE_ALKALINE_2AA    (1u)
+#define BAS_PROFILE_NIMH_2AA        (2u)
+#if !defined(BAS_BATTERY_PROFILE)
+#define BAS_BATTERY_PROFILE         (BAS_PROFILE_CR2032)
+#endif /* !defined(BAS_BATTERY_PROFILE) */
+
+#if (BAS_BATTERY_PROFILE == BAS_PROFILE_CR2032)
 #define MEASURE_BATTERY_MAX         (3000)      /* Use 3V as battery voltage starting */
 #define MEASURE_BATTERY_MID         (2800)      /* Use 2.8V as a knee point of discharge curve @ 29% */
 #define MEASURE_BATTERY_MID_PERCENT (29)        
 #define MEASURE_BATTERY_MIN         (2000)      /* Use 2V as a cut-off of battery life */
+#elif (BAS_BATTERY_PROFILE == BAS_PROFILE_ALKALINE_2AA)
+#define MEASURE_BATTERY_MAX         (3000)      /* Two fresh alkaline cells */
+#define MEASURE_BATTERY_MID         (2200)      /* Use 2.2V as a knee point of discharge curve @ 20% */
+#define MEASURE_BATTERY_MID_PERCENT (20)
+#define MEASURE_BATTERY_MIN         (1800)      /* Minimum device supply voltage */
+#elif (BAS_BATTERY_PROFILE == BAS_PROFILE_NIMH_2AA)
+#define MEASURE_BATTERY_MAX         (2800)      /* Two fully charged NiMH cells */
+#define MEASURE_BATTERY_MID         (2400)      /* Use 2.4V as a knee point of discharge curve @ 15% */
+#define MEASURE_BATTERY_MID_PERCENT (15)
+#define MEASURE_BATTERY_MIN         (2000)      /* Use 2V as a cut-off to protect the cells */
+#endif /* (BAS_BATTERY_PROFILE == BAS_PROFILE_CR2032) */
 #define LOW_BATTERY_LIMIT           (10)        /* Low level limit in percent to switch on LED */
 
+#if (BAS_MEASURE_INJ != 0u) && ((MEASURE_BATTERY_MAX / BAS_INJ_DIVIDER) >= ADC_DEFAULT_VREF_MV_VALUE)
+#error "The battery sense divider leaves a full battery above the reference"
+#endif /* (BAS_MEASURE_INJ != 0u) */
+
+/* Voltage lookup table: VDD in mV for every 16th ADC code of the 1.024V reference
+*  measured against VDD, covering 3.64V down to 1.80V.
+*/
+#define BAS_ADC_TO_MV(adc)          ((1024 * 2048) / (adc))
+#define BAS_LUT_SHIFT               (4u)
+#define BAS_LUT_ADC_MIN             (576)
+#define BAS_LUT_SIZE                (38u)
+#define BAS_LUT_CODE_MAX            ((BAS_LUT_SIZE - 1u) << BAS_LUT_SHIFT)
+#define BAS_LUT_ENTRY(n)            ((uint16)BAS_ADC_TO_MV(BAS_LUT_ADC_MIN + ((n) << BAS_LUT_SHIFT)))
+
+/* Discharge curve slopes in percent per mV, Q16 */
+#define BAS_SLOPE_LOW               ((((MEASURE_BATTERY_MID_PERCENT) << 16) + \
+                                      ((MEASURE_BATTERY_MID - MEASURE_BATTERY_MIN) / 2)) / \
+                                      (MEASURE_BATTERY_MID - MEASURE_BATTERY_MIN))
+#define BAS_SLOPE_HIGH              ((((100 - MEASURE_BATTERY_MID_PERCENT) << 16) + \
+                                      ((MEASURE_BATTERY_MAX - MEASURE_BATTERY_MID) / 2)) / \
+                                      (MEASURE_BATTERY_MAX - MEASURE_BATTERY_MID))
+
 #define BAS_SERVICE_SIMULATE        (0u)        /* BAS service for simulation */ 
 #define BAS_SERVICE_MEASURE         (0u)        /* BAS service for measure actual battery level */  
 
@@ -55,8 +131,13 @@
 ***************************************/
 void BasCallBack(uint32 event, void *eventParam);
 void BasInit(void);
+void BasConnected(void);
+void BasDisconnected(void);
 #if (BAS_MEASURE_ENABLE != 0)
+void BasTick(void);
 void MeasureBattery(void);
+uint16 BasAdcToMvolts(int16 adcResult);
+uint8 BasMvoltsToLevel(uint16 mvolts);
 #endif /* BAS_MEASURE_ENABLE != 0 */
 
 #if (BAS_SIMULATE_ENABLE != 0)
@@ -69,6 +150,9 @@ void SimulateBattery(void);
 ***************************************/
 extern uint16 batterySimulation;
 extern uint16 batteryMeasure;
+extern uint8 batteryNtfLevel;
+extern uint32 batteryNtfSuppressed;
+extern uint32 batteryNtfSuppressedLastHour;
 
 
 /* [] END OF FILE */
@@ -17,12 +17,29 @@
 *******************************************************************************/
 
 #include "blss.h"
+#include "profile.h"
+#include "rtc.h"
+#include "record.h"
+#include "racp.h"
 
 
 /* Global variables */
 uint8 blsFlag; /* Flags */
 uint8 blsSim; /* Blood Pressure Measurement simulation counter */
 uint16 feature = CYBLE_BLS_BPF_CFD | CYBLE_BLS_BPF_PRD | CYBLE_BLS_BPF_MBS;
+uint8 blsUser; /* Record partition of the connected peer */
+
+/* Record indication states */
+#define BLS_IND_NONE    (0u)
+#define BLS_IND_SENT    (1u)  /* Sent, the confirmation advances the cursor */
+#define BLS_IND_DROPPED (2u)  /* Sent for an aborted report, the cursor has moved on */
+
+static REC_CURSOR_T blsUpload; /* Next stored record to indicate */
+static REC_CURSOR_T blsLive; /* Upload position saved while a report runs */
+static uint32 blsUploadLast = REC_SEQ_MAX; /* Last record of the report */
+static uint8 blsReporting; /* Records requested by the collector are being indicated */
+static uint8 blsIndPending; /* Indication sent and not confirmed yet */
+static uint32 blsIndSeq; /* Sequence number of the record in flight */
 
 
 /* Blood Pressure Measurement values */
@@ -96,15 +113,30 @@ void BlsCallBack(uint32 event, void* eventParam)
             printf("Blood Pressure Measurement Indication is Enabled \r\n");
             blsSim = 0u;
             blsFlag |= IND;
+            BlsConnected();
             break;
 
         case CYBLE_EVT_BLSS_INDICATION_DISABLED:
             printf("Blood Pressure Measurement Indication is Disabled \r\n");
             blsFlag &= ~IND;
+            if(blsReporting == ENABLED)
+            {
+                BlsReportAbort();
+                RacpReportDone(RACP_RSP_NOT_COMPLETED);
+            }
             break;
 
         case CYBLE_EVT_BLSS_INDICATION_CONFIRMED:
             printf("Blood Pressure Measurement Indication is Confirmed \r\n");
+            if(blsIndPending == BLS_IND_SENT)
+            {
+                if(blsReporting == DISABLED)
+                {
+                    RecordAck(blsUser, blsIndSeq);
+                }
+                RecordNext(&blsUpload);
+            }
+            blsIndPending = BLS_IND_NONE;
             break;
 
         default:
@@ -129,44 +161,216 @@ void BlsInit(void)
 
 
 /*******************************************************************************
-* Function Name: BlsInd
+* Function Name: BlsConnected()
 ********************************************************************************
 *
 * Summary:
-*   Sends the Blood Pressure Measurement indication.
+*   Selects the record partition of the connected peer and resumes the
+*   upload after the newest record its collector has confirmed, so only the
+*   records it has not received are sent. A record whose indication was lost
+*   with the link is sent again with the same sequence number.
+*   The flags follow the CCCDs in the GATT database, so the subscriptions
+*   restored for a bonded collector take effect without a CCCD write.
+*
+*******************************************************************************/
+void BlsConnected(void)
+{
+    blsFlag = 0u;
+    if(CYBLE_IS_INDICATION_ENABLED(cyBle_blss.charInfo[CYBLE_BLS_BPM].cccdHandle))
+    {
+        blsFlag |= IND;
+    }
+    if((cyBle_blss.charInfo[CYBLE_BLS_ICP].cccdHandle != CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE) &&
+       CYBLE_IS_NOTIFICATION_ENABLED(cyBle_blss.charInfo[CYBLE_BLS_ICP].cccdHandle))
+    {
+        blsFlag |= NTF;
+    }
+
+    if(blsReporting == ENABLED)
+    {
+        RacpReportDone(RACP_RSP_NOT_COMPLETED);
+    }
+    blsUser = RecordUserOf(cyBle_connHandle.bdHandle);
+    blsIndPending = BLS_IND_NONE;
+    blsReporting = DISABLED;
+    blsUploadLast = REC_SEQ_MAX;
+    RecordCursorSeek(&blsUpload, blsUser, RecordAcked(blsUser) + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: BlsReport()
+********************************************************************************
+*
+* Summary:
+*   Starts indicating the records of the connected user within the sequence
+*   number range, requested through the record access control point. The
+*   upload of new records resumes when the report ends.
+*
+*******************************************************************************/
+void BlsReport(uint32 first, uint32 last)
+{
+    blsLive = blsUpload;
+    RecordCursorSeek(&blsUpload, blsUser, first);
+    blsUploadLast = last;
+    blsReporting = ENABLED;
+}
+
+
+/*******************************************************************************
+* Function Name: BlsReportAbort()
+********************************************************************************
+*
+* Summary:
+*   Ends the report and returns to the upload of new records. A report
+*   indication still in flight no longer advances the cursor.
+*
+*******************************************************************************/
+void BlsReportAbort(void)
+{
+    if(blsReporting == ENABLED)
+    {
+        blsUpload = blsLive;
+        blsUploadLast = REC_SEQ_MAX;
+        blsReporting = DISABLED;
+        if(blsIndPending == BLS_IND_SENT)
+        {
+            blsIndPending = BLS_IND_DROPPED;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: BlsSetSeq()
+********************************************************************************
+*
+* Summary:
+*   Publishes the sequence number of the record about to be indicated in the
+*   Record Sequence characteristic, so the collector can tell a record it
+*   already has from a new one. The characteristic exists only when it is
+*   added to the Record Access service in the BLE component customizer.
+*
+*******************************************************************************/
+static void BlsSetSeq(uint32 seq)
+{
+#if defined(CYBLE_RECORD_ACCESS_SEQUENCE_CHAR_HANDLE)
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValuePair;
+    uint8 val[sizeof(seq)];
+
+    val[0u] = LO8(seq);
+    val[1u] = HI8(seq);
+    val[2u] = LO8(seq >> 16u);
+    val[3u] = HI8(seq >> 16u);
+    handleValuePair.attrHandle = CYBLE_RECORD_ACCESS_SEQUENCE_CHAR_HANDLE;
+    handleValuePair.value.val = val;
+    handleValuePair.value.len = sizeof(val);
+    (void)CyBle_GattsWriteAttributeValue(&handleValuePair, 0u, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+#endif /* defined(CYBLE_RECORD_ACCESS_SEQUENCE_CHAR_HANDLE) */
+    printf("Record seq %ld \r\n", seq);
+}
+
+
+/*******************************************************************************
+* Function Name: BlsUpload()
+********************************************************************************
+*
+* Summary:
+*   Indicates the next stored record of the connected user. Only one
+*   indication is outstanding; the cursor advances when the collector
+*   confirms it, and the confirmed sequence number is stored once the upload
+*   has caught up. A report ends with the response of the record access control
+*   point, and new records are held back until that response is confirmed.
+*   Called from the main loop while indications are enabled.
+*
+*******************************************************************************/
+void BlsUpload(void)
+{
+    CYBLE_BLS_BPM_T bpm;
+    uint32 seq;
+
+    if((blsIndPending == BLS_IND_NONE) && ((blsReporting == ENABLED) || (RacpBusy() == DISABLED)) &&
+       (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        if((RecordRead(&blsUpload, &bpm, &seq) == ENABLED) && (seq <= blsUploadLast))
+        {
+            BlsSetSeq(seq);
+            BlsInd(&bpm);
+            if(apiResult == CYBLE_ERROR_OK)
+            {
+                blsIndPending = BLS_IND_SENT;
+                blsIndSeq = seq;
+            }
+        }
+        else if(blsReporting == ENABLED)
+        {
+            BlsReportAbort();
+            RacpReportDone(RACP_RSP_SUCCESS);
+        }
+        else
+        {
+            /* All records are uploaded */
+            (void)RecordAckStore();
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: BlsUploadIdle()
+********************************************************************************
+*
+* Summary:
+*   Checks that no record indication is pending and no report runs, so the
+*   record access control point can indicate its response.
+*
+*******************************************************************************/
+uint8 BlsUploadIdle(void)
+{
+    return(((blsIndPending == BLS_IND_NONE) && (blsReporting == DISABLED)) ? ENABLED : DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: BlsSerialize
+********************************************************************************
+*
+* Summary:
+*   Serializes the Blood Pressure Measurement characteristic value. Runs
+*   from SRAM.
 *
 * Parameters:
-*   uint8 num - number of record to notify.
+*   pdu - receives the value, sizeof(CYBLE_BLS_BPM_T) bytes.
+*   bpm - the measurement record.
 *
 * Return:
-*   None
+*   Length of the value.
 *
 *******************************************************************************/
-void BlsInd(uint8 num)
+static RAMFUNC uint8 BlsSerialize(uint8 *pdu, const CYBLE_BLS_BPM_T *bpm)
 {
-    uint8 pdu[sizeof(CYBLE_BLS_BPM_T)];
     uint8 ptr;
 
     /* flags, Systolic, Diastolic and Mean Arterial Pressure fields always go first */
-    pdu[0u] = blsBpm[num].flags;
-    pdu[1u] = LO8(blsBpm[num].sys);
-    pdu[2u] = HI8(blsBpm[num].sys);
-    pdu[3u] = LO8(blsBpm[num].dia);
-    pdu[4u] = HI8(blsBpm[num].dia);
-    pdu[5u] = LO8(blsBpm[num].map);
-    pdu[6u] = HI8(blsBpm[num].map);
+    pdu[0u] = bpm->flags;
+    pdu[1u] = LO8(bpm->sys);
+    pdu[2u] = HI8(bpm->sys);
+    pdu[3u] = LO8(bpm->dia);
+    pdu[4u] = HI8(bpm->dia);
+    pdu[5u] = LO8(bpm->map);
+    pdu[6u] = HI8(bpm->map);
     
     /* if the Time Stamp Present flag is set */
-    if(0u != (blsBpm[num].flags & CYBLE_BLS_BPM_FLG_TSP))
+    if(0u != (bpm->flags & CYBLE_BLS_BPM_FLG_TSP))
     {
         /* set the full 7-bytes Time Stamp value */
-        pdu[7u] = LO8(blsBpm[num].time.year);
-        pdu[8u] = HI8(blsBpm[num].time.year);
-        pdu[9u] = blsBpm[num].time.month;
-        pdu[10u] = blsBpm[num].time.day;
-        pdu[11u] = blsBpm[num].time.hours;
-        pdu[12u] = blsBpm[num].time.minutes;
-        pdu[13u] = blsBpm[num].time.seconds;
+        pdu[7u] = LO8(bpm->time.year);
+        pdu[8u] = HI8(bpm->time.year);
+        pdu[9u] = bpm->time.month;
+        pdu[10u] = bpm->time.day;
+        pdu[11u] = bpm->time.hours;
+        pdu[12u] = bpm->time.minutes;
+        pdu[13u] = bpm->time.seconds;
 
         /* the next data will be located at 14th byte */
         ptr = 14u;
@@ -177,34 +381,63 @@ void BlsInd(uint8 num)
         ptr = 7u;   
     }
 
-    if(0u != (blsBpm[num].flags & CYBLE_BLS_BPM_FLG_PRT))
+    if(0u != (bpm->flags & CYBLE_BLS_BPM_FLG_PRT))
     {
-        pdu[ptr] = LO8(blsBpm[num].prt);
-        pdu[ptr + 1u] = HI8(blsBpm[num].prt);
+        pdu[ptr] = LO8(bpm->prt);
+        pdu[ptr + 1u] = HI8(bpm->prt);
         ptr += 2u;
     }
 
-    if(0u != (blsBpm[num].flags & CYBLE_BLS_BPM_FLG_UID))
+    if(0u != (bpm->flags & CYBLE_BLS_BPM_FLG_UID))
     {
-        pdu[ptr] = blsBpm[num].uid;
+        pdu[ptr] = bpm->uid;
         ptr += 1u;
     }
 
-    if(0u != (blsBpm[num].flags & CYBLE_BLS_BPM_FLG_MST))
+    if(0u != (bpm->flags & CYBLE_BLS_BPM_FLG_MST))
     {
-        pdu[ptr] = LO8(blsBpm[num].mst);
-        pdu[ptr + 1u] = HI8(blsBpm[num].mst);
+        pdu[ptr] = LO8(bpm->mst);
+        pdu[ptr + 1u] = HI8(bpm->mst);
         ptr += 2u;
     }
 
+    return(ptr);
+}
+
+
+/*******************************************************************************
+* Function Name: BlsInd
+********************************************************************************
+*
+* Summary:
+*   Sends the Blood Pressure Measurement indication.
+*
+* Parameters:
+*   bpm - the measurement record to indicate.
+*
+* Return:
+*   None
+*
+*******************************************************************************/
+void BlsInd(const CYBLE_BLS_BPM_T *bpm)
+{
+    uint8 pdu[sizeof(CYBLE_BLS_BPM_T)];
+    uint8 ptr;
+
+    PROFILE_ENTER(PROFILE_BLS_IND);
+
+    ptr = BlsSerialize(pdu, bpm);
+
     if(CYBLE_ERROR_OK != (apiResult = CyBle_BlssSendIndication(cyBle_connHandle, CYBLE_BLS_BPM, ptr, pdu)))
     {
         printf("CyBle_GlssSendNotification API Error: %x \r\n", apiResult);
     }
     else
     {
-        printf("Blood Pressure Ind  sys:%d mmHg, dia:%d mmHg\r\n", blsBpm[num].sys, blsBpm[num].dia);
+        printf("Blood Pressure Ind  sys:%d mmHg, dia:%d mmHg\r\n", bpm->sys, bpm->dia);
     }
+
+    PROFILE_EXIT(PROFILE_BLS_IND);
 }
 
 
@@ -227,6 +460,8 @@ void BlsNtf(uint8 num)
     uint8 pdu[sizeof(CYBLE_BLS_BPM_T)];
     uint8 ptr;
     
+    PROFILE_ENTER(PROFILE_BLS_NTF);
+
     /* flags, Systolic, Diastolic and Mean Arterial Pressure fields always go first */
     pdu[0u] = blsIcp[num].flags;
     pdu[1u] = LO8(blsIcp[num].sys);
@@ -285,6 +520,7 @@ void BlsNtf(uint8 num)
     {
         printf("Intermediate Cuff Pressure Ntf: %d mmHg\r\n", blsIcp[num].sys);
     }
+    PROFILE_EXIT(PROFILE_BLS_NTF);
 }
 
 
@@ -293,7 +529,9 @@ void BlsNtf(uint8 num)
 ********************************************************************************
 *
 * Summary:
-*   Executes current BLS processes.
+*   Executes current BLS processes. Intermediate Cuff Pressure is notified
+*   every second; a completed measurement is stored for the connected user
+*   once per simulation cycle and uploaded by BlsUpload().
 *
 * Parameters:
 *   None.
@@ -313,7 +551,7 @@ void BlsSimulate(void)
     if(0u != (blsFlag & NTF))
     {
         blsIcp[0u].sys = SIM_ICF_MAX - SIM_BLS_DLT * (blsSim & SIM_ICF_MSK);
-        blsIcp[0u].time.seconds = blsSim;
+        RtcGetTime(&blsIcp[0u].time);
         BlsNtf(0u);
     }
     
@@ -321,8 +559,11 @@ void BlsSimulate(void)
     {
         blsBpm[0u].sys = SIM_BPM_SYS_MIN + (blsSim & SIM_BPM_MSK);
         blsBpm[0u].dia = SIM_BPM_DIA_MIN + (blsSim & SIM_BPM_MSK);
-        blsBpm[0u].time.seconds = blsSim;
-        BlsInd(0u);
+        if(blsSim == 0u)
+        {
+            RtcGetTime(&blsBpm[0u].time);
+            (void)RecordAppend(blsUser, &blsBpm[0u]);
+        }
     }
 }
 
@@ -100,7 +100,12 @@ typedef enum
 void BlsCallBack(uint32 event, void* eventParam);
 void BlsInit(void);
 void BlsSimulate(void);
-void BlsInd(uint8 num);
+void BlsConnected(void);
+void BlsUpload(void);
+uint8 BlsUploadIdle(void);
+void BlsReport(uint32 first, uint32 last);
+void BlsReportAbort(void);
+void BlsInd(const CYBLE_BLS_BPM_T *bpm);
 void BlsNtf(uint8 num);
 
 /***************************************
@@ -109,6 +114,8 @@ void BlsNtf(uint8 num);
 
 extern uint16 feature;
 extern uint8 blsFlag;
+extern uint8 blsUser;
+extern uint8 blsSim;
 
 
 
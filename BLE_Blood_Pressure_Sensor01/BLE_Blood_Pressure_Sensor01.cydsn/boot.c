@@ -0,0 +1,174 @@
+/*******************************************************************************
+* File Name: boot.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the boot profiler, which stamps the boot stages from
+*  reset to the first advertisement, and the deferred start of the debug UART
+*  and the ADC, so that neither delays the radio.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "boot.h"
+
+static uint32 bootCycles;                       /* Cycles since BootReset(), extends the 24-bit SysTick */
+static uint32 bootLast;                         /* SysTick value at the previous stamp */
+static uint32 bootStamp[BOOT_STAGE_COUNT];
+static uint8 bootStamped;                       /* Bitmask of the stages reached */
+static uint8 bootAdcStarted;
+
+#if(defined(__GNUC__) && !defined(__ARMCC_VERSION))
+/* Run by __libc_init_array() ahead of the constructors, the first of which
+*  is initialize_psoc() */
+static void (* const bootPreinit)(void) __attribute__((section(".preinit_array"), used)) = &BootReset;
+#endif /* (defined(__GNUC__) && !defined(__ARMCC_VERSION)) */
+
+
+/*******************************************************************************
+* Function Name: BootReset
+********************************************************************************
+*
+* Summary:
+*   Starts SysTick as a free running 24-bit down counter clocked by the
+*   system clock with its interrupt disabled; the profiler uses it the same
+*   way. Runs right after reset with GCC, otherwise on the first stamp.
+*   Until initialize_psoc() configures the clocks the system clock is the
+*   24 MHz IMO, so the first stage is counted at half the rate.
+*
+*******************************************************************************/
+void BootReset(void)
+{
+#if(CY_PSOC4_4100BL || CY_PSOC4_4200BL)
+    CySysTickSetClockSource(CY_SYS_SYST_CSR_CLK_SRC_SYSCLK);
+#endif /* (CY_PSOC4_4100BL || CY_PSOC4_4200BL) */
+    CySysTickSetReload(CY_SYS_SYST_RVR_CNT_MASK);
+    CySysTickClear();
+    CySysTickDisableInterrupt();
+    CySysTickEnable();
+
+    bootLast = CY_SYS_SYST_CVR_REG;
+    bootCycles = 0u;
+    bootStamp[BOOT_STAGE_RESET] = 0u;
+    bootStamped = (uint8)(1u << BOOT_STAGE_RESET);
+}
+
+
+/*******************************************************************************
+* Function Name: BootStamp
+********************************************************************************
+*
+* Summary:
+*   Records the time the stage is first reached. Later calls for the same
+*   stage are ignored, so the stages of the start-up code can be stamped on
+*   every pass.
+*
+* Return:
+*   ENABLED if the stage was reached for the first time.
+*
+*******************************************************************************/
+uint8 BootStamp(BOOT_STAGE_T stage)
+{
+    uint32 now;
+    uint8 result = DISABLED;
+
+    if((bootStamped & (1u << BOOT_STAGE_RESET)) == 0u)
+    {
+        BootReset();
+    }
+    if((bootStamped & (1u << stage)) == 0u)
+    {
+        /* SysTick counts down */
+        now = CY_SYS_SYST_CVR_REG;
+        bootCycles += (bootLast - now) & CY_SYS_SYST_RVR_CNT_MASK;
+        bootLast = now;
+
+        bootStamp[stage] = bootCycles;
+        bootStamped |= (uint8)(1u << stage);
+        result = ENABLED;
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: BootPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the banner and the time from reset to every stage reached.
+*
+*******************************************************************************/
+void BootPrint(void)
+{
+    uint8 i;
+
+    printf("BLE Blood Pressure Sensor Example Project \r\n");
+    printf("Boot: stage cycles us \r\n");
+    for(i = 0u; i < BOOT_STAGE_COUNT; i++)
+    {
+        if((bootStamped & (1u << i)) != 0u)
+        {
+            printf("  %d %ld %ld \r\n", i, bootStamp[i], bootStamp[i] / BOOT_CYCLES_PER_US);
+        }
+    }
+    if((bootStamped & (1u << BOOT_STAGE_ADVERTISE)) != 0u)
+    {
+        printf("Time to advertise: %ld us \r\n", bootStamp[BOOT_STAGE_ADVERTISE] / BOOT_CYCLES_PER_US);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: BootUartStart
+********************************************************************************
+*
+* Summary:
+*   Starts the debug UART on its first use.
+*
+*******************************************************************************/
+void BootUartStart(void)
+{
+    if(UART_DEB_initVar == 0u)
+    {
+        UART_DEB_Start();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: BootAdcStart
+********************************************************************************
+*
+* Summary:
+*   Starts the ADC on its first use: a battery measurement, a calibration
+*   capture or the waveform stream. Called by the analog front end gating.
+*
+* Return:
+*   ENABLED if the ADC was started by this call, DISABLED if it was started
+*   before.
+*
+*******************************************************************************/
+uint8 BootAdcStart(void)
+{
+    uint8 started = DISABLED;
+
+    if(bootAdcStarted == DISABLED)
+    {
+        ADC_Start();
+        bootAdcStarted = ENABLED;
+        started = ENABLED;
+    }
+    return(started);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,62 @@
+/*******************************************************************************
+* File Name: boot.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the boot profiler and
+*  the deferred start of the peripherals.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(BOOT_H)
+#define BOOT_H
+
+#include "common.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+#define BOOT_CYCLES_PER_US          (CYDEV_BCLK__SYSCLK__HZ / 1000000u)
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Boot stages in the order they are reached. The intervals between two
+*  stamps must stay below the SysTick period, about 350 ms at 48 MHz. */
+typedef enum
+{
+    BOOT_STAGE_RESET,                           /* .data and .bss initialized, before initialize_psoc() */
+    BOOT_STAGE_MAIN,                            /* Clocks and components configured */
+    BOOT_STAGE_BLE_START,                       /* CyBle_Start() returned */
+    BOOT_STAGE_APP_INIT,                        /* Services, records and timers initialized */
+    BOOT_STAGE_STACK_ON,                        /* CYBLE_EVT_STACK_ON */
+    BOOT_STAGE_ADVERTISE,                       /* First advertisement started */
+    BOOT_STAGE_COUNT
+}BOOT_STAGE_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void BootReset(void);
+uint8 BootStamp(BOOT_STAGE_T stage);
+void BootPrint(void);
+void BootUartStart(void);
+uint8 BootAdcStart(void);
+
+
+#endif /* BOOT_H */
+
+/* [] END OF FILE */
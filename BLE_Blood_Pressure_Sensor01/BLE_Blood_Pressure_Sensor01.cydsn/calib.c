@@ -0,0 +1,371 @@
+/*******************************************************************************
+* File Name: calib.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the cuff pressure transducer calibration. Reference
+*  points captured against a manometer are turned into a full-resolution
+*  correction table in flash, so correcting a sample is a single table read.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include <stddef.h>
+#include "calib.h"
+#include "analog.h"
+
+
+#if (CAL_PRESSURE_ENABLE != 0u)
+
+/* Calibration record and the correction table, each starting on a flash row.
+*  The rows are rewritten by CyBle_StoreAppData() behind the compiler's back,
+*  so they are read through volatile accesses, never folded to the initializer.
+*/
+#if defined(__GNUC__) || defined(__ARMCC_VERSION)
+const uint8 calRecordFlash[CY_FLASH_SIZEOF_ROW] CYBLE_FLASH_ROW_ALIGNED = {0u};
+const int16 calLutFlash[CAL_LUT_SIZE] CYBLE_FLASH_ROW_ALIGNED = {0};
+#elif defined(__ICCARM__)
+#pragma data_alignment=CY_FLASH_SIZEOF_ROW
+const uint8 calRecordFlash[CY_FLASH_SIZEOF_ROW] = {0u};
+#pragma data_alignment=CY_FLASH_SIZEOF_ROW
+const int16 calLutFlash[CAL_LUT_SIZE] = {0};
+#endif /* defined(__GNUC__) || defined(__ARMCC_VERSION) */
+
+uint8 calValid = DISABLED;
+
+static const uint16 calRefPoint[CAL_POINTS_MAX] = {CAL_REF_POINT0, CAL_REF_POINT1, CAL_REF_POINT2};
+static CAL_RECORD_T calRecord;
+
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+/*******************************************************************************
+* Function Name: CalCrc16
+********************************************************************************
+*
+* Summary:
+*   Calculates CRC-16/CCITT over the buffer.
+*
+* Parameters:
+*   data - pointer to the buffer.
+*   len - buffer length in bytes.
+*
+* Return:
+*   CRC value.
+*
+*******************************************************************************/
+uint16 CalCrc16(const uint8 *data, uint32 len)
+{
+    uint16 crc = 0xFFFFu;
+    uint8 i;
+
+    while(len-- != 0u)
+    {
+        crc ^= (uint16)((uint16)*data++ << 8u);
+        for(i = 0u; i < 8u; i++)
+        {
+            crc = ((crc & 0x8000u) != 0u) ? (uint16)((uint16)(crc << 1u) ^ 0x1021u) : (uint16)(crc << 1u);
+        }
+    }
+    return(crc);
+}
+
+
+#if (CAL_PRESSURE_ENABLE != 0u)
+
+/*******************************************************************************
+* Function Name: CalInit
+********************************************************************************
+*
+* Summary:
+*   Loads the calibration record from flash and validates it. The correction
+*   table is used only if the record is intact.
+*
+*******************************************************************************/
+void CalInit(void)
+{
+    uint32 i;
+
+    for(i = 0u; i < sizeof(calRecord); i++)
+    {
+        ((uint8 *)&calRecord)[i] = CY_GET_REG8(&calRecordFlash[i]);
+    }
+
+    if((calRecord.magic == CAL_MAGIC) && (calRecord.version == CAL_VERSION) &&
+       (calRecord.crc == CalCrc16((const uint8 *)&calRecord, offsetof(CAL_RECORD_T, crc))))
+    {
+        calValid = ENABLED;
+    }
+    else
+    {
+        (void)memset(&calRecord, 0, sizeof(calRecord));
+        calValid = DISABLED;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CalCapture
+********************************************************************************
+*
+* Summary:
+*   Captures one calibration point while the reference pressure is applied
+*   to the cuff. The point is kept in RAM until CalStore() is called.
+*
+* Parameters:
+*   point - index of the reference point (0 .. CAL_POINTS_MAX - 1).
+*
+*******************************************************************************/
+void CalCapture(uint8 point)
+{
+    int32 sum = 0;
+    uint8 i;
+
+    if(point < CAL_POINTS_MAX)
+    {
+        AnalogAcquire(ANALOG_USER_CALIB);
+        for(i = 0u; i < (1u << CAL_CAPTURE_SHIFT); i++)
+        {
+            ADC_StartConvert();
+            (void)ADC_IsEndConversion(ADC_WAIT_FOR_RESULT);
+            sum += ADC_GetResult16(ADC_PRESSURE_CHANNEL);
+        }
+        AnalogRelease(ANALOG_USER_CALIB);
+
+        calRecord.adc[point] = (int16)(sum >> CAL_CAPTURE_SHIFT);
+        calRecord.ref[point] = calRefPoint[point];
+        calRecord.points |= (uint8)(1u << point);
+        printf("Calibration point %d: %d mmHg = %d counts \r\n", point, calRecord.ref[point], calRecord.adc[point]);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CalInterpolate
+********************************************************************************
+*
+* Summary:
+*   Evaluates the piecewise linear transfer function through the captured
+*   points. The end segments are extrapolated. Used only to build the table.
+*
+* Parameters:
+*   adcCounts - raw ADC counts.
+*
+* Return:
+*   Pressure in 1/16 mmHg, clamped to zero.
+*
+*******************************************************************************/
+static int16 CalInterpolate(int32 adcCounts)
+{
+    uint8 idx[CAL_POINTS_MAX];
+    uint8 num = 0u;
+    uint8 seg;
+    uint8 i;
+    int32 pressure;
+
+    for(i = 0u; i < CAL_POINTS_MAX; i++)
+    {
+        if(0u != (calRecord.points & (1u << i)))
+        {
+            idx[num++] = i;
+        }
+    }
+
+    /* Reference points are ascending, so the first segment covers everything
+    *  below the middle point and the last one everything above it.
+    */
+    seg = ((num > 2u) && (adcCounts >= calRecord.adc[idx[1u]])) ? 1u : 0u;
+
+    pressure = ((int32)calRecord.ref[idx[seg]] << CAL_Q) +
+               (((adcCounts - calRecord.adc[idx[seg]]) *
+                 ((int32)(calRecord.ref[idx[seg + 1u]] - calRecord.ref[idx[seg]]) << CAL_Q)) /
+                (calRecord.adc[idx[seg + 1u]] - calRecord.adc[idx[seg]]));
+
+    if(pressure < 0)
+    {
+        pressure = 0;
+    }
+    else if(pressure > INT16_MAX)
+    {
+        pressure = INT16_MAX;
+    }
+    else
+    {
+        /* Within range */
+    }
+    return((int16)pressure);
+}
+
+
+/*******************************************************************************
+* Function Name: CalStore
+********************************************************************************
+*
+* Summary:
+*   Builds the correction table from the captured points and writes it to
+*   flash followed by the calibration record. At least two points with
+*   increasing ADC counts are required.
+*
+* Return:
+*   CYBLE_ERROR_OK on success, CYBLE_ERROR_INVALID_PARAMETER if the captured
+*   points are not usable, or the CyBle_StoreAppData() error.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CalStore(void)
+{
+    int16 row[CAL_LUT_ROW_ENTRIES];
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    int16 prevAdc = INT16_MIN;
+    uint8 num = 0u;
+    uint32 i;
+    uint32 j;
+
+    for(i = 0u; i < CAL_POINTS_MAX; i++)
+    {
+        if(0u != (calRecord.points & (1u << i)))
+        {
+            if(calRecord.adc[i] <= prevAdc)
+            {
+                apiResult = CYBLE_ERROR_INVALID_PARAMETER;
+            }
+            prevAdc = calRecord.adc[i];
+            num++;
+        }
+    }
+    if(num < 2u)
+    {
+        apiResult = CYBLE_ERROR_INVALID_PARAMETER;
+    }
+
+    /* Invalidate the stored record first and write it back only once the table
+    *  is complete, so a reset in between leaves the nominal transfer function.
+    */
+    if(apiResult == CYBLE_ERROR_OK)
+    {
+        calValid = DISABLED;
+        calRecord.magic = 0u;
+        do
+        {
+            CyBle_ProcessEvents();
+            apiResult = CyBle_StoreAppData((uint8 *)&calRecord, calRecordFlash, sizeof(calRecord), 0u);
+        }
+        while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+    }
+
+    for(i = 0u; (i < CAL_LUT_ROWS) && (apiResult == CYBLE_ERROR_OK); i++)
+    {
+        for(j = 0u; j < CAL_LUT_ROW_ENTRIES; j++)
+        {
+            row[j] = CalInterpolate((int32)(i * CAL_LUT_ROW_ENTRIES + j));
+        }
+        do
+        {
+            CyBle_ProcessEvents();
+            apiResult = CyBle_StoreAppData((uint8 *)row, (const uint8 *)&calLutFlash[i * CAL_LUT_ROW_ENTRIES],
+                                           sizeof(row), 0u);
+        }
+        while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+    }
+
+    if(apiResult == CYBLE_ERROR_OK)
+    {
+        calRecord.magic = CAL_MAGIC;
+        calRecord.version = CAL_VERSION;
+        calRecord.crc = CalCrc16((const uint8 *)&calRecord, offsetof(CAL_RECORD_T, crc));
+        do
+        {
+            CyBle_ProcessEvents();
+            apiResult = CyBle_StoreAppData((uint8 *)&calRecord, calRecordFlash, sizeof(calRecord), 0u);
+        }
+        while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+
+        if(apiResult == CYBLE_ERROR_OK)
+        {
+            calValid = ENABLED;
+        }
+    }
+
+    printf("Calibration store, status: %x \r\n", apiResult);
+
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: CalPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the calibration state and the captured points.
+*
+*******************************************************************************/
+void CalPrint(void)
+{
+    uint8 i;
+
+    printf("Calibration valid: %d \r\n", calValid);
+    for(i = 0u; i < CAL_POINTS_MAX; i++)
+    {
+        if(0u != (calRecord.points & (1u << i)))
+        {
+            printf("  %d mmHg = %d counts \r\n", calRecord.ref[i], calRecord.adc[i]);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CalApply
+********************************************************************************
+*
+* Summary:
+*   Converts raw ADC counts of the pressure channel to pressure.
+*
+* Parameters:
+*   adcCounts - raw ADC counts.
+*
+* Return:
+*   Pressure in 1/16 mmHg.
+*
+*******************************************************************************/
+int16 CalApply(int16 adcCounts)
+{
+    int16 result;
+
+    if(adcCounts < 0)
+    {
+        adcCounts = 0;
+    }
+    else if(adcCounts > CAL_ADC_MAX)
+    {
+        adcCounts = CAL_ADC_MAX;
+    }
+    else
+    {
+        /* Within the table */
+    }
+
+    if(calValid == ENABLED)
+    {
+        result = (int16)CY_GET_REG16(&calLutFlash[adcCounts]);
+    }
+    else
+    {
+        result = (int16)((adcCounts * CAL_NOMINAL_MUL) >> CAL_NOMINAL_SHIFT);
+    }
+    return(result);
+}
+
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,109 @@
+/*******************************************************************************
+* File Name: calib.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the cuff pressure
+*  transducer calibration.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CALIB_H)
+#define CALIB_H
+
+#include "common.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#define ADC_PRESSURE_CHANNEL        (0x01u)     /* Sequencer channel of the pressure transducer */
+
+/* The transducer has its own sequencer channel after the battery channel.
+*  The ADC of this design has the battery channel only, so calibration and
+*  waveform streaming are compiled in once the transducer channel is added
+*  in the ADC customizer. Define CAL_PRESSURE_ENABLE in the build settings
+*  to override.
+*/
+#if !defined(CAL_PRESSURE_ENABLE)
+    #if (ADC_SEQUENCED_CHANNELS_NUM > ADC_PRESSURE_CHANNEL)
+        #define CAL_PRESSURE_ENABLE (1u)
+    #else
+        #define CAL_PRESSURE_ENABLE (0u)
+    #endif /* (ADC_SEQUENCED_CHANNELS_NUM > ADC_PRESSURE_CHANNEL) */
+#endif /* !defined(CAL_PRESSURE_ENABLE) */
+
+
+/***************************************
+*          Constants
+***************************************/
+#define CAL_POINTS_MAX              (3u)        /* Two- or three-point calibration */
+#define CAL_REF_POINT0              (0u)        /* Reference pressures applied by the manometer, mmHg */
+#define CAL_REF_POINT1              (150u)
+#define CAL_REF_POINT2              (300u)
+
+#define CAL_CAPTURE_SHIFT           (4u)        /* 16 conversions are averaged per calibration point */
+
+#define CAL_Q                       (4u)        /* Corrected pressure is in 1/16 mmHg */
+#define CAL_ADC_MAX                 (2047)      /* Full scale of the signed 12-bit SAR result */
+#define CAL_LUT_SIZE                (CAL_ADC_MAX + 1)
+#define CAL_LUT_ROW_ENTRIES         (CY_FLASH_SIZEOF_ROW / sizeof(int16))
+#define CAL_LUT_ROWS                (CAL_LUT_SIZE / CAL_LUT_ROW_ENTRIES)
+
+/* Nominal transfer function (0..CAL_ADC_MAX -> 0..300 mmHg) used until the device is calibrated */
+#define CAL_NOMINAL_MUL             (75)
+#define CAL_NOMINAL_SHIFT           (5u)
+
+#define CAL_MAGIC                   (0xCA1Bu)
+#define CAL_VERSION                 (1u)
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Calibration record stored in a dedicated flash row */
+typedef struct
+{
+    uint16 magic;
+    uint8  version;
+    uint8  points;                      /* Bitmask of the captured reference points */
+    int16  adc[CAL_POINTS_MAX];         /* Averaged ADC counts at each reference point */
+    uint16 ref[CAL_POINTS_MAX];         /* Reference pressure at each point, mmHg */
+    uint16 crc;                         /* CRC-16 over all preceding fields */
+}CAL_RECORD_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+uint16 CalCrc16(const uint8 *data, uint32 len);
+#if (CAL_PRESSURE_ENABLE != 0u)
+void CalInit(void);
+void CalCapture(uint8 point);
+CYBLE_API_RESULT_T CalStore(void);
+void CalPrint(void);
+int16 CalApply(int16 adcCounts);
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+/***************************************
+* External data references
+***************************************/
+#if (CAL_PRESSURE_ENABLE != 0u)
+extern uint8 calValid;
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+#endif /* CALIB_H */
+
+/* [] END OF FILE */
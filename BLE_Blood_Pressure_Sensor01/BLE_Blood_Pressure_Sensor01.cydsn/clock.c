@@ -0,0 +1,194 @@
+/*******************************************************************************
+* File Name: clock.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the system clock manager. The CPU runs from a divided
+*  SYSCLK for housekeeping and BLE event handling and at the full HFCLK for
+*  computation bursts. Only the SYSCLK prescaler changes: the UART, the SAR
+*  and BLESS are clocked from HFCLK, the ECO and the LFCLK, so their
+*  dividers stay valid at every operating point. The flash wait states follow
+*  SYSCLK, raised before the clock goes up and lowered after it went down.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "clock.h"
+
+
+static const CLOCK_POINT_T clockPoint[CLOCK_LEVEL_COUNT] =
+{
+    {CLOCK_LOW_DIV, CLOCK_LOW_MHZ, CLOCK_UA_LOW},
+    {CLOCK_HIGH_DIV, CLOCK_HIGH_MHZ, CLOCK_UA_HIGH}
+};
+
+static CLOCK_LEVEL_T clockLevel = CLOCK_HIGH;           /* The design starts at full speed */
+static uint8 clockBurst;                                /* Nesting depth of the bursts */
+static uint32 clockBursts;                              /* Number of bursts since start-up */
+static uint32 clockBurstStart;                          /* SysTick value at the start of the burst */
+static uint32 clockBurstCycles;                         /* Length of the last burst */
+
+
+/*******************************************************************************
+* Function Name: ClockSet
+********************************************************************************
+*
+* Summary:
+*   Switches SYSCLK to the operating point.
+*
+*******************************************************************************/
+static void ClockSet(CLOCK_LEVEL_T level)
+{
+    const CLOCK_POINT_T *point = &clockPoint[level];
+
+    if(level != clockLevel)
+    {
+        if(point->mhz > clockPoint[clockLevel].mhz)
+        {
+            CySysFlashSetWaitCycles(point->mhz);
+            CySysClkWriteSysclkDiv(point->div);
+        }
+        else
+        {
+            CySysClkWriteSysclkDiv(point->div);
+            CySysFlashSetWaitCycles(point->mhz);
+        }
+        EnergySetActiveCurrent(point->current);
+        clockLevel = level;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ClockInit
+********************************************************************************
+*
+* Summary:
+*   Drops to the low operating point. Called after the start-up, which runs
+*   at full speed.
+*
+*******************************************************************************/
+void ClockInit(void)
+{
+    clockBurst = 0u;
+    ClockSet(CLOCK_LOW);
+}
+
+
+/*******************************************************************************
+* Function Name: ClockBurstEnter
+********************************************************************************
+*
+* Summary:
+*   Raises the clock to the maximum for a computation burst. Bursts nest and
+*   must be called from the main loop only; they must not span a low power
+*   mode, because the free running SysTick of boot.c times them.
+*
+*******************************************************************************/
+void ClockBurstEnter(void)
+{
+    if(clockBurst == 0u)
+    {
+        ClockSet(CLOCK_HIGH);
+        clockBursts++;
+        clockBurstStart = CY_SYS_SYST_CVR_REG;
+    }
+    clockBurst++;
+}
+
+
+/*******************************************************************************
+* Function Name: ClockBurstExit
+********************************************************************************
+*
+* Summary:
+*   Ends a burst of ClockBurstEnter(). The clock drops when the outermost
+*   burst ends.
+*
+*******************************************************************************/
+void ClockBurstExit(void)
+{
+    if(clockBurst != 0u)
+    {
+        clockBurst--;
+        if(clockBurst == 0u)
+        {
+            /* SysTick counts down */
+            clockBurstCycles = (clockBurstStart - CY_SYS_SYST_CVR_REG) & CY_SYS_SYST_RVR_CNT_MASK;
+            ClockSet(CLOCK_LOW);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ClockGetLevel
+********************************************************************************
+*
+* Summary:
+*   Returns the current operating point.
+*
+*******************************************************************************/
+CLOCK_LEVEL_T ClockGetLevel(void)
+{
+    return(clockLevel);
+}
+
+
+/*******************************************************************************
+* Function Name: ClockCharge
+********************************************************************************
+*
+* Summary:
+*   Estimates the charge of a computation at an operating point from its
+*   cycle count, the time at SYSCLK times the typical Active current.
+*
+* Parameters:
+*   level - the operating point.
+*   cycles - CPU cycles of the computation, as measured by the profiler.
+*
+* Return:
+*   Charge, nAs.
+*
+*******************************************************************************/
+uint32 ClockCharge(CLOCK_LEVEL_T level, uint32 cycles)
+{
+    const CLOCK_POINT_T *point = &clockPoint[level];
+
+    return(((cycles / point->mhz) * point->current) / 1000u);
+}
+
+
+/*******************************************************************************
+* Function Name: ClockPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the operating points with the charge of the energy model, per
+*   million cycles and for the last burst, which is a measurement when it
+*   was started by BlsSimulate().
+*
+*******************************************************************************/
+void ClockPrint(void)
+{
+    uint32 i;
+
+    printf("Clock: level %d, bursts %ld, last burst %ld cycles \r\n", clockLevel, clockBursts, clockBurstCycles);
+    printf("  point MHz uA nAs/Mcycle nAs/burst \r\n");
+    for(i = 0u; i < CLOCK_LEVEL_COUNT; i++)
+    {
+        printf("  %ld %d %d %ld %ld \r\n", i, clockPoint[i].mhz, clockPoint[i].current,
+            ClockCharge((CLOCK_LEVEL_T)i, CLOCK_MODEL_CYCLES), ClockCharge((CLOCK_LEVEL_T)i, clockBurstCycles));
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+* File Name: clock.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the system clock
+*  manager.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CLOCK_H)
+#define CLOCK_H
+
+#include "common.h"
+#include "energy.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+
+/* SYSCLK prescaler between bursts. HFCLK / 2 is the fastest clock that
+*  needs no flash wait state; the BLE stack must still process its events
+*  within a connection interval.
+*/
+#define CLOCK_LOW_DIV               (CY_SYS_CLK_SYSCLK_DIV2)
+
+
+/***************************************
+*          Constants
+***************************************/
+#define CLOCK_HIGH_DIV              (CY_SYS_CLK_SYSCLK_DIV1)
+#define CLOCK_LOW_MHZ               (CYDEV_BCLK__HFCLK__MHZ >> CLOCK_LOW_DIV)
+#define CLOCK_HIGH_MHZ              (CYDEV_BCLK__HFCLK__MHZ >> CLOCK_HIGH_DIV)
+
+/* Typical Active mode supply current at each operating point, uA */
+#define CLOCK_UA_LOW                (1000u)
+#define CLOCK_UA_HIGH               (ENERGY_UA_ACTIVE)
+
+#define CLOCK_MODEL_CYCLES          (1000000u)  /* Work unit of the energy model */
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef enum
+{
+    CLOCK_LOW,                                  /* Housekeeping and BLE event handling */
+    CLOCK_HIGH,                                 /* Computation bursts */
+    CLOCK_LEVEL_COUNT
+}CLOCK_LEVEL_T;
+
+typedef struct
+{
+    uint8  div;                                 /* CY_SYS_CLK_SYSCLK_DIVx */
+    uint8  mhz;                                 /* SYSCLK */
+    uint16 current;                             /* Active mode supply current, uA */
+}CLOCK_POINT_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void ClockInit(void);
+void ClockBurstEnter(void);
+void ClockBurstExit(void);
+CLOCK_LEVEL_T ClockGetLevel(void);
+uint32 ClockCharge(CLOCK_LEVEL_T level, uint32 cycles);
+void ClockPrint(void);
+
+
+#endif /* CLOCK_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,301 @@
+/*******************************************************************************
+* File Name: codec.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the lossless waveform codec. Neighbouring cuff pressure
+*  samples differ by a few counts, so each difference to the previous sample
+*  is zigzag mapped to an unsigned value and Rice coded: the value shifted
+*  right by k in unary, then its k low bits. The parameter k follows a
+*  running mean of the values, so it adapts within a block without a
+*  second pass, and the encoder runs one sample at a time in the sample
+*  interrupt. A block fills one notification; every block starts with a raw
+*  sample and its own k, so it decodes without the blocks before it.
+*
+*  The decoder uses only portable C and builds for the collector as well.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "codec.h"
+
+
+/*******************************************************************************
+* Function Name: CodecAdapt
+********************************************************************************
+*
+* Summary:
+*   Adds the coded value to the running mean and moves k to the power of two
+*   of the mean. k moves by a step or two per sample, so this is not a loop
+*   in practice.
+*
+*******************************************************************************/
+static CODEC_RAMFUNC void CodecAdapt(uint32 *sum, uint8 *k, uint16 value)
+{
+    uint8 kNew = *k;
+
+    *sum = *sum - (*sum >> CODEC_MEAN_SHIFT) + value;
+    while((kNew < CODEC_K_MAX) && (*sum >= ((2u << CODEC_MEAN_SHIFT) << kNew)))
+    {
+        kNew++;
+    }
+    while((kNew > 0u) && (*sum < ((1u << CODEC_MEAN_SHIFT) << kNew)))
+    {
+        kNew--;
+    }
+    *k = kNew;
+}
+
+
+/*******************************************************************************
+* Function Name: CodecPutBits
+********************************************************************************
+*
+* Summary:
+*   Appends the n low bits of the value to the bit stream, most significant
+*   bit first.
+*
+*******************************************************************************/
+static CODEC_RAMFUNC void CodecPutBits(CODEC_ENC_T *enc, uint16 value, uint8 n)
+{
+    uint8 room;
+    uint8 take;
+
+    while(n != 0u)
+    {
+        room = 8u - (uint8)(enc->bitPos & 0x07u);
+        take = (n < room) ? n : room;
+        n -= take;
+        enc->buf[enc->bitPos >> 3u] |= (uint8)(((value >> n) & ((1u << take) - 1u)) << (room - take));
+        enc->bitPos += take;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CodecStart
+********************************************************************************
+*
+* Summary:
+*   Starts a new block.
+*
+* Parameters:
+*   enc - encoder state.
+*   buf - the block buffer.
+*   size - size of the block buffer, the notification payload, at most
+*          CODEC_BLOCK_MAX.
+*   seq - block sequence number.
+*   k - Rice parameter to start with; passing the k of the previous block
+*       saves relearning it.
+*
+*******************************************************************************/
+void CodecStart(CODEC_ENC_T *enc, uint8 *buf, uint8 size, uint16 seq, uint8 k)
+{
+    (void)memset(buf, 0, size);
+    buf[CODEC_HDR_SEQ] = (uint8)seq;
+    buf[CODEC_HDR_SEQ + 1u] = (uint8)(seq >> 8u);
+    buf[CODEC_HDR_K] = k;
+
+    enc->buf = buf;
+    enc->bitPos = CODEC_HDR_SIZE * 8u;
+    enc->bitMax = (uint16)size * 8u;
+    enc->sum = (uint32)(1u << CODEC_MEAN_SHIFT) << k;
+    enc->prev = 0;
+    enc->k = k;
+    enc->count = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: CodecPut
+********************************************************************************
+*
+* Summary:
+*   Encodes the sample into the block. A difference whose unary part would
+*   reach CODEC_ESCAPE is stored raw after CODEC_ESCAPE ones, which bounds
+*   the size of a sample. Runs once per sample in the WDT interrupt, from
+*   SRAM when the waveform stream is built in.
+*
+* Parameters:
+*   enc - encoder state.
+*   sample - signed 12-bit sample.
+*
+* Return:
+*   Number of samples in the block, or 0 if the block is full; the sample
+*   then starts the next block.
+*
+*******************************************************************************/
+CODEC_RAMFUNC uint8 CodecPut(CODEC_ENC_T *enc, int16 sample)
+{
+    uint8 added = 1u;
+    uint16 diff;
+    uint16 value;
+    uint16 q;
+
+    if(enc->count == CODEC_COUNT_MAX)
+    {
+        added = 0u;
+    }
+    else if(enc->count == 0u)
+    {
+        CodecPutBits(enc, (uint16)sample & CODEC_SAMPLE_MASK, CODEC_SAMPLE_BITS);
+    }
+    else
+    {
+        diff = (uint16)(sample - enc->prev);
+        value = (uint16)((uint16)(diff << 1u) ^ (((diff & 0x8000u) != 0u) ? 0xFFFFu : 0u));
+        q = value >> enc->k;
+
+        if(q < CODEC_ESCAPE)
+        {
+            if((enc->bitPos + q + 1u + enc->k) > enc->bitMax)
+            {
+                added = 0u;
+            }
+            else
+            {
+                CodecPutBits(enc, (uint16)((1u << q) - 1u) << 1u, (uint8)(q + 1u));
+                CodecPutBits(enc, value, enc->k);
+            }
+        }
+        else
+        {
+            if((enc->bitPos + CODEC_ESCAPE + CODEC_RAW_BITS) > enc->bitMax)
+            {
+                added = 0u;
+            }
+            else
+            {
+                CodecPutBits(enc, (1u << CODEC_ESCAPE) - 1u, CODEC_ESCAPE);
+                CodecPutBits(enc, value, CODEC_RAW_BITS);
+            }
+        }
+
+        if(added != 0u)
+        {
+            CodecAdapt(&enc->sum, &enc->k, value);
+        }
+    }
+
+    if(added != 0u)
+    {
+        enc->prev = sample;
+        enc->count++;
+        enc->buf[CODEC_HDR_COUNT] = enc->count;
+    }
+    return((added != 0u) ? enc->count : 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: CodecGetBits
+********************************************************************************
+*
+* Summary:
+*   Reads n bits of the bit stream, most significant bit first.
+*
+*******************************************************************************/
+static uint16 CodecGetBits(const uint8 *buf, uint16 *bitPos, uint8 n)
+{
+    uint16 value = 0u;
+
+    while(n != 0u)
+    {
+        value = (uint16)(value << 1u) | ((buf[*bitPos >> 3u] >> (7u - (*bitPos & 0x07u))) & 1u);
+        (*bitPos)++;
+        n--;
+    }
+    return(value);
+}
+
+
+/*******************************************************************************
+* Function Name: CodecDecode
+********************************************************************************
+*
+* Summary:
+*   Decodes a block.
+*
+* Parameters:
+*   buf - the block.
+*   size - size of the block.
+*   samples - receives the samples.
+*   max - capacity of samples.
+*
+* Return:
+*   Number of samples decoded; fewer than the block holds if the block is
+*   truncated or max is reached.
+*
+*******************************************************************************/
+uint8 CodecDecode(const uint8 *buf, uint8 size, int16 *samples, uint8 max)
+{
+    uint16 bitPos = CODEC_HDR_SIZE * 8u;
+    uint16 bitMax = (uint16)size * 8u;
+    uint8 count = 0u;
+    uint8 k;
+    uint32 sum;
+    uint16 q;
+    uint16 value;
+    int16 sample = 0;
+
+    if(size >= CODEC_HDR_SIZE)
+    {
+        k = buf[CODEC_HDR_K];
+        sum = (uint32)(1u << CODEC_MEAN_SHIFT) << k;
+
+        while((count < buf[CODEC_HDR_COUNT]) && (count < max))
+        {
+            if(count == 0u)
+            {
+                if((bitPos + CODEC_SAMPLE_BITS) > bitMax)
+                {
+                    break;
+                }
+                value = CodecGetBits(buf, &bitPos, CODEC_SAMPLE_BITS);
+                sample = (int16)(uint16)(((value & (1u << (CODEC_SAMPLE_BITS - 1u))) != 0u) ?
+                                         (value | (uint16)~CODEC_SAMPLE_MASK) : value);
+            }
+            else
+            {
+                q = 0u;
+                while((q < CODEC_ESCAPE) && (bitPos < bitMax) && (CodecGetBits(buf, &bitPos, 1u) != 0u))
+                {
+                    q++;
+                }
+                if(q == CODEC_ESCAPE)
+                {
+                    if((bitPos + CODEC_RAW_BITS) > bitMax)
+                    {
+                        break;
+                    }
+                    value = CodecGetBits(buf, &bitPos, CODEC_RAW_BITS);
+                }
+                else
+                {
+                    if((bitPos + k) > bitMax)
+                    {
+                        break;
+                    }
+                    value = (uint16)(q << k) | CodecGetBits(buf, &bitPos, k);
+                }
+                sample = (int16)(sample + (int16)((value >> 1u) ^ (((value & 1u) != 0u) ? 0xFFFFu : 0u)));
+                CodecAdapt(&sum, &k, value);
+            }
+            samples[count] = sample;
+            count++;
+        }
+    }
+    return(count);
+}
+
+
+/* [] END OF FILE */
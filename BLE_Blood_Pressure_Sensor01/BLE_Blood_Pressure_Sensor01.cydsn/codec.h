@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File Name: codec.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the lossless waveform
+*  codec.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CODEC_H)
+#define CODEC_H
+
+#include <cytypes.h>
+#include "ramfunc.h"
+#include "calib.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#define CODEC_K_INIT                (2u)        /* Rice parameter of the first block */
+#define CODEC_ESCAPE                (12u)       /* Quotient that escapes to a raw value */
+
+/* The encoder runs from SRAM only where it runs once per sample, in the
+*  waveform stream. Without the stream it is linked for the profiler at
+*  most, so it stays in flash and takes no SRAM.
+*/
+#if (CAL_PRESSURE_ENABLE != 0u)
+    #define CODEC_RAMFUNC           RAMFUNC
+#else
+    #define CODEC_RAMFUNC
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+/***************************************
+*          Constants
+***************************************/
+
+/* Block: sequence number, sample count, Rice parameter, then the bit stream
+*  with the first sample raw and the zigzag mapped differences Rice coded.
+*/
+#define CODEC_HDR_SIZE              (4u)
+#define CODEC_HDR_SEQ               (0u)
+#define CODEC_HDR_COUNT             (2u)
+#define CODEC_HDR_K                 (3u)
+
+#define CODEC_SAMPLE_BITS           (12u)       /* Signed SAR result */
+#define CODEC_SAMPLE_MASK           ((1u << CODEC_SAMPLE_BITS) - 1u)
+#define CODEC_RAW_BITS              (CODEC_SAMPLE_BITS + 1u)    /* Zigzag mapped difference */
+#define CODEC_K_MAX                 (CODEC_SAMPLE_BITS)
+#define CODEC_MEAN_SHIFT            (4u)        /* Running mean over about 16 differences */
+#define CODEC_BLOCK_MAX             (255u)      /* Largest block, the sizes are uint8 */
+#define CODEC_COUNT_MAX             (255u)      /* Samples per block, the count is uint8 */
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Encoder state of one block */
+typedef struct
+{
+    uint8  *buf;                                /* Block, header included */
+    uint16 bitPos;                              /* Next bit of the bit stream */
+    uint16 bitMax;
+    uint32 sum;                                 /* Running mean of the mapped differences << CODEC_MEAN_SHIFT */
+    int16  prev;
+    uint8  k;
+    uint8  count;
+}CODEC_ENC_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void CodecStart(CODEC_ENC_T *enc, uint8 *buf, uint8 size, uint16 seq, uint8 k);
+CODEC_RAMFUNC uint8 CodecPut(CODEC_ENC_T *enc, int16 sample);
+uint8 CodecDecode(const uint8 *buf, uint8 size, int16 *samples, uint8 max);
+
+
+#endif /* CODEC_H */
+
+/* [] END OF FILE */
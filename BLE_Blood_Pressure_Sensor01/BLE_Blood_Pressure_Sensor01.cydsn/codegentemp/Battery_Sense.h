@@ -0,0 +1,93 @@
+/*******************************************************************************
+* File Name: Battery_Sense.h  
+* Version 2.10
+*
+* Description:
+*  This file containts Control Register function prototypes and register defines
+*
+* Note:
+*
+********************************************************************************
+* Copyright 2008-2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions, 
+* disclaimers, and limitations in the end user license agreement accompanying 
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PINS_Battery_Sense_H) /* Pins Battery_Sense_H */
+#define CY_PINS_Battery_Sense_H
+
+#include "cytypes.h"
+#include "cyfitter.h"
+#include "Battery_Sense_aliases.h"
+
+
+/***************************************
+*        Function Prototypes             
+***************************************/    
+
+void    Battery_Sense_Write(uint8 value) ;
+void    Battery_Sense_SetDriveMode(uint8 mode) ;
+uint8   Battery_Sense_ReadDataReg(void) ;
+uint8   Battery_Sense_Read(void) ;
+uint8   Battery_Sense_ClearInterrupt(void) ;
+
+
+/***************************************
+*           API Constants        
+***************************************/
+
+/* Drive Modes */
+#define Battery_Sense_DRIVE_MODE_BITS        (3)
+#define Battery_Sense_DRIVE_MODE_IND_MASK    (0xFFFFFFFFu >> (32 - Battery_Sense_DRIVE_MODE_BITS))
+
+#define Battery_Sense_DM_ALG_HIZ         (0x00u)
+#define Battery_Sense_DM_DIG_HIZ         (0x01u)
+#define Battery_Sense_DM_RES_UP          (0x02u)
+#define Battery_Sense_DM_RES_DWN         (0x03u)
+#define Battery_Sense_DM_OD_LO           (0x04u)
+#define Battery_Sense_DM_OD_HI           (0x05u)
+#define Battery_Sense_DM_STRONG          (0x06u)
+#define Battery_Sense_DM_RES_UPDWN       (0x07u)
+
+/* Digital Port Constants */
+#define Battery_Sense_MASK               Battery_Sense__MASK
+#define Battery_Sense_SHIFT              Battery_Sense__SHIFT
+#define Battery_Sense_WIDTH              1u
+
+
+/***************************************
+*             Registers        
+***************************************/
+
+/* Main Port Registers */
+/* Pin State */
+#define Battery_Sense_PS                     (* (reg32 *) Battery_Sense__PS)
+/* Port Configuration */
+#define Battery_Sense_PC                     (* (reg32 *) Battery_Sense__PC)
+/* Data Register */
+#define Battery_Sense_DR                     (* (reg32 *) Battery_Sense__DR)
+/* Input Buffer Disable Override */
+#define Battery_Sense_INP_DIS                (* (reg32 *) Battery_Sense__PC2)
+
+
+#if defined(Battery_Sense__INTSTAT)  /* Interrupt Registers */
+
+    #define Battery_Sense_INTSTAT                (* (reg32 *) Battery_Sense__INTSTAT)
+
+#endif /* Interrupt Registers */
+
+
+/***************************************
+* The following code is DEPRECATED and 
+* must not be used.
+***************************************/
+
+#define Battery_Sense_DRIVE_MODE_SHIFT       (0x00u)
+#define Battery_Sense_DRIVE_MODE_MASK        (0x07u << Battery_Sense_DRIVE_MODE_SHIFT)
+
+
+#endif /* End Pins Battery_Sense_H */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,39 @@
+/*******************************************************************************
+* File Name: Battery_Sense.h  
+* Version 2.10
+*
+* Description:
+*  This file contains the Alias definitions for Per-Pin APIs in cypins.h. 
+*  Information on using these APIs can be found in the System Reference Guide.
+*
+* Note:
+*
+********************************************************************************
+* Copyright 2008-2014, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions, 
+* disclaimers, and limitations in the end user license agreement accompanying 
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(CY_PINS_Battery_Sense_ALIASES_H) /* Pins Battery_Sense_ALIASES_H */
+#define CY_PINS_Battery_Sense_ALIASES_H
+
+#include "cytypes.h"
+#include "cyfitter.h"
+#include "cypins.h"
+
+
+/***************************************
+*              Constants        
+***************************************/
+#define Battery_Sense_0		(Battery_Sense__0__PC)
+#define Battery_Sense_0_PS		(Battery_Sense__0__PS)
+#define Battery_Sense_0_PC		(Battery_Sense__0__PC)
+#define Battery_Sense_0_DR		(Battery_Sense__0__DR)
+#define Battery_Sense_0_SHIFT	(Battery_Sense__0__SHIFT)
+
+
+#endif /* End Pins Battery_Sense_ALIASES_H */
+
+
+/* [] END OF FILE */
@@ -133,7 +133,7 @@ the software package with which this file was provided.
 #endif /* CYBLE_MODE_PROFILE */
 
 /* GATT MTU Size */
-#define CYBLE_GATT_MTU                               (0x0017u)
+#define CYBLE_GATT_MTU                               (0x00F7u)
 
 /* RAM memory size required for stack */
 #if(CYBLE_MODE_PROFILE)
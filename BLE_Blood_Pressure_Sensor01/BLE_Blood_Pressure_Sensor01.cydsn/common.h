@@ -15,6 +15,7 @@
 
 #include <project.h>
 #include <stdio.h>
+#include "ramfunc.h"
 
 #if(CYBLE_GATT_ROLE_SERVER)
 #include "server.h"
@@ -24,6 +25,9 @@
 #endif /* (CYBLE_GATT_ROLE_CLIENT) */
 
 #define DEBUG_OUT
+#if !defined(DEBUG_PRINTF_NEWLIB)
+    #define DEBUG_PRINTF_NEWLIB     (0)     /* Set to 1 to format the traces with newlib printf */
+#endif /* !defined(DEBUG_PRINTF_NEWLIB) */
 
 #define ENABLED                     (1u)
 #define DISABLED                    (0u)
@@ -38,20 +42,42 @@
 #define WDT_INTERRUPT_SOURCE        (CY_SYS_WDT_COUNTER1_INT) 
 #define WDT_COUNTER_ENABLE          (1u)
 #define WDT_1SEC                    (32767u)
+#define WDT_TICKS_SHIFT             (15u)           /* WDT ticks per second (1 << 15) */
 
 
 /***************************************
 *        External Function Prototypes
 ***************************************/
 int _write(int file, char *ptr, int len);
+int DebugPrintf(const char *format, ...);
 void DebugOut(uint32 event, void* eventParam);
+uint32 WDT_ReadTime(uint32 *ticks);
+uint32 WDT_ReadTicks(void);
 
 
 /***************************************
 * External data references
 ***************************************/
 extern CYBLE_API_RESULT_T apiResult;
-extern volatile uint32 mainTimer;
+extern volatile uint32 wdtSeconds;
+extern uint16 gattMtu;
+
+
+/* The traces use the formatter of debug.c: no heap, no FILE buffering and
+*  only the conversions the firmware needs. Every printf of a file that
+*  includes common.h goes to DebugPrintf, which supports:
+*   - the flags '-' and '0', a width and a precision up to 255 given as digits
+*   - the 'l' length
+*   - the conversions d, i, u, x, X, c, s and %%
+*  Anything else is not printf: the flags '+', ' ' and '#', '*', the 'h',
+*  'll' and 'z' lengths, and the conversions o, p, n, e, f and g. The
+*  first unsupported character is printed as text and takes no argument,
+*  so the arguments after it shift. A precision of 0 counts as none, so
+*  %.0s prints the whole string.
+*/
+#if (DEBUG_PRINTF_NEWLIB == 0)
+#define printf                      DebugPrintf
+#endif /* (DEBUG_PRINTF_NEWLIB == 0) */
 
 
 /* [] END OF FILE */
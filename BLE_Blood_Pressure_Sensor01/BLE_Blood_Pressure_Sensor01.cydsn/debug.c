@@ -13,7 +13,21 @@
 * the software package with which this file was provided.
 *******************************************************************************/
 
+#include <stdarg.h>
 #include "common.h"
+#include "energy.h"
+#include "boot.h"
+
+#define DEBUG_DEC_DIGITS            (10u)       /* Digits of the largest uint32 */
+
+/* Powers of ten for the decimal conversion, the Cortex-M0 has no divider */
+static const uint32 debugPow10[DEBUG_DEC_DIGITS] =
+{
+    1000000000u, 100000000u, 10000000u, 1000000u, 100000u,
+    10000u, 1000u, 100u, 10u, 1u
+};
+
+static const char debugHex[] = "0123456789abcdef";
 
 
 #if defined(__ARMCC_VERSION)
@@ -42,6 +56,7 @@ int fputc(int ch, FILE *file)
     switch( file->handle )
     {
         case STDOUT_HANDLE:
+            BootUartStart();
             UART_DEB_UartPutChar(ch);
             ret = ch ;
             break ;
@@ -74,11 +89,14 @@ size_t __write(int handle, const unsigned char * buffer, size_t size)
         return (0);
     }
 
+    BootUartStart();
+    EnergySubsystemStart(ENERGY_SUB_UART);
     for (/* Empty */; size != 0; --size)
     {
         UART_DEB_UartPutChar(*buffer++);
         ++nChars;
     }
+    EnergySubsystemStop(ENERGY_SUB_UART);
 
     return (nChars);
 }
@@ -90,10 +108,13 @@ int _write(int file, char *ptr, int len)
 {
     int i;
     file = file;
+    BootUartStart();
+    EnergySubsystemStart(ENERGY_SUB_UART);
     for (i = 0; i < len; i++)
     {
         UART_DEB_UartPutChar(*ptr++);
     }
+    EnergySubsystemStop(ENERGY_SUB_UART);
     return len;
 }
 
@@ -101,6 +122,268 @@ int _write(int file, char *ptr, int len)
 #endif  /* (__ARMCC_VERSION) */
 
 
+/*******************************************************************************
+* Function Name: DebugDigits
+********************************************************************************
+*
+* Summary:
+*   Converts the value to decimal or hexadecimal digits without leading
+*   zeros. The decimal digits are found by subtracting powers of ten.
+*
+* Parameters:
+*   buf - receives the digits, DEBUG_DEC_DIGITS bytes.
+*   value - the value.
+*   hex - ENABLED for hexadecimal.
+*
+* Return:
+*   Number of digits, at least one.
+*
+*******************************************************************************/
+static uint8 DebugDigits(char *buf, uint32 value, uint8 hex)
+{
+    uint8 len = 0u;
+    uint8 i;
+    uint8 digit;
+
+    if(hex != DISABLED)
+    {
+        for(i = 28u; i > 0u; i -= 4u)
+        {
+            digit = (uint8)((value >> i) & 0x0Fu);
+            if((digit != 0u) || (len != 0u))
+            {
+                buf[len] = debugHex[digit];
+                len++;
+            }
+        }
+        buf[len] = debugHex[value & 0x0Fu];
+        len++;
+    }
+    else
+    {
+        for(i = 0u; i < (DEBUG_DEC_DIGITS - 1u); i++)
+        {
+            digit = 0u;
+            while(value >= debugPow10[i])
+            {
+                value -= debugPow10[i];
+                digit++;
+            }
+            if((digit != 0u) || (len != 0u))
+            {
+                buf[len] = (char)('0' + digit);
+                len++;
+            }
+        }
+        buf[len] = (char)('0' + value);
+        len++;
+    }
+    return(len);
+}
+
+
+/*******************************************************************************
+* Function Name: DebugPut
+********************************************************************************
+*
+* Summary:
+*   Writes the character n times to the debug UART.
+*
+*******************************************************************************/
+static void DebugPut(char ch, uint8 n)
+{
+    for(; n != 0u; n--)
+    {
+        UART_DEB_UartPutChar((uint32)(uint8)ch);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: DebugPrintf
+********************************************************************************
+*
+* Summary:
+*   Formats the trace straight into the debug UART buffer, replaces printf.
+*   Supports the flags '-' and '0', width, precision and the 'l' length for
+*   the conversions d, i, u, x, X, c, s and %. Keeps no state between calls
+*   and allocates nothing. Traces come from the main loop only, the BLE
+*   stack callbacks included: the characters of a trace made by an
+*   interrupt would mix with the trace it preempted.
+*
+* Parameters:
+*   format - printf format string.
+*
+* Return:
+*   Number of characters written.
+*
+*******************************************************************************/
+int DebugPrintf(const char *format, ...)
+{
+    va_list args;
+    char digits[DEBUG_DEC_DIGITS];
+    const char *str;
+    uint32 value;
+    uint32 len;
+    uint8 width;
+    uint8 prec;
+    uint8 zeros;
+    uint8 left;
+    uint8 zeroPad;
+    uint8 isLong;
+    char sign;
+    int count = 0;
+
+    va_start(args, format);
+    BootUartStart();
+    EnergySubsystemStart(ENERGY_SUB_UART);
+    while(*format != '\0')
+    {
+        if(*format != '%')
+        {
+            DebugPut(*format, 1u);
+            count++;
+            format++;
+        }
+        else
+        {
+            format++;
+            left = DISABLED;
+            zeroPad = DISABLED;
+            for(; (*format == '-') || (*format == '0'); format++)
+            {
+                if(*format == '-')
+                {
+                    left = ENABLED;
+                }
+                else
+                {
+                    zeroPad = ENABLED;
+                }
+            }
+            for(width = 0u; (*format >= '0') && (*format <= '9'); format++)
+            {
+                width = (uint8)((width * 10u) + (uint8)(*format - '0'));
+            }
+            prec = 0u;
+            if(*format == '.')
+            {
+                for(format++; (*format >= '0') && (*format <= '9'); format++)
+                {
+                    prec = (uint8)((prec * 10u) + (uint8)(*format - '0'));
+                }
+                zeroPad = DISABLED;
+            }
+            isLong = DISABLED;
+            if(*format == 'l')
+            {
+                isLong = ENABLED;
+                format++;
+            }
+
+            sign = '\0';
+            str = digits;
+            switch(*format)
+            {
+                case 'd':
+                case 'i':
+                    value = (isLong != DISABLED) ? (uint32)va_arg(args, long) : (uint32)va_arg(args, int);
+                    if((int32)value < 0)
+                    {
+                        sign = '-';
+                        value = 0u - value;
+                    }
+                    len = DebugDigits(digits, value, DISABLED);
+                    break;
+
+                case 'u':
+                case 'x':
+                case 'X':
+                    value = (isLong != DISABLED) ? (uint32)va_arg(args, unsigned long) :
+                                                   (uint32)va_arg(args, unsigned int);
+                    len = DebugDigits(digits, value, (*format == 'u') ? DISABLED : ENABLED);
+                    if(*format == 'X')
+                    {
+                        for(zeros = 0u; zeros < len; zeros++)
+                        {
+                            if(digits[zeros] >= 'a')
+                            {
+                                digits[zeros] -= (char)('a' - 'A');
+                            }
+                        }
+                    }
+                    break;
+
+                case 'c':
+                    digits[0u] = (char)va_arg(args, int);
+                    len = 1u;
+                    prec = 0u;
+                    break;
+
+                case 's':
+                    str = va_arg(args, const char *);
+                    for(len = 0u; (str[len] != '\0') && ((prec == 0u) || (len < prec)); len++)
+                    {
+                    }
+                    prec = 0u;
+                    break;
+
+                case '\0':
+                    /* The format ends within the conversion */
+                    format--;
+                    len = 0u;
+                    break;
+
+                default:
+                    /* "%%" and unsupported conversions are written as they are */
+                    digits[0u] = *format;
+                    len = 1u;
+                    prec = 0u;
+                    break;
+            }
+            format++;
+
+            /* Field: padding, sign, zeros up to the precision or the width, digits */
+            zeros = (prec > len) ? (uint8)(prec - len) : 0u;
+            if(sign != '\0')
+            {
+                len++;
+            }
+            if((zeroPad != DISABLED) && (left == DISABLED) && (width > len))
+            {
+                zeros = (uint8)(width - len);
+            }
+            width = (width > (zeros + len)) ? (uint8)(width - zeros - len) : 0u;
+
+            if(left == DISABLED)
+            {
+                DebugPut(' ', width);
+            }
+            if(sign != '\0')
+            {
+                DebugPut(sign, 1u);
+                len--;
+                count++;
+            }
+            DebugPut('0', zeros);
+            for(value = 0u; value < len; value++)
+            {
+                DebugPut(str[value], 1u);
+            }
+            if(left != DISABLED)
+            {
+                DebugPut(' ', width);
+            }
+            count += width + zeros + len;
+        }
+    }
+    EnergySubsystemStop(ENERGY_SUB_UART);
+    va_end(args);
+
+    return(count);
+}
+
+
 void DebugOut(uint32 event, void* eventParam)
 {
     switch(event)
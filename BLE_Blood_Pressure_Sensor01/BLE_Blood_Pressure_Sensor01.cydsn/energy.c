@@ -0,0 +1,319 @@
+/*******************************************************************************
+* File Name: energy.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the runtime energy accounting. Every power mode
+*  transition is timestamped with the WDT counter, and the time is split
+*  per power mode, per Deep Sleep blocker and per busy subsystem. Blockers
+*  and subsystems may overlap. The charge is estimated from typical
+*  currents. The report is printed on the debug UART only: the GATT
+*  database has no characteristic for it.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "energy.h"
+
+
+static uint16 energyModeCurrent[ENERGY_MODE_COUNT] =
+{
+    ENERGY_UA_ACTIVE, ENERGY_UA_SLEEP, ENERGY_UA_DEEPSLEEP
+};
+
+static const uint16 energySubCurrent[ENERGY_SUB_COUNT] =
+{
+    ENERGY_UA_BLE, ENERGY_UA_ADC, ENERGY_UA_UART, ENERGY_UA_FLASH, ENERGY_UA_SAR, ENERGY_UA_SENSOR
+};
+
+static const char *const energyBlockName[ENERGY_BLOCK_COUNT] =
+{
+    "", "uart", "bless", "adc", "event"
+};
+
+static ENERGY_TIME_T energyMode[ENERGY_MODE_COUNT];     /* Residency per power mode */
+static ENERGY_TIME_T energyBlock[ENERGY_BLOCK_COUNT];   /* Time spent shallower because of a blocker */
+static uint32 energyBlockCount[ENERGY_BLOCK_COUNT];     /* Number of times a blocker prevented Deep Sleep */
+static ENERGY_TIME_T energySub[ENERGY_SUB_COUNT];       /* Busy time per subsystem, may overlap */
+static uint32 energySubStart[ENERGY_SUB_COUNT];
+
+static ENERGY_MODE_T energyModeCur;
+static uint32 energyBlockCur;                           /* Bitmask of ENERGY_BLOCK_T */
+static uint32 energyModeStart;
+
+static uint32 energyCharge;                             /* uAs */
+static uint32 energyChargeFrac;                         /* uA * ticks below one uAs */
+
+
+/*******************************************************************************
+* Function Name: EnergyAddTime
+********************************************************************************
+*
+* Summary:
+*   Adds the elapsed WDT ticks to the accumulated time.
+*
+* Parameters:
+*   time - accumulated time.
+*   ticks - elapsed WDT ticks.
+*
+*******************************************************************************/
+static void EnergyAddTime(ENERGY_TIME_T *time, uint32 ticks)
+{
+    ticks += time->ticks;
+    time->seconds += ticks >> ENERGY_TICKS_SHIFT;
+    time->ticks = ticks & ENERGY_TICKS_MASK;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyAddCharge
+********************************************************************************
+*
+* Summary:
+*   Adds the charge drawn at the given current over the elapsed WDT ticks.
+*   Whole seconds and the remainder are multiplied separately, so long
+*   intervals cannot overflow and no division is needed.
+*
+* Parameters:
+*   ticks - elapsed WDT ticks.
+*   current - supply current, uA.
+*
+*******************************************************************************/
+static void EnergyAddCharge(uint32 ticks, uint32 current)
+{
+    uint32 frac;
+
+    frac = ((ticks & ENERGY_TICKS_MASK) * current) + energyChargeFrac;
+    energyCharge += ((ticks >> ENERGY_TICKS_SHIFT) * current) + (frac >> ENERGY_TICKS_SHIFT);
+    energyChargeFrac = frac & ENERGY_TICKS_MASK;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyTimeToMs
+********************************************************************************
+*
+* Summary:
+*   Converts the accumulated time to milliseconds.
+*
+*******************************************************************************/
+static uint32 EnergyTimeToMs(const ENERGY_TIME_T *time)
+{
+    return((time->seconds * 1000u) + ((time->ticks * 1000u) >> ENERGY_TICKS_SHIFT));
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyFlush
+********************************************************************************
+*
+* Summary:
+*   Accounts the time since the last transition to the current power mode
+*   and blockers.
+*
+*******************************************************************************/
+static void EnergyFlush(void)
+{
+    uint32 now = WDT_ReadTicks();
+    uint32 elapsed = now - energyModeStart;
+    uint32 i;
+
+    EnergyAddTime(&energyMode[energyModeCur], elapsed);
+    EnergyAddCharge(elapsed, energyModeCurrent[energyModeCur]);
+    for(i = ENERGY_BLOCK_NONE + 1u; i < ENERGY_BLOCK_COUNT; i++)
+    {
+        if((energyBlockCur & ENERGY_BLOCK_MASK(i)) != 0u)
+        {
+            EnergyAddTime(&energyBlock[i], elapsed);
+        }
+    }
+    energyModeStart = now;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyInit
+********************************************************************************
+*
+* Summary:
+*   Starts the accounting in Active mode. Must be called after WDT_Start().
+*
+*******************************************************************************/
+void EnergyInit(void)
+{
+    energyModeCur = ENERGY_MODE_ACTIVE;
+    energyBlockCur = 0u;
+    energyModeStart = WDT_ReadTicks();
+}
+
+
+/*******************************************************************************
+* Function Name: EnergySetMode
+********************************************************************************
+*
+* Summary:
+*   Records a power mode transition. Called with interrupts disabled right
+*   before entering a low power mode and with ENERGY_MODE_ACTIVE right after
+*   waking up.
+*
+* Parameters:
+*   mode - the power mode being entered.
+*   blockers - bitmask of the reasons Deep Sleep was not possible, built with
+*              ENERGY_BLOCK_MASK(), or 0.
+*
+*******************************************************************************/
+void EnergySetMode(ENERGY_MODE_T mode, uint32 blockers)
+{
+    uint32 i;
+
+    EnergyFlush();
+    for(i = ENERGY_BLOCK_NONE + 1u; i < ENERGY_BLOCK_COUNT; i++)
+    {
+        if((blockers & ENERGY_BLOCK_MASK(i)) != 0u)
+        {
+            energyBlockCount[i]++;
+        }
+    }
+    energyModeCur = mode;
+    energyBlockCur = blockers;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergySetActiveCurrent
+********************************************************************************
+*
+* Summary:
+*   Changes the Active mode current when the clock manager switches the
+*   operating point. The time so far is accounted at the previous current.
+*
+* Parameters:
+*   current - Active mode supply current, uA.
+*
+*******************************************************************************/
+void EnergySetActiveCurrent(uint16 current)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    EnergyFlush();
+    energyModeCurrent[ENERGY_MODE_ACTIVE] = current;
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: EnergySubsystemStart
+********************************************************************************
+*
+* Summary:
+*   Marks the beginning of a busy period of the subsystem.
+*
+*******************************************************************************/
+void EnergySubsystemStart(ENERGY_SUB_T sub)
+{
+    energySubStart[sub] = WDT_ReadTicks();
+}
+
+
+/*******************************************************************************
+* Function Name: EnergySubsystemStop
+********************************************************************************
+*
+* Summary:
+*   Marks the end of a busy period of the subsystem and accounts for its
+*   additional current.
+*
+*******************************************************************************/
+void EnergySubsystemStop(ENERGY_SUB_T sub)
+{
+    uint32 elapsed = WDT_ReadTicks() - energySubStart[sub];
+
+    EnergyAddTime(&energySub[sub], elapsed);
+    EnergyAddCharge(elapsed, energySubCurrent[sub]);
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyGetReport
+********************************************************************************
+*
+* Summary:
+*   Returns the per mode residency and the estimated charge.
+*
+*******************************************************************************/
+void EnergyGetReport(ENERGY_REPORT_T *report)
+{
+    report->active = energyMode[ENERGY_MODE_ACTIVE].seconds;
+    report->sleep = energyMode[ENERGY_MODE_SLEEP].seconds;
+    report->deepSleep = energyMode[ENERGY_MODE_DEEPSLEEP].seconds;
+    report->charge = energyCharge;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyResume
+********************************************************************************
+*
+* Summary:
+*   Continues the accounting from a report saved before Hibernate. The time
+*   in Hibernate is not known and not counted.
+*
+*******************************************************************************/
+void EnergyResume(const ENERGY_REPORT_T *report)
+{
+    energyMode[ENERGY_MODE_ACTIVE].seconds += report->active;
+    energyMode[ENERGY_MODE_SLEEP].seconds += report->sleep;
+    energyMode[ENERGY_MODE_DEEPSLEEP].seconds += report->deepSleep;
+    energyCharge += report->charge;
+}
+
+
+/*******************************************************************************
+* Function Name: EnergyPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the residency, the Deep Sleep blockers, the subsystem busy time
+*   and the estimated charge. The saving of the analog front end gating is
+*   the charge the gated subsystems would have drawn while powered off.
+*
+*******************************************************************************/
+void EnergyPrint(void)
+{
+    uint32 i;
+    uint32 total = energyMode[ENERGY_MODE_ACTIVE].seconds + energyMode[ENERGY_MODE_SLEEP].seconds +
+                   energyMode[ENERGY_MODE_DEEPSLEEP].seconds;
+
+    printf("Energy: active %ld ms, sleep %ld ms, deep sleep %ld ms, %ld uAh \r\n",
+        EnergyTimeToMs(&energyMode[ENERGY_MODE_ACTIVE]),
+        EnergyTimeToMs(&energyMode[ENERGY_MODE_SLEEP]),
+        EnergyTimeToMs(&energyMode[ENERGY_MODE_DEEPSLEEP]),
+        energyCharge / 3600u);
+    printf("Blockers:");
+    for(i = ENERGY_BLOCK_NONE + 1u; i < ENERGY_BLOCK_COUNT; i++)
+    {
+        printf(" %s %ld (%ld ms)", energyBlockName[i], energyBlockCount[i], EnergyTimeToMs(&energyBlock[i]));
+    }
+    printf(" \r\n");
+    printf("Subsystems: ble %ld ms, adc %ld ms, uart %ld ms, flash %ld ms, sar %ld ms, sensor %ld ms \r\n",
+        EnergyTimeToMs(&energySub[ENERGY_SUB_BLE]),
+        EnergyTimeToMs(&energySub[ENERGY_SUB_ADC]),
+        EnergyTimeToMs(&energySub[ENERGY_SUB_UART]),
+        EnergyTimeToMs(&energySub[ENERGY_SUB_FLASH]),
+        EnergyTimeToMs(&energySub[ENERGY_SUB_SAR]),
+        EnergyTimeToMs(&energySub[ENERGY_SUB_SENSOR]));
+    printf("Gating saved: sar %ld uAh, sensor %ld uAh \r\n",
+        ((total - energySub[ENERGY_SUB_SAR].seconds) * ENERGY_UA_SAR) / 3600u,
+        ((total - energySub[ENERGY_SUB_SENSOR].seconds) * ENERGY_UA_SENSOR) / 3600u);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,113 @@
+/*******************************************************************************
+* File Name: energy.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the runtime energy
+*  accounting.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(ENERGY_H)
+#define ENERGY_H
+
+#include "common.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+#define ENERGY_TICKS_SHIFT          (WDT_TICKS_SHIFT)
+#define ENERGY_TICKS_MASK           ((1u << ENERGY_TICKS_SHIFT) - 1u)
+
+#define ENERGY_BLOCK_MASK(block)    ((uint32)1u << (block))
+
+/* Typical supply current in each power mode, uA */
+#define ENERGY_UA_ACTIVE            (1700u)
+#define ENERGY_UA_SLEEP             (1100u)
+#define ENERGY_UA_DEEPSLEEP         (2u)
+
+/* Typical additional current while a subsystem is busy, uA */
+#define ENERGY_UA_BLE               (0u)        /* CPU only, the radio runs in the link layer */
+#define ENERGY_UA_ADC               (1000u)
+#define ENERGY_UA_UART              (150u)
+#define ENERGY_UA_FLASH             (3000u)
+#define ENERGY_UA_SAR               (250u)      /* SAR enabled between conversions */
+#define ENERGY_UA_SENSOR            (1000u)     /* Pressure transducer excitation */
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef enum
+{
+    ENERGY_MODE_ACTIVE,
+    ENERGY_MODE_SLEEP,
+    ENERGY_MODE_DEEPSLEEP,
+    ENERGY_MODE_COUNT
+}ENERGY_MODE_T;
+
+/* Reason the device could not enter a deeper power mode, at most 32 */
+typedef enum
+{
+    ENERGY_BLOCK_NONE,
+    ENERGY_BLOCK_UART_TX,                   /* Debug output still in the TX buffer */
+    ENERGY_BLOCK_BLESS,                     /* BLESS does not allow Deep Sleep */
+    ENERGY_BLOCK_ADC,                       /* SAR conversion in progress */
+    ENERGY_BLOCK_EVENT,                     /* Event posted after the queue was drained */
+    ENERGY_BLOCK_COUNT
+}ENERGY_BLOCK_T;
+
+typedef enum
+{
+    ENERGY_SUB_BLE,
+    ENERGY_SUB_ADC,
+    ENERGY_SUB_UART,
+    ENERGY_SUB_FLASH,
+    ENERGY_SUB_SAR,                         /* Powered, see analog.c */
+    ENERGY_SUB_SENSOR,                      /* Powered, see analog.c */
+    ENERGY_SUB_COUNT
+}ENERGY_SUB_T;
+
+/* Accumulated time in seconds and WDT ticks */
+typedef struct
+{
+    uint32 seconds;
+    uint32 ticks;
+}ENERGY_TIME_T;
+
+/* Residency and charge, retained across Hibernate */
+typedef struct
+{
+    uint32 active;                          /* Seconds */
+    uint32 sleep;                           /* Seconds */
+    uint32 deepSleep;                       /* Seconds */
+    uint32 charge;                          /* uAs */
+}ENERGY_REPORT_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void EnergyInit(void);
+void EnergySetMode(ENERGY_MODE_T mode, uint32 blockers);
+void EnergySetActiveCurrent(uint16 current);
+void EnergySubsystemStart(ENERGY_SUB_T sub);
+void EnergySubsystemStop(ENERGY_SUB_T sub);
+void EnergyGetReport(ENERGY_REPORT_T *report);
+void EnergyResume(const ENERGY_REPORT_T *report);
+void EnergyPrint(void);
+
+
+#endif /* ENERGY_H */
+
+/* [] END OF FILE */
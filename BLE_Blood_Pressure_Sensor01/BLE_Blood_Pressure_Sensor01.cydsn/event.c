@@ -0,0 +1,137 @@
+/*******************************************************************************
+* File Name: event.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the lock-free event queue used by interrupts to pass
+*  work to the main loop. Ticks are queued individually instead of being
+*  collapsed into a counter.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "event.h"
+
+
+EVENT_QUEUE_T timerQueue;                       /* Produced by Timer_Interrupt */
+
+
+/*******************************************************************************
+* Function Name: EventPost
+********************************************************************************
+*
+* Summary:
+*   Adds an event to the queue. Called by the producer only.
+*
+* Parameters:
+*   queue - the event queue.
+*   type - event type.
+*   payload - event specific value.
+*
+* Return:
+*   ENABLED if the event was queued, DISABLED if the queue was full.
+*
+*******************************************************************************/
+uint8 EventPost(EVENT_QUEUE_T *queue, EVENT_TYPE_T type, uint32 payload)
+{
+    uint8 head = queue->head;
+    uint8 used = (uint8)(head - queue->tail);
+    uint8 result = DISABLED;
+
+    if(used < EVENT_QUEUE_SIZE)
+    {
+        queue->buf[head & EVENT_QUEUE_MASK].type = (uint8)type;
+        queue->buf[head & EVENT_QUEUE_MASK].payload = payload;
+
+        /* The slot must be complete before the consumer can see it */
+        __DMB();
+        queue->head = (uint8)(head + 1u);
+
+        if(used >= queue->highWater)
+        {
+            queue->highWater = used + 1u;
+        }
+        result = ENABLED;
+    }
+    else
+    {
+        queue->overflow++;
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: EventGet
+********************************************************************************
+*
+* Summary:
+*   Removes the oldest event from the queue. Called by the consumer only.
+*
+* Parameters:
+*   queue - the event queue.
+*   event - receives the event.
+*
+* Return:
+*   ENABLED if an event was returned, DISABLED if the queue was empty.
+*
+*******************************************************************************/
+uint8 EventGet(EVENT_QUEUE_T *queue, EVENT_T *event)
+{
+    uint8 tail = queue->tail;
+    uint8 result = DISABLED;
+
+    if(tail != queue->head)
+    {
+        /* Read the slot only after the head that published it */
+        __DMB();
+        *event = queue->buf[tail & EVENT_QUEUE_MASK];
+
+        /* The slot must be read before the producer can reuse it */
+        __DMB();
+        queue->tail = (uint8)(tail + 1u);
+        result = ENABLED;
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: EventPending
+********************************************************************************
+*
+* Summary:
+*   Checks whether the queue holds events. Used by the main loop with
+*   interrupts disabled right before entering a low power mode.
+*
+*******************************************************************************/
+uint8 EventPending(const EVENT_QUEUE_T *queue)
+{
+    return((queue->head != queue->tail) ? ENABLED : DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: EventPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the queue statistics.
+*
+*******************************************************************************/
+void EventPrint(const EVENT_QUEUE_T *queue)
+{
+    printf("Event queue: queued %d, high-water %d of %d, overflow %ld \r\n",
+        (uint8)(queue->head - queue->tail), queue->highWater, EVENT_QUEUE_SIZE, queue->overflow);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,87 @@
+/*******************************************************************************
+* File Name: event.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the interrupt to main
+*  loop event queue.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(EVENT_H)
+#define EVENT_H
+
+#include "common.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+#define EVENT_QUEUE_SIZE            (8u)        /* Must be a power of two, 128 at most */
+#define EVENT_QUEUE_MASK            (EVENT_QUEUE_SIZE - 1u)
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef enum
+{
+    EVENT_NONE,
+    EVENT_TIMER,                                /* WDT one second tick, payload: tick number */
+    EVENT_TYPE_COUNT
+}EVENT_TYPE_T;
+
+typedef struct
+{
+    uint8  type;
+    uint32 payload;
+}EVENT_T;
+
+/* Single producer, single consumer ring. The producer (one interrupt) owns
+*  head and the statistics, the consumer (the main loop) owns tail. Each
+*  additional interrupt that posts events gets its own queue, so neither
+*  side ever has to disable interrupts.
+*
+*  The WDT tick is the only producer. The other interrupt sources have no
+*  work to pass on: the debug UART is built without its SCB interrupt and
+*  is polled from its RX FIFO, the ADC is polled or read by the waveform
+*  sampler inside the WDT interrupt, and SW2 only wakes the device from
+*  Hibernate, which resets it before any handler runs.
+*/
+typedef struct
+{
+    EVENT_T buf[EVENT_QUEUE_SIZE];
+    volatile uint8 head;                        /* Next slot to write, free running */
+    volatile uint8 tail;                        /* Next slot to read, free running */
+    uint8  highWater;                           /* Maximum number of queued events */
+    uint32 overflow;                            /* Events dropped because the queue was full */
+}EVENT_QUEUE_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+uint8 EventPost(EVENT_QUEUE_T *queue, EVENT_TYPE_T type, uint32 payload);
+uint8 EventGet(EVENT_QUEUE_T *queue, EVENT_T *event);
+uint8 EventPending(const EVENT_QUEUE_T *queue);
+void EventPrint(const EVENT_QUEUE_T *queue);
+
+
+/***************************************
+* External data references
+***************************************/
+extern EVENT_QUEUE_T timerQueue;
+
+
+#endif /* EVENT_H */
+
+/* [] END OF FILE */
@@ -21,9 +21,103 @@
 
 #include "blss.h"
 #include "bas.h"
+#include "calib.h"
+#include "energy.h"
+#include "profile.h"
+#include "event.h"
+#include "rtc.h"
+#include "record.h"
+#include "racp.h"
+#include "wave.h"
+#include "mem.h"
+#include "boot.h"
+#include "retain.h"
+#include "power.h"
+#include "clock.h"
 
-volatile uint32 mainTimer = 0;
+volatile uint32 wdtSeconds = 0;
 CYBLE_API_RESULT_T apiResult;
+uint16 gattMtu = CYBLE_GATT_DEFAULT_MTU;        /* ATT MTU of the connection */
+
+
+/*******************************************************************************
+* Function Name: WriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles writes of the custom characteristics. Writes of the standard
+*   services are handled by the BLE component. The custom characteristics
+*   exist only when their service is added in the BLE component customizer.
+*
+* Parameters:
+*  wrReq - the write request parameters.
+*
+*******************************************************************************/
+static void WriteRequest(CYBLE_GATTS_WRITE_REQ_PARAM_T *wrReq)
+{
+    CYBLE_GATTS_ERR_PARAM_T err;
+    uint8 handled = DISABLED;
+
+    err.attrHandle = wrReq->handleValPair.attrHandle;
+    err.opcode = (uint8)CYBLE_GATT_WRITE_REQ;
+    err.errorCode = CYBLE_GATT_ERR_NONE;
+
+#if defined(CYBLE_CLOCK_DATE_TIME_CHAR_HANDLE)
+    if(err.attrHandle == CYBLE_CLOCK_DATE_TIME_CHAR_HANDLE)
+    {
+        err.errorCode = RtcWriteRequest(&wrReq->handleValPair);
+        handled = ENABLED;
+    }
+#endif /* defined(CYBLE_CLOCK_DATE_TIME_CHAR_HANDLE) */
+
+#if defined(CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE)
+    if(err.attrHandle == CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE)
+    {
+        err.errorCode = RacpWriteRequest(&wrReq->handleValPair);
+        handled = ENABLED;
+    }
+    else if(err.attrHandle == CYBLE_RECORD_ACCESS_RACP_CCCD_DESC_HANDLE)
+    {
+        err.errorCode = RacpCccdWriteRequest(&wrReq->handleValPair);
+        handled = ENABLED;
+    }
+    else
+    {
+        /* Not a record access attribute */
+    }
+#endif /* defined(CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE) */
+
+#if defined(CYBLE_WAVEFORM_CONTROL_CHAR_HANDLE)
+    if(err.attrHandle == CYBLE_WAVEFORM_CONTROL_CHAR_HANDLE)
+    {
+        err.errorCode = WaveWriteRequest(&wrReq->handleValPair);
+        handled = ENABLED;
+    }
+    else if(err.attrHandle == CYBLE_WAVEFORM_DATA_CCCD_DESC_HANDLE)
+    {
+        err.errorCode = WaveCccdWriteRequest(&wrReq->handleValPair);
+        handled = ENABLED;
+    }
+    else
+    {
+        /* Not a waveform attribute */
+    }
+#endif /* defined(CYBLE_WAVEFORM_CONTROL_CHAR_HANDLE) */
+
+    if(handled == ENABLED)
+    {
+        if(err.errorCode == CYBLE_GATT_ERR_NONE)
+        {
+            (void)CyBle_GattsWriteAttributeValue(&wrReq->handleValPair, 0u, &wrReq->connHandle,
+                                                 CYBLE_GATT_DB_PEER_INITIATED);
+            (void)CyBle_GattsWriteRsp(wrReq->connHandle);
+        }
+        else
+        {
+            (void)CyBle_GattsErrorRsp(wrReq->connHandle, &err);
+        }
+    }
+}
 
 
 /*******************************************************************************
@@ -40,26 +134,62 @@ CYBLE_API_RESULT_T apiResult;
 *******************************************************************************/
 void AppCallBack(uint32 event, void* eventParam)
 {
+    PROFILE_ENTER(PROFILE_APP_CALLBACK);
+
 #ifdef DEBUG_OUT    
+    PROFILE_ENTER(PROFILE_DEBUG_OUT);
     DebugOut(event, eventParam);
+    PROFILE_EXIT(PROFILE_DEBUG_OUT);
 #endif
 
     switch(event)
     {
         case CYBLE_EVT_STACK_ON:
         case CYBLE_EVT_GAP_DEVICE_DISCONNECTED:
-            batteryMeasure = DISABLED;
+            (void)BootStamp(BOOT_STAGE_STACK_ON);   /* Only the first event is stamped */
+            ServerDisconnected();
+            BasDisconnected();
+            WaveStop();
             /* Put the device to discoverable mode so that remote can search it. */
             StartAdvertisement();
             break;
             
         case CYBLE_EVT_GAP_DEVICE_CONNECTED:
             Advertising_LED_Write(LED_OFF);
+            gattMtu = CYBLE_GATT_DEFAULT_MTU;
+            WaveSetMtu(gattMtu);
+            ServerConnected();
+            BasConnected();
+            RacpConnected();
+            BlsConnected();
+            break;
+
+        case CYBLE_EVT_GATTS_XCNHG_MTU_REQ:
+            /* The component has already responded with its own MTU; the
+            *  smaller of the two applies to the connection.
+            */
+            gattMtu = ((CYBLE_GATT_XCHG_MTU_PARAM_T *)eventParam)->mtu;
+            if(gattMtu > CYBLE_GATT_MTU)
+            {
+                gattMtu = CYBLE_GATT_MTU;
+            }
+            WaveSetMtu(gattMtu);
+            printf("ATT MTU: %d \r\n", gattMtu);
+            break;
+
+        case CYBLE_EVT_GATTS_HANDLE_VALUE_CNF:
+            RacpConfirmed();
+            break;
+
+        case CYBLE_EVT_GATTS_WRITE_REQ:
+            WriteRequest((CYBLE_GATTS_WRITE_REQ_PARAM_T *)eventParam);
             break;
 
         default:
             break;
     }
+
+    PROFILE_EXIT(PROFILE_APP_CALLBACK);
 }
 
 
@@ -74,6 +204,8 @@ void AppCallBack(uint32 event, void* eventParam)
 *******************************************************************************/
 void Timer_Interrupt(void)
 {
+    PROFILE_ENTER(PROFILE_WDT_ISR);
+
     if(CySysWdtGetInterruptSource() & WDT_INTERRUPT_SOURCE)
     {
         static uint8 led = LED_OFF;
@@ -85,12 +217,22 @@ void Timer_Interrupt(void)
             Advertising_LED_Write(led);
         }
         
-        /* Indicate that timer is raised to the main loop */
-        mainTimer++;
+        /* Pass the tick to the main loop */
+        wdtSeconds++;
+        (void)EventPost(&timerQueue, EVENT_TIMER, wdtSeconds);
         
         /* Clears interrupt request  */
         CySysWdtClearInterrupt(WDT_INTERRUPT_SOURCE);
     }
+
+    /* Waveform sample clock */
+    if(CySysWdtGetInterruptSource() & WAVE_WDT_INTERRUPT_SOURCE)
+    {
+        WaveSample();
+        CySysWdtClearInterrupt(WAVE_WDT_INTERRUPT_SOURCE);
+    }
+
+    PROFILE_EXIT(PROFILE_WDT_ISR);
 }
 
 /*******************************************************************************
@@ -124,14 +266,176 @@ void WDT_Start(void)
 }
 
 
+/*******************************************************************************
+* Function Name: WDT_ReadTime
+********************************************************************************
+*
+* Summary:
+*  Returns the time since WDT_Start() in seconds and WDT ticks (1/32768 s).
+*  A match that has not been serviced yet, because interrupts are disabled,
+*  is accounted for.
+*
+* Parameters:
+*  ticks - receives the ticks within the current second.
+*
+* Return:
+*  Seconds since WDT_Start().
+*
+*******************************************************************************/
+uint32 WDT_ReadTime(uint32 *ticks)
+{
+    uint8 interruptState;
+    uint32 seconds;
+    uint32 count;
+    uint32 pending;
+
+    interruptState = CyEnterCriticalSection();
+    seconds = wdtSeconds;
+    pending = CySysWdtGetInterruptSource() & WDT_INTERRUPT_SOURCE;
+    count = CySysWdtReadCount(WDT_COUNTER);
+    if(pending == 0u)
+    {
+        /* The counter may have cleared on a match between the two reads */
+        if((CySysWdtGetInterruptSource() & WDT_INTERRUPT_SOURCE) != 0u)
+        {
+            count = CySysWdtReadCount(WDT_COUNTER);
+            pending = 1u;
+        }
+    }
+    if(pending != 0u)
+    {
+        seconds++;
+    }
+    CyExitCriticalSection(interruptState);
+
+    *ticks = count;
+    return(seconds);
+}
+
+
+/*******************************************************************************
+* Function Name: WDT_ReadTicks
+********************************************************************************
+*
+* Summary:
+*  Returns the time since WDT_Start() in WDT ticks. Wraps after about
+*  36 hours, so only differences are meaningful.
+*
+*******************************************************************************/
+uint32 WDT_ReadTicks(void)
+{
+    uint32 ticks;
+    uint32 seconds = WDT_ReadTime(&ticks);
+
+    return((seconds << WDT_TICKS_SHIFT) + ticks);
+}
+
+
+/*******************************************************************************
+* Function Name: UartCommand
+********************************************************************************
+*
+* Summary:
+*  Handles single character bench commands received on the debug UART:
+*   '0'..'2' - capture calibration point at the matching reference pressure
+*   'w'      - build the correction table and store the calibration
+*   'c'      - print the calibration
+*              (calibration needs the pressure channel, CAL_PRESSURE_ENABLE)
+*   'e'      - print the energy accounting
+*   'p'      - print the profiler statistics and trace
+*   'b'      - run the computation benchmarks, printed with 'p', and check the codec
+*   'q'      - print the event queue statistics
+*   't'      - print the time
+*   'r'      - print the number of stored records per user
+*   'v'      - print the waveform streaming statistics
+*   'm'      - print the RAM usage
+*   'k'      - print the clock operating points and the energy model
+*
+*******************************************************************************/
+static void UartCommand(void)
+{
+    uint32 cmd = (UART_DEB_initVar != 0u) ? UART_DEB_UartGetChar() : 0u;
+#if (PROFILE_ENABLE != 0u)
+    uint32 mismatches;
+#endif /* (PROFILE_ENABLE != 0u) */
+
+    switch(cmd)
+    {
+    #if (CAL_PRESSURE_ENABLE != 0u)
+        case '0':
+        case '1':
+        case '2':
+            CalCapture((uint8)(cmd - '0'));
+            break;
+
+        case 'w':
+            ClockBurstEnter();
+            EnergySubsystemStart(ENERGY_SUB_FLASH);
+            (void)CalStore();
+            EnergySubsystemStop(ENERGY_SUB_FLASH);
+            ClockBurstExit();
+            break;
+
+        case 'c':
+            CalPrint();
+            break;
+    #endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+        case 'e':
+            EnergyPrint();
+            break;
+
+    #if (PROFILE_ENABLE != 0u)
+        case 'p':
+            ProfilePrint();
+            break;
+
+        case 'b':
+            ClockBurstEnter();
+            mismatches = ProfileBench();
+            ClockBurstExit();
+            printf("Benchmark codec mismatches: %ld \r\n", mismatches);
+            break;
+    #endif /* (PROFILE_ENABLE != 0u) */
+
+        case 'q':
+            EventPrint(&timerQueue);
+            break;
+
+        case 't':
+            RtcPrint();
+            break;
+
+        case 'r':
+            RecordPrint();
+            break;
+
+        case 'v':
+            WavePrint();
+            break;
+
+        case 'm':
+            MemPrint();
+            break;
+
+        case 'k':
+            ClockPrint();
+            break;
+
+        default:
+            break;
+    }
+}
+
+
 int main()
 {
-    CYBLE_LP_MODE_T lpMode;
-    CYBLE_BLESS_STATE_T blessState;
+    EVENT_T event;
 
+    MemInit();                      /* Paint the free RAM while nothing below the stack pointer is live */
+    (void)BootStamp(BOOT_STAGE_MAIN);
     CyGlobalIntEnable;
-    UART_DEB_Start();               /* Start communication component */
-    printf("BLE Blood Pressure Sensor Example Project \r\n");
+    /* The debug UART and the ADC are started on their first use */
 
     Disconnect_LED_Write(LED_OFF);
     Advertising_LED_Write(LED_OFF);
@@ -141,12 +445,24 @@ int main()
     {
         printf("CyBle_Start API Error: %x \r\n", apiResult);
     }
+    (void)BootStamp(BOOT_STAGE_BLE_START);
 
+#if (PROFILE_ENABLE != 0u)
+    ProfileInit();
+#endif /* (PROFILE_ENABLE != 0u) */
+
+    ServerCccdInit();
     BasInit();
     BlsInit();
+#if (CAL_PRESSURE_ENABLE != 0u)
+    CalInit();
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+    RecordInit();
     
-    ADC_Start();
     WDT_Start();
+    EnergyInit();
+    RtcInit();
+    (void)RetainRestore();
     
     /* Uncomment the line below to printf all events via UART for debug */
     /*cyBle_eventHandlerFlag |= CYBLE_ENABLE_ALL_EVENTS;*/
@@ -155,6 +471,7 @@ int main()
     {
         printf("CyBle_BlssSetCharacteristicValue API Error: %x \r\n", apiResult);
     }
+    (void)BootStamp(BOOT_STAGE_APP_INIT);
 
     /***************************************************************************
     * Main polling loop
@@ -163,78 +480,94 @@ int main()
     {
         if(CyBle_GetState() != CYBLE_STATE_INITIALIZING)
         {
-            /* Enter DeepSleep mode between connection intervals */
-            lpMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
-            CyGlobalIntDisable;
-            blessState = CyBle_GetBleSsState();
-
-            if(lpMode == CYBLE_BLESS_DEEPSLEEP) 
-            {   
-                if(blessState == CYBLE_BLESS_STATE_ECO_ON || blessState == CYBLE_BLESS_STATE_DEEPSLEEP)
-                {
-                    /* Put the device into the Deep Sleep mode only when all debug information has been sent */
-                    if((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u)
-                    {
-                        CySysPmDeepSleep();
-                    }
-                    else
+            PowerIdle();
+        }
+        
+        /***********************************************************************
+        * Handle every event posted by the interrupts
+        ***********************************************************************/
+        while(EventGet(&timerQueue, &event) != DISABLED)
+        {
+            switch(event.type)
+            {
+                case EVENT_TIMER:
+                    RtcUpdate();
+                    BasTick();
+
+                    /***********************************************************
+                    *  Periodically measure a battery level and temperature and
+                    *  send results to the Client
+                    ***********************************************************/
+                    if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
                     {
-                        CySysPmSleep();
+                        if((batteryMeasure == ENABLED) && ((BAS_MEASURE_INJ != 0u) || (WaveRunning() == DISABLED)))
+                        {
+                            MeasureBattery();
+                            PROFILE_ENTER(PROFILE_PROCESS_EVENTS);
+                            CyBle_ProcessEvents();
+                            PROFILE_EXIT(PROFILE_PROCESS_EVENTS);
+                        }
+
+                        MemUpdateGatt();
+                        WaveTick();
+
+                        /*******************************************************
+                        *  Simulate Blood Pressure measurement.
+                        *******************************************************/
+                        if(0u != (blsFlag & (NTF | IND)))
+                        {
+                            ClockBurstEnter();
+                            BlsSimulate();
+                            ClockBurstExit();
+                        }
                     }
-                }
-            }
-            else
-            {
-                if(blessState != CYBLE_BLESS_STATE_EVENT_CLOSE)
-                {
-                    CySysPmSleep();
-                }
+                    break;
+
+                default:
+                    break;
             }
-            CyGlobalIntEnable;
         }
-        
+
         /***********************************************************************
         * Wait for connection established with Central device
         ***********************************************************************/
         if(CyBle_GetState() == CYBLE_STATE_CONNECTED)
         {
-            /*******************************************************************
-            *  Periodically measure a battery level and temperature and send 
-            *  results to the Client
-            *******************************************************************/        
-            if(mainTimer != 0u)
+            /* Upload the stored records of the connected user */
+            if(0u != (blsFlag & IND))
             {
-                mainTimer = 0u;                
-                
-                if(batteryMeasure == ENABLED)
-                {
-                    MeasureBattery();
-                    CyBle_ProcessEvents();
-                }
-                
-                /*******************************************************************
-                *  Simulate Blood Pressure measurement.
-                *******************************************************************/
-                if(0u != (blsFlag & (NTF | IND)))
-                {
-                    BlsSimulate();
-                }
+                BlsUpload();
             }
-            
+            RacpProcess();
+            WaveProcess();
+
             /* Store bonding data to flash only when all debug information has been sent */
             if((cyBle_pendingFlashWrite != 0u) &&
                ((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) == 0u))
             {
                 CYBLE_API_RESULT_T apiResult;
+                EnergySubsystemStart(ENERGY_SUB_FLASH);
                 apiResult = CyBle_StoreBondingData(0u);
+                EnergySubsystemStop(ENERGY_SUB_FLASH);
                 printf("Store bonding data, status: %x \r\n", apiResult);
             }
         }
+        else
+        {
+            /* Keep the confirmations of the last connection */
+            (void)RecordAckStore();
+        }
+
+        UartCommand();
 
         /*******************************************************************
         *  Process all pending BLE events in the stack
         *******************************************************************/
+        EnergySubsystemStart(ENERGY_SUB_BLE);
+        PROFILE_ENTER(PROFILE_PROCESS_EVENTS);
         CyBle_ProcessEvents();
+        PROFILE_EXIT(PROFILE_PROCESS_EVENTS);
+        EnergySubsystemStop(ENERGY_SUB_BLE);
     }
 }
 
@@ -0,0 +1,205 @@
+/*******************************************************************************
+* File Name: mem.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the RAM usage instrumentation. The free RAM between the
+*  heap and the stack is painted at start-up and the deepest stack is found
+*  as the lowest word that no longer holds the pattern. The heap is tracked
+*  by an _sbrk that replaces the weak one of Cm0Start.c.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <errno.h>
+#include "mem.h"
+
+/* Symbols of the linker script cm0gcc.ld */
+extern uint32 end[];                            /* End of .bss, start of the heap */
+extern uint32 __cy_heap_limit[];                /* End of the reserved heap */
+extern uint32 __cy_stack[];                     /* Initial stack pointer, end of RAM */
+
+static uint8 *memHeapBreak = (uint8 *)end;      /* Current end of the heap */
+static uint16 memHeapUsed;
+static uint16 memHeapFailed;
+
+
+/*******************************************************************************
+* Function Name: MemInit
+********************************************************************************
+*
+* Summary:
+*   Paints the RAM from the end of the reserved heap up to just below the
+*   stack pointer. Must be the first call in main(), before the interrupts
+*   are enabled, so that nothing below the stack pointer is live.
+*
+*******************************************************************************/
+void MemInit(void)
+{
+    MemPaint(__cy_heap_limit, (const uint32 *)(__get_MSP() - MEM_PAINT_GUARD));
+}
+
+
+/*******************************************************************************
+* Function Name: MemPaint
+********************************************************************************
+*
+* Summary:
+*   Fills the words from from up to to with the paint pattern.
+*
+*******************************************************************************/
+void MemPaint(uint32 *from, const uint32 *to)
+{
+    while(from < to)
+    {
+        *from = MEM_PAINT;
+        from++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: MemScan
+********************************************************************************
+*
+* Summary:
+*   Finds the lowest word between from and to that lost the paint pattern.
+*   The stack grows down, so everything from there up has been used.
+*
+* Return:
+*   The address of that word, to if the whole range still holds the pattern.
+*
+*******************************************************************************/
+const uint32 *MemScan(const uint32 *from, const uint32 *to)
+{
+    while((from < to) && (*from == MEM_PAINT))
+    {
+        from++;
+    }
+    return(from);
+}
+
+
+/*******************************************************************************
+* Function Name: _sbrk
+********************************************************************************
+*
+* Summary:
+*   Moves the end of the heap for malloc() and the newlib stdio buffers,
+*   within the heap reserved in the design wide resources, and keeps the
+*   high-water mark. Replaces the weak implementation in Cm0Start.c.
+*
+* Parameters:
+*  nbytes: The number of bytes requested (if the parameter value is positive)
+*  from the heap or returned back to the heap (if the parameter value is
+*  negative).
+*
+* Return:
+*  The previous end of the heap, (void *)-1 if the request does not fit.
+*
+*******************************************************************************/
+void * _sbrk (int nbytes)
+{
+    void *returnValue;
+    int32 used = (int32)(memHeapBreak - (uint8 *)end) + nbytes;
+
+    if((used >= 0) && (used <= CYDEV_HEAP_SIZE))
+    {
+        returnValue = memHeapBreak;
+        memHeapBreak += nbytes;
+        if((uint16)used > memHeapUsed)
+        {
+            memHeapUsed = (uint16)used;
+        }
+    }
+    else
+    {
+        memHeapFailed++;
+        errno = ENOMEM;
+        returnValue = (void *) -1;
+    }
+    return(returnValue);
+}
+
+
+/*******************************************************************************
+* Function Name: MemGetReport
+********************************************************************************
+*
+* Summary:
+*   Fills the RAM usage report. Scans the painted RAM from the heap limit
+*   up, a few thousand cycles.
+*
+*******************************************************************************/
+void MemGetReport(MEM_REPORT_T *report)
+{
+    const uint32 *stackLow = MemScan(__cy_heap_limit, __cy_stack);
+
+    report->staticRam = (uint16)((uint32)end - CYDEV_SRAM_BASE);
+    report->heapSize = CYDEV_HEAP_SIZE;
+    report->heapUsed = memHeapUsed;
+    report->heapFailed = memHeapFailed;
+    report->stackSize = CYDEV_STACK_SIZE;
+    report->stackMax = (uint16)((uint32)__cy_stack - (uint32)stackLow);
+    report->free = (uint16)((uint32)stackLow - (uint32)__cy_heap_limit);
+}
+
+
+/*******************************************************************************
+* Function Name: MemPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the RAM usage. A stack deeper than its reservation is flagged,
+*   it has grown into the RAM the linker considers free.
+*
+*******************************************************************************/
+void MemPrint(void)
+{
+    MEM_REPORT_T report;
+
+    MemGetReport(&report);
+    printf("RAM: static %d, heap %d of %d (%d refused), stack %d of %d, untouched %d bytes \r\n",
+        report.staticRam, report.heapUsed, report.heapSize, report.heapFailed,
+        report.stackMax, report.stackSize, report.free);
+    if(report.stackMax > report.stackSize)
+    {
+        printf("Stack exceeds its reservation \r\n");
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: MemUpdateGatt
+********************************************************************************
+*
+* Summary:
+*   Writes the RAM usage report to the Memory characteristic of the
+*   Diagnostics custom service, when the service is present in the GATT
+*   database.
+*
+*******************************************************************************/
+void MemUpdateGatt(void)
+{
+#if defined(CYBLE_DIAGNOSTICS_MEMORY_CHAR_HANDLE)
+    MEM_REPORT_T report;
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValuePair;
+
+    MemGetReport(&report);
+    handleValuePair.attrHandle = CYBLE_DIAGNOSTICS_MEMORY_CHAR_HANDLE;
+    handleValuePair.value.val = (uint8 *)&report;
+    handleValuePair.value.len = sizeof(report);
+    (void)CyBle_GattsWriteAttributeValue(&handleValuePair, 0u, &cyBle_connHandle, CYBLE_GATT_DB_LOCALLY_INITIATED);
+#endif /* defined(CYBLE_DIAGNOSTICS_MEMORY_CHAR_HANDLE) */
+}
+
+
+/* [] END OF FILE */
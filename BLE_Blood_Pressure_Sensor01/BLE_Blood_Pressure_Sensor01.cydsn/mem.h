@@ -0,0 +1,63 @@
+/*******************************************************************************
+* File Name: mem.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the RAM usage
+*  instrumentation: stack high-water mark and heap usage.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(MEM_H)
+#define MEM_H
+
+#include "common.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+#define MEM_PAINT                   (0xC5C5C5C5u)   /* Pattern of the RAM the stack never reached */
+#define MEM_PAINT_GUARD             (32u)       /* Bytes left unpainted below the stack pointer */
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* RAM usage in bytes as exposed over GATT */
+typedef struct
+{
+    uint16 staticRam;                           /* .data and .bss, the BLE stack included */
+    uint16 heapSize;                            /* Heap reserved in the design wide resources */
+    uint16 heapUsed;                            /* Highest break requested through _sbrk */
+    uint16 heapFailed;                          /* Requests refused */
+    uint16 stackSize;                           /* Stack reserved in the design wide resources */
+    uint16 stackMax;                            /* Deepest stack seen */
+    uint16 free;                                /* Never touched between the heap and the stack */
+}MEM_REPORT_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void MemInit(void);
+void MemPaint(uint32 *from, const uint32 *to);
+const uint32 *MemScan(const uint32 *from, const uint32 *to);
+void MemGetReport(MEM_REPORT_T *report);
+void MemPrint(void);
+void MemUpdateGatt(void);
+
+
+#endif /* MEM_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,189 @@
+/*******************************************************************************
+* File Name: power.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the power mode governor. Every main loop iteration it
+*  collects the votes against Sleep and Deep Sleep and enters the deepest
+*  mode none of them forbids. Subsystems hold votes with PowerHold() and
+*  PowerRelease(); the BLESS state, the debug UART, the SAR and the event
+*  queue are polled and vote the same way. Each vote that kept the device
+*  out of Deep Sleep is counted by the energy accounting.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "power.h"
+#include "event.h"
+
+
+static volatile uint32 powerHeld[POWER_VOTE_COUNT];     /* Bitmask of ENERGY_BLOCK_T per vote */
+
+
+/*******************************************************************************
+* Function Name: PowerHold
+********************************************************************************
+*
+* Summary:
+*   Votes against a power mode until PowerRelease() is called with the same
+*   vote and reason. Can be called from an interrupt.
+*
+* Parameters:
+*   vote - the power mode to forbid.
+*   reason - the reason code of the caller.
+*
+*******************************************************************************/
+void PowerHold(POWER_VOTE_T vote, ENERGY_BLOCK_T reason)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    powerHeld[vote] |= ENERGY_BLOCK_MASK(reason);
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: PowerRelease
+********************************************************************************
+*
+* Summary:
+*   Withdraws a vote of PowerHold(). Can be called from an interrupt.
+*
+*******************************************************************************/
+void PowerRelease(POWER_VOTE_T vote, ENERGY_BLOCK_T reason)
+{
+    uint8 interruptState = CyEnterCriticalSection();
+
+    powerHeld[vote] &= ~ENERGY_BLOCK_MASK(reason);
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: PowerSelect
+********************************************************************************
+*
+* Summary:
+*   Chooses the deepest power mode the votes permit. Has no side effects.
+*
+* Parameters:
+*   noSleep - reasons voting against Sleep.
+*   noDeepSleep - reasons voting against Deep Sleep.
+*   blockers - returns the reasons that kept the device out of Deep Sleep.
+*
+* Return:
+*   The power mode to enter.
+*
+*******************************************************************************/
+ENERGY_MODE_T PowerSelect(uint32 noSleep, uint32 noDeepSleep, uint32 *blockers)
+{
+    ENERGY_MODE_T mode;
+
+    if(noSleep != 0u)
+    {
+        mode = ENERGY_MODE_ACTIVE;
+    }
+    else if(noDeepSleep != 0u)
+    {
+        mode = ENERGY_MODE_SLEEP;
+    }
+    else
+    {
+        mode = ENERGY_MODE_DEEPSLEEP;
+    }
+    *blockers = noSleep | noDeepSleep;
+    return(mode);
+}
+
+
+/*******************************************************************************
+* Function Name: PowerIdle
+********************************************************************************
+*
+* Summary:
+*   Enters the deepest permitted power mode until the next interrupt. Called
+*   once per main loop iteration when the stack is initialized.
+*
+*   BLESS votes against Sleep while the link layer needs the CPU, that is
+*   when it refused Deep Sleep and closes an event, or when it accepted
+*   Deep Sleep but has not reached it yet. It votes against Deep Sleep when it
+*   refused Deep Sleep otherwise. Debug output still in the TX buffer and a
+*   SAR conversion in progress need HFCLK, and an event posted after the
+*   queue was drained must be handled before sleeping.
+*
+*******************************************************************************/
+void PowerIdle(void)
+{
+    CYBLE_LP_MODE_T lpMode;
+    CYBLE_BLESS_STATE_T blessState;
+    ENERGY_MODE_T mode;
+    uint32 noSleep;
+    uint32 noDeepSleep;
+    uint32 blockers;
+
+    /* Enter DeepSleep mode between connection intervals */
+    lpMode = CyBle_EnterLPM(CYBLE_BLESS_DEEPSLEEP);
+    CyGlobalIntDisable;
+    blessState = CyBle_GetBleSsState();
+
+    noSleep = powerHeld[POWER_NO_SLEEP];
+    noDeepSleep = powerHeld[POWER_NO_DEEPSLEEP];
+    if(lpMode == CYBLE_BLESS_DEEPSLEEP)
+    {
+        if((blessState != CYBLE_BLESS_STATE_ECO_ON) && (blessState != CYBLE_BLESS_STATE_DEEPSLEEP))
+        {
+            noSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_BLESS);
+        }
+    }
+    else if(blessState == CYBLE_BLESS_STATE_EVENT_CLOSE)
+    {
+        noSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_BLESS);
+    }
+    else
+    {
+        noDeepSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_BLESS);
+    }
+    if((UART_DEB_SpiUartGetTxBufferSize() + UART_DEB_GET_TX_FIFO_SR_VALID) != 0u)
+    {
+        noDeepSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_UART_TX);
+    }
+    if((ADC_SAR_STATUS_REG & ADC_STATUS_BUSY) != 0u)
+    {
+        noDeepSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_ADC);
+    }
+    if(EventPending(&timerQueue) != DISABLED)
+    {
+        noSleep |= ENERGY_BLOCK_MASK(ENERGY_BLOCK_EVENT);
+    }
+
+    mode = PowerSelect(noSleep, noDeepSleep, &blockers);
+    EnergySetMode(mode, blockers);
+    if(mode == ENERGY_MODE_DEEPSLEEP)
+    {
+        CySysPmDeepSleep();
+    }
+    else if(mode == ENERGY_MODE_SLEEP)
+    {
+        CySysPmSleep();
+    }
+    else
+    {
+        /* Stay active */
+    }
+    if(mode != ENERGY_MODE_ACTIVE)
+    {
+        EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    }
+    CyGlobalIntEnable;
+}
+
+
+/* [] END OF FILE */
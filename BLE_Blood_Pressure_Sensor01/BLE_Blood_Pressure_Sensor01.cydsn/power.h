@@ -0,0 +1,52 @@
+/*******************************************************************************
+* File Name: power.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the power mode
+*  governor.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(POWER_H)
+#define POWER_H
+
+#include "common.h"
+#include "energy.h"
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Vote against a power mode. A subsystem holds a vote with its reason code
+*  from ENERGY_BLOCK_T while it needs the clocks of the mode above. */
+typedef enum
+{
+    POWER_NO_DEEPSLEEP,                         /* Needs HFCLK, Sleep is allowed */
+    POWER_NO_SLEEP,                             /* Needs the CPU, stay Active */
+    POWER_VOTE_COUNT
+}POWER_VOTE_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void PowerHold(POWER_VOTE_T vote, ENERGY_BLOCK_T reason);
+void PowerRelease(POWER_VOTE_T vote, ENERGY_BLOCK_T reason);
+ENERGY_MODE_T PowerSelect(uint32 noSleep, uint32 noDeepSleep, uint32 *blockers);
+void PowerIdle(void);
+
+
+#endif /* POWER_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,301 @@
+/*******************************************************************************
+* File Name: profile.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the SysTick cycle profiler. SysTick runs free from the
+*  system clock without an interrupt. Each probe stores a stamp in a RAM
+*  trace ring, and each region exit updates the min, max and mean cycles
+*  of the region, less the measured cost of the probes. Nothing is
+*  allocated at run time.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "profile.h"
+
+#if (PROFILE_ENABLE != 0u)
+
+#include "CYBLE_HAL_PVT.h"
+#include "bas.h"
+#include "codec.h"
+
+static PROFILE_STAT_T profileStat[PROFILE_REGION_COUNT];
+static uint32 profileTrace[PROFILE_TRACE_SIZE];
+static uint32 profileTraceIdx;
+static uint32 profileOverhead;                  /* Cycles of a probe pair, subtracted from each region */
+
+
+/*******************************************************************************
+* Function Name: ProfileBlessInterrupt
+********************************************************************************
+*
+* Summary:
+*   Wraps the BLE component interrupt handler in a profiler region.
+*
+*******************************************************************************/
+static CY_ISR(ProfileBlessInterrupt)
+{
+    ProfileEnter(PROFILE_BLESS_ISR);
+    CyBLE_Bless_Interrupt();
+    ProfileExit(PROFILE_BLESS_ISR);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileRecord
+********************************************************************************
+*
+* Summary:
+*   Stores a tagged stamp in the trace ring. Probes run both in the main loop
+*   and in interrupts, so the slot is claimed in a critical section.
+*
+*******************************************************************************/
+static void ProfileRecord(uint32 tag, uint32 stamp)
+{
+    uint8 interruptState;
+
+    interruptState = CyEnterCriticalSection();
+    profileTrace[profileTraceIdx & PROFILE_TRACE_MASK] = (tag << PROFILE_TRACE_TAG_SHIFT) | stamp;
+    profileTraceIdx++;
+    CyExitCriticalSection(interruptState);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileInit
+********************************************************************************
+*
+* Summary:
+*   Wraps the BLESS interrupt and measures the probe overhead with the empty
+*   region: the cycles between the stamps of an entry and the exit that
+*   follows it, which are the trace record of the entry and the call of
+*   ProfileExit(). The least of PROFILE_CALIB_LOOPS pairs is taken, so an
+*   interrupt during the calibration does not inflate it. SysTick runs since
+*   reset, started by the boot profiler. Must be called after CyBle_Start(),
+*   which installs the BLESS interrupt vector.
+*
+*******************************************************************************/
+void ProfileInit(void)
+{
+    uint8 i;
+
+    profileOverhead = 0u;
+    for(i = 0u; i < PROFILE_REGION_COUNT; i++)
+    {
+        (void)memset(&profileStat[i], 0, sizeof(profileStat[i]));
+        profileStat[i].min = CY_SYS_SYST_RVR_CNT_MASK;
+    }
+
+    CYBLE_bless_isr_SetVector(&ProfileBlessInterrupt);
+
+    for(i = 0u; i < PROFILE_CALIB_LOOPS; i++)
+    {
+        PROFILE_ENTER(PROFILE_EMPTY);
+        PROFILE_EXIT(PROFILE_EMPTY);
+    }
+    profileOverhead = profileStat[PROFILE_EMPTY].min;
+    printf("Profiler probe overhead: %ld cycles \r\n", profileOverhead);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileEnter
+********************************************************************************
+*
+* Summary:
+*   Marks the entry to the region. A region must not be re-entered before
+*   its exit.
+*
+*******************************************************************************/
+void ProfileEnter(PROFILE_REGION_T region)
+{
+    uint32 stamp = CY_SYS_SYST_CVR_REG;
+
+    profileStat[region].start = stamp;
+    ProfileRecord((uint32)region, stamp);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileExit
+********************************************************************************
+*
+* Summary:
+*   Marks the exit from the region and updates its statistics with the
+*   cycles less the probe overhead. Regions longer than the SysTick period
+*   (about 350 ms at 48 MHz) are aliased.
+*
+*******************************************************************************/
+void ProfileExit(PROFILE_REGION_T region)
+{
+    uint32 stamp = CY_SYS_SYST_CVR_REG;
+    PROFILE_STAT_T *stat = &profileStat[region];
+    uint32 cycles;
+
+    /* SysTick counts down */
+    cycles = (stat->start - stamp) & CY_SYS_SYST_RVR_CNT_MASK;
+    cycles = (cycles > profileOverhead) ? (cycles - profileOverhead) : 0u;
+
+    stat->count++;
+    stat->sum += cycles;
+    if(cycles < stat->min)
+    {
+        stat->min = cycles;
+    }
+    if(cycles > stat->max)
+    {
+        stat->max = cycles;
+    }
+    ProfileRecord((uint32)region | PROFILE_TRACE_EXIT, stamp);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfilePrint
+********************************************************************************
+*
+* Summary:
+*   Prints the count, min, mean and max cycles per region followed by the
+*   trace ring from the oldest record: region, exit flag and SysTick stamp.
+*   The stamps of the ring are raw, the probe overhead is not subtracted.
+*
+*******************************************************************************/
+void ProfilePrint(void)
+{
+    uint32 idx;
+    uint32 end;
+    uint32 record;
+    uint8 i;
+
+    printf("Profile: region count min mean max (cycles, %ld of overhead subtracted) \r\n", profileOverhead);
+    for(i = 0u; i < PROFILE_REGION_COUNT; i++)
+    {
+        if(profileStat[i].count != 0u)
+        {
+            printf("  %d %ld %ld %ld %ld \r\n", i, profileStat[i].count, profileStat[i].min,
+                (uint32)(profileStat[i].sum / profileStat[i].count), profileStat[i].max);
+        }
+    }
+
+    end = profileTraceIdx;
+    idx = (end > PROFILE_TRACE_SIZE) ? (end - PROFILE_TRACE_SIZE) : 0u;
+    printf("Trace: \r\n");
+    for(; idx != end; idx++)
+    {
+        record = profileTrace[idx & PROFILE_TRACE_MASK];
+        printf("  %d %d %lx \r\n", (uint8)((record >> PROFILE_TRACE_TAG_SHIFT) & ~PROFILE_TRACE_EXIT),
+            ((record >> PROFILE_TRACE_TAG_SHIFT) & PROFILE_TRACE_EXIT) != 0u, record & CY_SYS_SYST_RVR_CNT_MASK);
+    }
+}
+
+
+
+/*******************************************************************************
+* Function Name: ProfileBenchCheck
+********************************************************************************
+*
+* Summary:
+*   Decodes a benchmark block under its region and returns the number of
+*   samples that differ from the input, or are missing or extra.
+*
+*******************************************************************************/
+static uint32 ProfileBenchCheck(const uint8 *block, const int16 *input, uint16 n)
+{
+    int16 samples[CODEC_COUNT_MAX];
+    uint32 mismatches;
+    uint8 count;
+    uint8 i;
+
+    PROFILE_ENTER(PROFILE_BENCH_CODEC_DECODE);
+    count = CodecDecode(block, PROFILE_BENCH_BLOCK, samples, CODEC_COUNT_MAX);
+    PROFILE_EXIT(PROFILE_BENCH_CODEC_DECODE);
+
+    mismatches = (count > n) ? (uint32)(count - n) : (uint32)(n - count);
+    for(i = 0u; (i < count) && (i < n); i++)
+    {
+        mismatches += (samples[i] == input[i]) ? 0u : 1u;
+    }
+    return(mismatches);
+}
+
+
+/*******************************************************************************
+* Function Name: ProfileBench
+********************************************************************************
+*
+* Summary:
+*   Runs the pure computation paths on fixed inputs under their own regions,
+*   so the numbers printed by ProfilePrint() can be compared between builds
+*   without a collector or a cuff attached: the battery voltage and level
+*   conversions over their input range and the waveform codec over a
+*   pseudo-random pulse waveform. Blocks the main loop for a few
+*   milliseconds.
+*
+* Return:
+*   The number of decoded samples that differ from the codec input.
+*
+*******************************************************************************/
+uint32 ProfileBench(void)
+{
+    uint8 block[PROFILE_BENCH_BLOCK];
+    int16 input[PROFILE_BENCH_STEPS];
+    CODEC_ENC_T enc;
+    uint16 noise = PROFILE_BENCH_SEED;
+    uint16 first = 0u;
+    uint32 mismatches = 0u;
+    uint16 i;
+    uint8 added;
+
+#if (BAS_MEASURE_ENABLE != 0)
+    uint16 mvolts;
+
+    for(i = 0u; i < PROFILE_BENCH_STEPS; i++)
+    {
+        PROFILE_ENTER(PROFILE_BENCH_ADC_TO_MV);
+        mvolts = BasAdcToMvolts((int16)(BAS_LUT_ADC_MIN + ((i * BAS_LUT_CODE_MAX) / PROFILE_BENCH_STEPS)));
+        PROFILE_EXIT(PROFILE_BENCH_ADC_TO_MV);
+
+        PROFILE_ENTER(PROFILE_BENCH_MV_TO_LEVEL);
+        (void)BasMvoltsToLevel(mvolts);
+        PROFILE_EXIT(PROFILE_BENCH_MV_TO_LEVEL);
+    }
+#endif /* (BAS_MEASURE_ENABLE != 0) */
+
+    CodecStart(&enc, block, PROFILE_BENCH_BLOCK, 0u, CODEC_K_INIT);
+    for(i = 0u; i < PROFILE_BENCH_STEPS; i++)
+    {
+        /* Slow triangle with a few counts of noise, like a deflating cuff, within the 12-bit range */
+        noise = (uint16)((noise * 25173u) + 13849u);
+        input[i] = (int16)((int16)PROFILE_BENCH_LEVEL - (int16)((i & 0x1Fu) * 8u) + (int16)(noise >> 13u));
+        PROFILE_ENTER(PROFILE_BENCH_CODEC_PUT);
+        added = CodecPut(&enc, input[i]);
+        PROFILE_EXIT(PROFILE_BENCH_CODEC_PUT);
+
+        if(added == 0u)
+        {
+            /* The block is full: check it and start the next one with the sample */
+            mismatches += ProfileBenchCheck(block, &input[first], i - first);
+            first = i;
+            CodecStart(&enc, block, PROFILE_BENCH_BLOCK, i, enc.k);
+            (void)CodecPut(&enc, input[i]);
+        }
+    }
+    mismatches += ProfileBenchCheck(block, &input[first], PROFILE_BENCH_STEPS - first);
+
+    return(mismatches);
+}
+
+#endif /* (PROFILE_ENABLE != 0u) */
+
+
+/* [] END OF FILE */
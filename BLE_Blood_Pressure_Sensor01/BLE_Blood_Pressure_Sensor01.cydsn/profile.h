@@ -0,0 +1,121 @@
+/*******************************************************************************
+* File Name: profile.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes, constants and probe macros for the
+*  SysTick cycle profiler.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(PROFILE_H)
+#define PROFILE_H
+
+#include "common.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+
+/* The profiler is built in by default and removed from Release builds.
+*  Define PROFILE_ENABLE as 0 or 1 in the build settings to override.
+*/
+#if !defined(PROFILE_ENABLE)
+    #if defined(NDEBUG)
+        #define PROFILE_ENABLE      (0u)
+    #else
+        #define PROFILE_ENABLE      (1u)
+    #endif /* defined(NDEBUG) */
+#endif /* !defined(PROFILE_ENABLE) */
+
+
+/***************************************
+*          Constants
+***************************************/
+#define PROFILE_TRACE_SIZE          (64u)       /* Trace ring entries, must be a power of two */
+#define PROFILE_TRACE_MASK          (PROFILE_TRACE_SIZE - 1u)
+#define PROFILE_TRACE_EXIT          (0x80u)     /* Set in the tag of exit records */
+#define PROFILE_TRACE_TAG_SHIFT     (24u)       /* Tag above the 24-bit SysTick stamp */
+#define PROFILE_CALIB_LOOPS         (8u)        /* Empty probe pairs run to measure the overhead */
+#define PROFILE_BENCH_STEPS         (64u)       /* Calls per benchmarked function */
+#define PROFILE_BENCH_BLOCK         (20u)       /* Codec block, the payload of the default MTU */
+#define PROFILE_BENCH_SEED          (0x1234u)   /* Noise of the benchmark waveform */
+#define PROFILE_BENCH_LEVEL         (1536)      /* Top of the benchmark waveform, within +/-2047 */
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef enum
+{
+    PROFILE_EMPTY,                              /* Empty region, measures the probe overhead */
+    PROFILE_APP_CALLBACK,
+    PROFILE_BLS_IND,
+    PROFILE_MEASURE_BATTERY,
+    PROFILE_PROCESS_EVENTS,
+    PROFILE_WDT_ISR,
+    PROFILE_BLESS_ISR,
+    PROFILE_BLS_NTF,
+    PROFILE_DEBUG_OUT,
+    PROFILE_BENCH_ADC_TO_MV,                    /* Regions of ProfileBench(), fixed inputs */
+    PROFILE_BENCH_MV_TO_LEVEL,
+    PROFILE_BENCH_CODEC_PUT,
+    PROFILE_BENCH_CODEC_DECODE,
+    PROFILE_REGION_COUNT
+}PROFILE_REGION_T;
+
+/* Statistics of one region, in CPU cycles */
+typedef struct
+{
+    uint32 start;                               /* SysTick value at the last entry */
+    uint32 count;
+    uint32 min;
+    uint32 max;
+    uint64 sum;
+}PROFILE_STAT_T;
+
+
+/***************************************
+*       Probe Macros
+***************************************/
+
+/* The cost of a probe pair is measured by ProfileInit(), printed at
+*  start-up and subtracted from every region. Regions are inclusive: time
+*  spent in nested regions and in preempting interrupts is counted as well,
+*  together with the full cost of their probes. Regions must not span a
+*  low power mode, because SysTick stops in Deep Sleep.
+*/
+#if (PROFILE_ENABLE != 0u)
+    #define PROFILE_ENTER(region)   ProfileEnter(region)
+    #define PROFILE_EXIT(region)    ProfileExit(region)
+#else
+    #define PROFILE_ENTER(region)
+    #define PROFILE_EXIT(region)
+#endif /* (PROFILE_ENABLE != 0u) */
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+#if (PROFILE_ENABLE != 0u)
+void ProfileInit(void);
+void ProfileEnter(PROFILE_REGION_T region);
+void ProfileExit(PROFILE_REGION_T region);
+void ProfilePrint(void);
+uint32 ProfileBench(void);
+#endif /* (PROFILE_ENABLE != 0u) */
+
+
+#endif /* PROFILE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,496 @@
+/*******************************************************************************
+* File Name: racp.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the record access control point. The collector selects
+*  stored records of the connected user by sequence number or time stamp and
+*  has them reported, counted or deleted; the op codes, operators and
+*  response codes are the ones of the Glucose profile. A request is checked
+*  when it is written and executed from the main loop, because deleting
+*  records writes flash. The response is indicated when the requested
+*  records have been reported.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "racp.h"
+#include "record.h"
+#include "rtc.h"
+
+
+/* Procedure states */
+#define RACP_STATE_IDLE             (0u)
+#define RACP_STATE_REQUEST          (1u)        /* Written, to be executed by RacpProcess() */
+#define RACP_STATE_REPORT           (2u)        /* Records being indicated by BlsUpload() */
+#define RACP_STATE_RESPONSE         (3u)        /* Response to be indicated */
+#define RACP_STATE_CONFIRM          (4u)        /* Response indicated, not confirmed yet */
+
+static uint8 racpState = RACP_STATE_IDLE;
+static uint8 racpOpCode;
+static uint32 racpFirst;                        /* Selected sequence number range */
+static uint32 racpLast;
+static uint8 racpRsp[RACP_RSP_LEN];
+static uint8 racpRspLen;
+
+
+/*******************************************************************************
+* Function Name: RacpRespond
+********************************************************************************
+*
+* Summary:
+*   Queues the response code for the request op code.
+*
+*******************************************************************************/
+static void RacpRespond(uint8 opCode, uint8 rspCode)
+{
+    racpRsp[0u] = RACP_OP_RSP;
+    racpRsp[1u] = RACP_OPR_NULL;
+    racpRsp[2u] = opCode;
+    racpRsp[3u] = rspCode;
+    racpRspLen = RACP_RSP_LEN;
+    racpState = RACP_STATE_RESPONSE;
+}
+
+
+/*******************************************************************************
+* Function Name: RacpTime
+********************************************************************************
+*
+* Summary:
+*   Reads a time stamp operand in the Date Time characteristic format.
+*
+*******************************************************************************/
+static void RacpTime(const uint8 *val, CYBLE_DATE_TIME_T *time)
+{
+    time->year = CyBle_Get16ByPtr(val);
+    time->month = val[2u];
+    time->day = val[3u];
+    time->hours = val[4u];
+    time->minutes = val[5u];
+    time->seconds = val[6u];
+}
+
+
+/*******************************************************************************
+* Function Name: RacpOperand
+********************************************************************************
+*
+* Summary:
+*   Converts an operand to a record sequence number of the connected user.
+*   A time stamp selects the oldest record stamped at or after it, or when
+*   upper is set, the newest record stamped at or before it.
+*
+* Parameters:
+*   val - the operand.
+*   filter - the filter type of the operand.
+*   upper - ENABLED if the operand is an upper bound.
+*
+*******************************************************************************/
+static uint32 RacpOperand(const uint8 *val, uint8 filter, uint8 upper)
+{
+    CYBLE_DATE_TIME_T time;
+    uint32 seq;
+
+    if(filter == RACP_FILTER_SEQ)
+    {
+        seq = ((uint32)CyBle_Get16ByPtr(&val[2u]) << 16u) | CyBle_Get16ByPtr(val);
+    }
+    else
+    {
+        RacpTime(val, &time);
+        seq = RecordSeqAtTime(blsUser, &time, upper);
+        if(upper == ENABLED)
+        {
+            seq--;
+        }
+    }
+    return(seq);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpOrdered
+********************************************************************************
+*
+* Summary:
+*   Checks that the lower operand of a range does not exceed the upper one.
+*
+*******************************************************************************/
+static uint8 RacpOrdered(const uint8 *val, uint8 filter, uint16 operandLen)
+{
+    CYBLE_DATE_TIME_T time1;
+    CYBLE_DATE_TIME_T time2;
+    uint8 result;
+
+    if(filter == RACP_FILTER_SEQ)
+    {
+        result = (RacpOperand(val, filter, DISABLED) <= RacpOperand(&val[operandLen], filter, DISABLED)) ?
+            ENABLED : DISABLED;
+    }
+    else
+    {
+        RacpTime(val, &time1);
+        RacpTime(&val[operandLen], &time2);
+        result = (RtcCompare(&time1, &time2) != CYBLE_TIME_GREAT) ? ENABLED : DISABLED;
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpFilter
+********************************************************************************
+*
+* Summary:
+*   Resolves the operator and its operands to the range of record sequence
+*   numbers it selects, limited to the stored records.
+*
+* Parameters:
+*   opr - the operator.
+*   val - the operands, starting with the filter type.
+*   len - length of the operands.
+*
+* Return:
+*   RACP_RSP_SUCCESS with racpFirst and racpLast set, or the response code of
+*   the error.
+*
+*******************************************************************************/
+static uint8 RacpFilter(uint8 opr, const uint8 *val, uint16 len)
+{
+    uint8 rspCode = RACP_RSP_SUCCESS;
+    uint16 operandLen = 0u;
+    uint32 first = 0u;
+    uint32 last = REC_SEQ_MAX;
+
+    if(opr == RACP_OPR_ALL)
+    {
+        if(len != 0u)
+        {
+            rspCode = RACP_RSP_INVALID_OPERAND;
+        }
+    }
+    else if((opr == RACP_OPR_LE) || (opr == RACP_OPR_GE) || (opr == RACP_OPR_RANGE))
+    {
+        if(len != 0u)
+        {
+            operandLen = (val[0u] == RACP_FILTER_SEQ) ? RACP_SEQ_LEN : RTC_DATE_TIME_LEN;
+        }
+
+        if(len == 0u)
+        {
+            rspCode = RACP_RSP_INVALID_OPERAND;
+        }
+        else if((val[0u] != RACP_FILTER_SEQ) && (val[0u] != RACP_FILTER_TIME))
+        {
+            rspCode = RACP_RSP_FILTER_NOT_SUPPORTED;
+        }
+        else if(len != (((opr == RACP_OPR_RANGE) ? (operandLen << 1u) : operandLen) + 1u))
+        {
+            rspCode = RACP_RSP_INVALID_OPERAND;
+        }
+        else if(opr == RACP_OPR_LE)
+        {
+            last = RacpOperand(&val[1u], val[0u], ENABLED);
+        }
+        else if(opr == RACP_OPR_GE)
+        {
+            first = RacpOperand(&val[1u], val[0u], DISABLED);
+        }
+        else if(RacpOrdered(&val[1u], val[0u], operandLen) == ENABLED)
+        {
+            first = RacpOperand(&val[1u], val[0u], DISABLED);
+            last = RacpOperand(&val[1u + operandLen], val[0u], ENABLED);
+        }
+        else
+        {
+            rspCode = RACP_RSP_INVALID_OPERAND;
+        }
+    }
+    else if(opr == RACP_OPR_NULL)
+    {
+        rspCode = RACP_RSP_INVALID_OPERATOR;
+    }
+    else
+    {
+        rspCode = RACP_RSP_OPR_NOT_SUPPORTED;
+    }
+
+    racpFirst = RecordFirstSeq(blsUser);
+    racpLast = RecordLastSeq(blsUser);
+    if(first > racpFirst)
+    {
+        racpFirst = first;
+    }
+    if(last < racpLast)
+    {
+        racpLast = last;
+    }
+    return(rspCode);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpWriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles a write of the control point by the collector. A malformed
+*   request is answered with a response code; the write itself fails only
+*   when indications are not enabled or a procedure is in progress, as the
+*   Glucose profile requires. Abort stops the report in progress.
+*
+* Parameters:
+*   handleValuePair - the written op code, operator and operands.
+*
+* Return:
+*   CYBLE_GATT_ERR_NONE if the request was accepted, otherwise the ATT error
+*   code.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T RacpWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+    const uint8 *val = handleValuePair->value.val;
+    uint16 len = handleValuePair->value.len;
+    uint8 rspCode;
+
+#if defined(CYBLE_RECORD_ACCESS_RACP_CCCD_DESC_HANDLE)
+    if(!CYBLE_IS_INDICATION_ENABLED(CYBLE_RECORD_ACCESS_RACP_CCCD_DESC_HANDLE))
+    {
+        gattErr = CYBLE_GATT_ERR_CCCD_IMPROPERLY_CONFIGURED;
+    }
+    else
+#endif /* defined(CYBLE_RECORD_ACCESS_RACP_CCCD_DESC_HANDLE) */
+    if(len < 2u)
+    {
+        gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    else if(val[0u] == RACP_OP_ABORT)
+    {
+        if((racpState == RACP_STATE_RESPONSE) || (racpState == RACP_STATE_CONFIRM))
+        {
+            gattErr = CYBLE_GATT_ERR_PROCEDURE_ALREADY_IN_PROGRESS;
+        }
+        else if((val[1u] != RACP_OPR_NULL) || (len != 2u))
+        {
+            RacpRespond(RACP_OP_ABORT, (val[1u] != RACP_OPR_NULL) ? RACP_RSP_INVALID_OPERATOR :
+                                                                     RACP_RSP_INVALID_OPERAND);
+        }
+        else
+        {
+            if(racpState == RACP_STATE_REPORT)
+            {
+                BlsReportAbort();
+            }
+            RacpRespond(RACP_OP_ABORT, RACP_RSP_SUCCESS);
+        }
+    }
+    else if(racpState != RACP_STATE_IDLE)
+    {
+        gattErr = CYBLE_GATT_ERR_PROCEDURE_ALREADY_IN_PROGRESS;
+    }
+    else if((val[0u] == RACP_OP_REPORT) || (val[0u] == RACP_OP_DELETE) || (val[0u] == RACP_OP_COUNT))
+    {
+        rspCode = RacpFilter(val[1u], &val[2u], len - 2u);
+        if(rspCode == RACP_RSP_SUCCESS)
+        {
+            racpOpCode = val[0u];
+            racpState = RACP_STATE_REQUEST;
+        }
+        else
+        {
+            RacpRespond(val[0u], rspCode);
+        }
+    }
+    else
+    {
+        RacpRespond(val[0u], RACP_RSP_OP_NOT_SUPPORTED);
+    }
+    return(gattErr);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpCccdWriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles a write of the control point Client Characteristic Configuration
+*   descriptor.
+*
+* Return:
+*   CYBLE_GATT_ERR_NONE if the value is valid, otherwise the ATT error code.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T RacpCccdWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+
+    if(handleValuePair->value.len != CYBLE_CCCD_LEN)
+    {
+        gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    else if(CYBLE_IS_INDICATION_ENABLED_IN_PTR(handleValuePair->value.val))
+    {
+        printf("Record Access Control Point Indication is Enabled \r\n");
+    }
+    else
+    {
+        printf("Record Access Control Point Indication is Disabled \r\n");
+    }
+    return(gattErr);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpConnected
+********************************************************************************
+*
+* Summary:
+*   Drops the procedure of the previous connection.
+*
+*******************************************************************************/
+void RacpConnected(void)
+{
+    racpState = RACP_STATE_IDLE;
+}
+
+
+/*******************************************************************************
+* Function Name: RacpProcess
+********************************************************************************
+*
+* Summary:
+*   Executes the accepted request and indicates the response. The response
+*   shares the one outstanding indication of the connection with the record
+*   upload, so it is sent only while no record indication is pending. Called
+*   from the main loop while connected.
+*
+*******************************************************************************/
+void RacpProcess(void)
+{
+    uint32 count;
+
+    if(racpState == RACP_STATE_REQUEST)
+    {
+        count = RecordCountRange(blsUser, racpFirst, racpLast);
+        if(racpOpCode == RACP_OP_COUNT)
+        {
+            if(count > RACP_COUNT_MAX)
+            {
+                count = RACP_COUNT_MAX;
+            }
+            racpRsp[0u] = RACP_OP_COUNT_RSP;
+            racpRsp[1u] = RACP_OPR_NULL;
+            racpRsp[2u] = LO8(count);
+            racpRsp[3u] = HI8(count);
+            racpRspLen = RACP_RSP_LEN;
+            racpState = RACP_STATE_RESPONSE;
+        }
+        else if(count == 0u)
+        {
+            RacpRespond(racpOpCode, RACP_RSP_NO_RECORDS);
+        }
+        else if(racpOpCode == RACP_OP_DELETE)
+        {
+            RacpRespond(racpOpCode, (RecordDeleteRange(blsUser, racpFirst, racpLast) == CYBLE_ERROR_OK) ?
+                                    RACP_RSP_SUCCESS : RACP_RSP_NOT_COMPLETED);
+        }
+        else if(0u == (blsFlag & IND))
+        {
+            /* Records are reported as Blood Pressure Measurement indications */
+            RacpRespond(racpOpCode, RACP_RSP_NOT_COMPLETED);
+        }
+        else
+        {
+            printf("RACP report %ld records \r\n", count);
+            racpState = RACP_STATE_REPORT;
+            BlsReport(racpFirst, racpLast);
+        }
+    }
+
+#if defined(CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE)
+    if((racpState == RACP_STATE_RESPONSE) && (BlsUploadIdle() == ENABLED) &&
+       (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        CYBLE_GATTS_HANDLE_VALUE_IND_T indParam;
+
+        indParam.attrHandle = CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE;
+        indParam.value.val = racpRsp;
+        indParam.value.len = racpRspLen;
+        if(CYBLE_ERROR_OK == (apiResult = CyBle_GattsIndication(cyBle_connHandle, &indParam)))
+        {
+            racpState = RACP_STATE_CONFIRM;
+        }
+        else
+        {
+            printf("CyBle_GattsIndication API Error: %x \r\n", apiResult);
+        }
+    }
+#endif /* defined(CYBLE_RECORD_ACCESS_RACP_CHAR_HANDLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: RacpReportDone
+********************************************************************************
+*
+* Summary:
+*   Called by the record upload when the report ends.
+*
+* Parameters:
+*   rspCode - RACP_RSP_SUCCESS when the last requested record has been
+*             confirmed, RACP_RSP_NOT_COMPLETED when the report was cut short.
+*
+*******************************************************************************/
+void RacpReportDone(uint8 rspCode)
+{
+    if(racpState == RACP_STATE_REPORT)
+    {
+        RacpRespond(RACP_OP_REPORT, rspCode);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RacpConfirmed
+********************************************************************************
+*
+* Summary:
+*   Completes the procedure when the collector confirms the response.
+*
+*******************************************************************************/
+void RacpConfirmed(void)
+{
+    if(racpState == RACP_STATE_CONFIRM)
+    {
+        racpState = RACP_STATE_IDLE;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RacpBusy
+********************************************************************************
+*
+* Summary:
+*   Checks whether a response waits to be indicated or confirmed. The record
+*   upload holds back live records until then.
+*
+*******************************************************************************/
+uint8 RacpBusy(void)
+{
+    return(((racpState == RACP_STATE_RESPONSE) || (racpState == RACP_STATE_CONFIRM)) ? ENABLED : DISABLED);
+}
+
+
+/* [] END OF FILE */
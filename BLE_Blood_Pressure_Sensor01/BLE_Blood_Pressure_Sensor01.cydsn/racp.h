@@ -0,0 +1,79 @@
+/*******************************************************************************
+* File Name: racp.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the record access
+*  control point.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RACP_H)
+#define RACP_H
+
+#include "blss.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+
+/* Op Codes, the Record Access Control Point values of the Glucose profile */
+#define RACP_OP_REPORT              (0x01u)     /* Report stored records */
+#define RACP_OP_DELETE              (0x02u)     /* Delete stored records */
+#define RACP_OP_ABORT               (0x03u)     /* Abort operation */
+#define RACP_OP_COUNT               (0x04u)     /* Report number of stored records */
+#define RACP_OP_COUNT_RSP           (0x05u)     /* Number of stored records response */
+#define RACP_OP_RSP                 (0x06u)     /* Response code */
+
+/* Operators */
+#define RACP_OPR_NULL               (0x00u)
+#define RACP_OPR_ALL                (0x01u)     /* All records */
+#define RACP_OPR_LE                 (0x02u)     /* Less than or equal to */
+#define RACP_OPR_GE                 (0x03u)     /* Greater than or equal to */
+#define RACP_OPR_RANGE              (0x04u)     /* Within range of, inclusive */
+
+/* Filter types of the operands */
+#define RACP_FILTER_SEQ             (0x01u)     /* Sequence number, uint32 */
+#define RACP_FILTER_TIME            (0x02u)     /* Time stamp, Date Time format */
+
+/* Response code values */
+#define RACP_RSP_SUCCESS            (0x01u)
+#define RACP_RSP_OP_NOT_SUPPORTED   (0x02u)
+#define RACP_RSP_INVALID_OPERATOR   (0x03u)
+#define RACP_RSP_OPR_NOT_SUPPORTED  (0x04u)
+#define RACP_RSP_INVALID_OPERAND    (0x05u)
+#define RACP_RSP_NO_RECORDS         (0x06u)
+#define RACP_RSP_ABORT_FAILED       (0x07u)
+#define RACP_RSP_NOT_COMPLETED      (0x08u)
+#define RACP_RSP_FILTER_NOT_SUPPORTED (0x09u)
+
+#define RACP_SEQ_LEN                (4u)
+#define RACP_RSP_LEN                (4u)
+#define RACP_COUNT_MAX              (0xFFFFu)   /* The count response is a uint16 */
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+CYBLE_GATT_ERR_CODE_T RacpWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair);
+CYBLE_GATT_ERR_CODE_T RacpCccdWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair);
+void RacpConnected(void);
+void RacpProcess(void);
+void RacpReportDone(uint8 rspCode);
+void RacpConfirmed(void);
+uint8 RacpBusy(void);
+
+
+#endif /* RACP_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,56 @@
+/*******************************************************************************
+* File Name: ramfunc.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the annotation that places a function in SRAM.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RAMFUNC_H)
+#define RAMFUNC_H
+
+#include <cytypes.h>
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#if !defined(RAMFUNC_ENABLE)
+    #define RAMFUNC_ENABLE          (1)     /* Set to 0 to run the RAMFUNC kernels from flash */
+#endif /* !defined(RAMFUNC_ENABLE) */
+
+
+/***************************************
+*          Constants
+***************************************/
+
+/* Runs a hot kernel from SRAM, without the flash wait state of a 48 MHz
+*  SYSCLK. The generated cm0gcc.ld links the .ram input sections into .data,
+*  which Start_c() copies from flash at start-up; long_call reaches SRAM
+*  from the flash code. The annotation goes on the prototype as well as on
+*  the definition. A RAMFUNC takes its size in SRAM as well as in flash;
+*  the linker map lists it under *(.ram) in .data. Annotate only functions
+*  that the configuration links in and runs often.
+*/
+#if (RAMFUNC_ENABLE != 0) && defined(__GNUC__) && defined(__arm__)
+    #define RAMFUNC                 __attribute__((section(".ram"), long_call))
+#elif (RAMFUNC_ENABLE != 0) && defined(__ICCARM__)
+    #define RAMFUNC                 __ramfunc
+#else
+    #define RAMFUNC
+#endif /* (RAMFUNC_ENABLE != 0) && defined(__GNUC__) && defined(__arm__) */
+
+
+#endif /* RAMFUNC_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,1097 @@
+/*******************************************************************************
+* File Name: record.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the measurement record store. Every user has a
+*  separate partition of flash rows, so storing or reading the records of a
+*  user never touches the records of another user. The user is selected by
+*  the bond slot of the connected peer, the same index the BLE component
+*  uses for the per-bond CCCD storage.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "record.h"
+#include "energy.h"
+#include "rtc.h"
+
+
+/* User partitions, each row starting on a flash row */
+#if defined(__GNUC__) || defined(__ARMCC_VERSION)
+const uint8 recFlash[REC_USERS][REC_ROWS_PER_USER][CY_FLASH_SIZEOF_ROW] CYBLE_FLASH_ROW_ALIGNED = {{{0u}}};
+#elif defined(__ICCARM__)
+#pragma data_alignment=CY_FLASH_SIZEOF_ROW
+const uint8 recFlash[REC_USERS][REC_ROWS_PER_USER][CY_FLASH_SIZEOF_ROW] = {{{0u}}};
+#endif /* defined(__GNUC__) || defined(__ARMCC_VERSION) */
+
+/* Acknowledged sequence numbers, one row for all users */
+#if defined(__GNUC__) || defined(__ARMCC_VERSION)
+const uint8 recAckFlash[CY_FLASH_SIZEOF_ROW] CYBLE_FLASH_ROW_ALIGNED = {0u};
+#elif defined(__ICCARM__)
+#pragma data_alignment=CY_FLASH_SIZEOF_ROW
+const uint8 recAckFlash[CY_FLASH_SIZEOF_ROW] = {0u};
+#endif /* defined(__GNUC__) || defined(__ARMCC_VERSION) */
+
+static REC_PART_T recPart[REC_USERS];
+static REC_ACK_T recAck;
+static uint8 recAckDirty;                       /* recAck differs from flash */
+
+
+/*******************************************************************************
+* Function Name: RecordRow
+********************************************************************************
+*
+* Summary:
+*   Returns the flash row that holds the row sequence number.
+*
+*******************************************************************************/
+static const REC_ROW_T *RecordRow(uint8 user, uint32 rowSeq)
+{
+    return((const REC_ROW_T *)recFlash[user][rowSeq & REC_ROWS_MASK]);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordOldest
+********************************************************************************
+*
+* Summary:
+*   Returns the sequence number of the oldest valid row of the partition.
+*
+*******************************************************************************/
+static uint32 RecordOldest(uint8 user)
+{
+    return(recPart[user].headSeq - recPart[user].rows + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordPutVar
+********************************************************************************
+*
+* Summary:
+*   Writes the value as a varint: 7 bits per byte, least significant first,
+*   with the top bit set on all but the last byte.
+*
+* Return:
+*   Number of bytes written.
+*
+*******************************************************************************/
+static uint8 RecordPutVar(uint8 *buf, uint32 val)
+{
+    uint8 len = 0u;
+
+    while(val >= 0x80u)
+    {
+        buf[len] = (uint8)(val | 0x80u);
+        val >>= 7u;
+        len++;
+    }
+    buf[len] = (uint8)val;
+    return(len + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordGetVar
+********************************************************************************
+*
+* Summary:
+*   Reads a varint and advances the position past it.
+*
+*******************************************************************************/
+static uint32 RecordGetVar(const uint8 *buf, uint8 *pos)
+{
+    uint32 val = 0u;
+    uint8 shift = 0u;
+    uint8 byte;
+
+    do
+    {
+        byte = buf[*pos];
+        (*pos)++;
+        val |= (uint32)(byte & 0x7Fu) << shift;
+        shift += 7u;
+    }
+    while((byte & 0x80u) != 0u);
+    return(val);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordPutDiff
+********************************************************************************
+*
+* Summary:
+*   Writes the 16-bit difference of a field as a zigzag varint, so a small
+*   difference of either sign takes one byte.
+*
+*******************************************************************************/
+static uint8 RecordPutDiff(uint8 *buf, uint16 val, uint16 prev)
+{
+    uint16 diff = (uint16)(val - prev);
+
+    return(RecordPutVar(buf, (uint16)((uint16)(diff << 1u) ^ (((diff & 0x8000u) != 0u) ? 0xFFFFu : 0u))));
+}
+
+
+/*******************************************************************************
+* Function Name: RecordGetDiff
+********************************************************************************
+*
+* Summary:
+*   Reads a zigzag varint difference and applies it to the field.
+*
+*******************************************************************************/
+static uint16 RecordGetDiff(const uint8 *buf, uint8 *pos, uint16 prev)
+{
+    uint16 zigzag = (uint16)RecordGetVar(buf, pos);
+
+    return((uint16)(prev + ((zigzag >> 1u) ^ (((zigzag & 1u) != 0u) ? 0xFFFFu : 0u))));
+}
+
+
+/*******************************************************************************
+* Function Name: RecordPutTime / RecordGetTime
+********************************************************************************
+*
+* Summary:
+*   Writes or reads a time stamp in the 7-byte Date Time format.
+*
+*******************************************************************************/
+static void RecordPutTime(uint8 *buf, const CYBLE_DATE_TIME_T *time)
+{
+    buf[0u] = LO8(time->year);
+    buf[1u] = HI8(time->year);
+    buf[2u] = time->month;
+    buf[3u] = time->day;
+    buf[4u] = time->hours;
+    buf[5u] = time->minutes;
+    buf[6u] = time->seconds;
+}
+
+static void RecordGetTime(const uint8 *buf, CYBLE_DATE_TIME_T *time)
+{
+    time->year = (uint16)buf[0u] | ((uint16)buf[1u] << 8u);
+    time->month = buf[2u];
+    time->day = buf[3u];
+    time->hours = buf[4u];
+    time->minutes = buf[5u];
+    time->seconds = buf[6u];
+}
+
+
+/*******************************************************************************
+* Function Name: RecordEncode
+********************************************************************************
+*
+* Summary:
+*   Encodes the record as a keyframe, or as its differences to the previous
+*   record. Fields that did not change are left out; the time stamp is
+*   stored as the seconds since the previous record unless the clock went
+*   back.
+*
+* Parameters:
+*   buf - receives the encoded record, REC_DELTA_MAX bytes.
+*   prev - the previous record of the row, 0 for a keyframe.
+*   rec - the record to encode.
+*
+* Return:
+*   Number of bytes written.
+*
+*******************************************************************************/
+static uint8 RecordEncode(uint8 *buf, const CYBLE_BLS_BPM_T *prev, const CYBLE_BLS_BPM_T *rec)
+{
+    uint8 len;
+    uint8 ctrl = 0u;
+
+    if(prev == 0)
+    {
+        buf[0u] = rec->flags;
+        buf[1u] = LO8(rec->sys);
+        buf[2u] = HI8(rec->sys);
+        buf[3u] = LO8(rec->dia);
+        buf[4u] = HI8(rec->dia);
+        buf[5u] = LO8(rec->map);
+        buf[6u] = HI8(rec->map);
+        RecordPutTime(&buf[7u], &rec->time);
+        buf[14u] = LO8(rec->prt);
+        buf[15u] = HI8(rec->prt);
+        buf[16u] = LO8(rec->mst);
+        buf[17u] = HI8(rec->mst);
+        len = REC_KEY_SIZE;
+    }
+    else
+    {
+        len = 1u;
+        if(rec->flags != prev->flags)
+        {
+            ctrl |= REC_D_FLAGS;
+            buf[len] = rec->flags;
+            len++;
+        }
+        if(rec->sys != prev->sys)
+        {
+            ctrl |= REC_D_SYS;
+            len += RecordPutDiff(&buf[len], rec->sys, prev->sys);
+        }
+        if(rec->dia != prev->dia)
+        {
+            ctrl |= REC_D_DIA;
+            len += RecordPutDiff(&buf[len], rec->dia, prev->dia);
+        }
+        if(rec->map != prev->map)
+        {
+            ctrl |= REC_D_MAP;
+            len += RecordPutDiff(&buf[len], rec->map, prev->map);
+        }
+        if(rec->prt != prev->prt)
+        {
+            ctrl |= REC_D_PRT;
+            len += RecordPutDiff(&buf[len], rec->prt, prev->prt);
+        }
+        if(rec->mst != prev->mst)
+        {
+            ctrl |= REC_D_MST;
+            buf[len] = LO8(rec->mst);
+            buf[len + 1u] = HI8(rec->mst);
+            len += 2u;
+        }
+        if(RtcCompare(&rec->time, &prev->time) == CYBLE_TIME_LESS)
+        {
+            ctrl |= REC_D_TIME_FULL;
+            RecordPutTime(&buf[len], &rec->time);
+            len += RTC_DATE_TIME_LEN;
+        }
+        else if(RtcCompare(&rec->time, &prev->time) == CYBLE_TIME_GREAT)
+        {
+            ctrl |= REC_D_TIME;
+            len += RecordPutVar(&buf[len], RtcToEpoch(&rec->time) - RtcToEpoch(&prev->time));
+        }
+        else
+        {
+            /* Same time stamp, nothing to store */
+        }
+        buf[0u] = ctrl;
+    }
+    return(len);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordDecode
+********************************************************************************
+*
+* Summary:
+*   Decodes the record at the data position of the row.
+*
+* Parameters:
+*   row - the row.
+*   pos - position of the record in the row data, advanced past it.
+*   rec - the previous record of the row on entry unless the position is 0,
+*         receives the record.
+*
+*******************************************************************************/
+static void RecordDecode(const REC_ROW_T *row, uint8 *pos, CYBLE_BLS_BPM_T *rec)
+{
+    const uint8 *buf = row->data;
+    uint8 ctrl;
+
+    if(*pos == 0u)
+    {
+        rec->flags = buf[0u];
+        rec->sys = (uint16)buf[1u] | ((uint16)buf[2u] << 8u);
+        rec->dia = (uint16)buf[3u] | ((uint16)buf[4u] << 8u);
+        rec->map = (uint16)buf[5u] | ((uint16)buf[6u] << 8u);
+        RecordGetTime(&buf[7u], &rec->time);
+        rec->prt = (uint16)buf[14u] | ((uint16)buf[15u] << 8u);
+        rec->mst = (uint16)buf[16u] | ((uint16)buf[17u] << 8u);
+        *pos = REC_KEY_SIZE;
+    }
+    else
+    {
+        ctrl = buf[*pos];
+        (*pos)++;
+        if((ctrl & REC_D_FLAGS) != 0u)
+        {
+            rec->flags = buf[*pos];
+            (*pos)++;
+        }
+        if((ctrl & REC_D_SYS) != 0u)
+        {
+            rec->sys = RecordGetDiff(buf, pos, rec->sys);
+        }
+        if((ctrl & REC_D_DIA) != 0u)
+        {
+            rec->dia = RecordGetDiff(buf, pos, rec->dia);
+        }
+        if((ctrl & REC_D_MAP) != 0u)
+        {
+            rec->map = RecordGetDiff(buf, pos, rec->map);
+        }
+        if((ctrl & REC_D_PRT) != 0u)
+        {
+            rec->prt = RecordGetDiff(buf, pos, rec->prt);
+        }
+        if((ctrl & REC_D_MST) != 0u)
+        {
+            rec->mst = (uint16)buf[*pos] | ((uint16)buf[*pos + 1u] << 8u);
+            *pos += 2u;
+        }
+        if((ctrl & REC_D_TIME_FULL) != 0u)
+        {
+            RecordGetTime(&buf[*pos], &rec->time);
+            *pos += RTC_DATE_TIME_LEN;
+        }
+        else if((ctrl & REC_D_TIME) != 0u)
+        {
+            RtcAddSeconds(&rec->time, RecordGetVar(buf, pos));
+        }
+        else
+        {
+            /* Same time stamp as the previous record */
+        }
+    }
+    rec->uid = row->uid;
+}
+
+
+/*******************************************************************************
+* Function Name: RecordDecodeAt
+********************************************************************************
+*
+* Summary:
+*   Decodes the record with the index in the row by applying the deltas from
+*   the keyframe on. A row holds at most REC_PER_ROW records, so this is a
+*   short loop of byte reads.
+*
+* Return:
+*   Position of the record following it in the row data.
+*
+*******************************************************************************/
+static uint8 RecordDecodeAt(const REC_ROW_T *row, uint8 idx, CYBLE_BLS_BPM_T *rec)
+{
+    uint8 pos = 0u;
+    uint8 i;
+
+    for(i = 0u; i <= idx; i++)
+    {
+        RecordDecode(row, &pos, rec);
+    }
+    return(pos);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordInit
+********************************************************************************
+*
+* Summary:
+*   Rebuilds the partition state from flash. The newest row is the valid row
+*   with the highest sequence number; the rows of the last lap before it are
+*   valid as well. An acknowledged sequence number beyond the newest record
+*   is cut back, so records stored later are not taken as acknowledged.
+*
+*******************************************************************************/
+void RecordInit(void)
+{
+    const REC_ACK_T *ack = (const REC_ACK_T *)recAckFlash;
+    const REC_ROW_T *row;
+    REC_PART_T *part;
+    uint8 user;
+    uint8 i;
+
+    for(user = 0u; user < REC_USERS; user++)
+    {
+        part = &recPart[user];
+        part->headSeq = 0u;
+        part->rows = 0u;
+
+        for(i = 0u; i < REC_ROWS_PER_USER; i++)
+        {
+            row = (const REC_ROW_T *)recFlash[user][i];
+            if((row->magic == REC_ROW_MAGIC) && (row->count != 0u) && (row->count <= REC_PER_ROW) &&
+               (row->used <= REC_ROW_DATA_SIZE) && ((row->rowSeq & REC_ROWS_MASK) == i) &&
+               (row->rowSeq > part->headSeq))
+            {
+                part->headSeq = row->rowSeq;
+            }
+        }
+
+        for(i = 0u; i < REC_ROWS_PER_USER; i++)
+        {
+            row = (const REC_ROW_T *)recFlash[user][i];
+            if((row->magic == REC_ROW_MAGIC) && (row->rowSeq <= part->headSeq) &&
+               ((row->rowSeq + REC_ROWS_PER_USER) > part->headSeq))
+            {
+                part->rows++;
+            }
+        }
+    }
+
+    (void)memset(&recAck, 0, sizeof(recAck));
+    recAck.magic = REC_ACK_MAGIC;
+    recAckDirty = DISABLED;
+    for(user = 0u; user < REC_USERS; user++)
+    {
+        /* Volatile reads: the row is const data of this file, which the compiler folds to its initializer */
+        if(CY_GET_REG16(&ack->magic) == REC_ACK_MAGIC)
+        {
+            recAck.acked[user] = CY_GET_REG32(&ack->acked[user]);
+        }
+        if(recAck.acked[user] > RecordLastSeq(user))
+        {
+            recAck.acked[user] = RecordLastSeq(user);
+            recAckDirty = ENABLED;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecordUserOf
+********************************************************************************
+*
+* Summary:
+*   Returns the user partition of the peer. The stack hands out device
+*   handles to peers that never pair as well, so a handle selects a
+*   partition only while the peer's address is in the bonded device list.
+*   Every other peer, and every peer of a build without bonding, shares the
+*   guest partition. A peer that bonds during the connection gets its own
+*   partition from the next connection on.
+*
+* Parameters:
+*   bdHandle - peer device handle, cyBle_connHandle.bdHandle.
+*
+*******************************************************************************/
+uint8 RecordUserOf(uint8 bdHandle)
+{
+    uint8 user = REC_USER_GUEST;
+#if (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES)
+    CYBLE_GAP_BONDED_DEV_ADDR_LIST_T bondedList;
+    CYBLE_GAP_BD_ADDR_T peerAddr;
+    uint8 i;
+
+    if((bdHandle < CYBLE_GAP_MAX_BONDED_DEVICE) &&
+       (CyBle_GapGetPeerBdAddr(bdHandle, &peerAddr) == CYBLE_ERROR_OK) &&
+       (CyBle_GapGetBondedDevicesList(&bondedList) == CYBLE_ERROR_OK))
+    {
+        for(i = 0u; (i < bondedList.count) && (i < CYBLE_GAP_MAX_BONDED_DEVICE); i++)
+        {
+            if((bondedList.bdAddrList[i].type == peerAddr.type) &&
+               (memcmp(bondedList.bdAddrList[i].bdAddr, peerAddr.bdAddr, CYBLE_GAP_BD_ADDR_SIZE) == 0))
+            {
+                user = bdHandle;
+            }
+        }
+    }
+#endif /* (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES) */
+    return(user);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordUid
+********************************************************************************
+*
+* Summary:
+*   Returns the BLS User ID of the user partition.
+*
+*******************************************************************************/
+uint8 RecordUid(uint8 user)
+{
+    return((user < REC_USER_GUEST) ? (uint8)(user + 1u) : REC_UID_UNKNOWN);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordAppend
+********************************************************************************
+*
+* Summary:
+*   Stores the record in the partition of the user. The record is added to
+*   the newest row as a delta if it fits, or starts a new row with a keyframe
+*   that replaces the oldest row. The record sequence number continues from
+*   the newest row, so it survives resets and keeps increasing when old rows
+*   are overwritten.
+*
+* Parameters:
+*   user - user partition.
+*   record - the measurement; its User ID is set to the one of the user.
+*
+* Return:
+*   CYBLE_ERROR_OK on success or the CyBle_StoreAppData() error.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T RecordAppend(uint8 user, CYBLE_BLS_BPM_T *record)
+{
+    REC_PART_T *part = &recPart[user];
+    REC_ROW_T row;
+    CYBLE_BLS_BPM_T prev;
+    uint8 buf[REC_DELTA_MAX];
+    uint8 len = 0u;
+    CYBLE_API_RESULT_T apiResult;
+
+    record->uid = RecordUid(user);
+
+    if(part->headSeq != 0u)
+    {
+        (void)memcpy(&row, RecordRow(user, part->headSeq), sizeof(row));
+        if(row.count < REC_PER_ROW)
+        {
+            (void)RecordDecodeAt(&row, row.count - 1u, &prev);
+            len = RecordEncode(buf, &prev, record);
+            if((row.used + len) > REC_ROW_DATA_SIZE)
+            {
+                len = 0u;
+            }
+        }
+    }
+
+    if(len == 0u)
+    {
+        (void)memset(&row, 0, sizeof(row));
+        row.magic = REC_ROW_MAGIC;
+        row.uid = RecordUid(user);
+        row.rowSeq = part->headSeq + 1u;
+        row.firstSeq = RecordLastSeq(user) + 1u;
+        len = RecordEncode(buf, 0, record);
+    }
+
+    (void)memcpy(&row.data[row.used], buf, len);
+    row.used += len;
+    row.lastTime = record->time;
+    row.count++;
+
+    EnergySubsystemStart(ENERGY_SUB_FLASH);
+    do
+    {
+        CyBle_ProcessEvents();
+        apiResult = CyBle_StoreAppData((uint8 *)&row, (const uint8 *)RecordRow(user, row.rowSeq), sizeof(row), 0u);
+    }
+    while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+    EnergySubsystemStop(ENERGY_SUB_FLASH);
+
+    if(apiResult == CYBLE_ERROR_OK)
+    {
+        if(row.rowSeq != part->headSeq)
+        {
+            part->headSeq = row.rowSeq;
+            if(part->rows < REC_ROWS_PER_USER)
+            {
+                part->rows++;
+            }
+        }
+    }
+    else
+    {
+        printf("Record store API Error: %x \r\n", apiResult);
+    }
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordFirstSeq
+********************************************************************************
+*
+* Summary:
+*   Returns the sequence number of the oldest stored record, or 1 if the
+*   partition is empty.
+*
+*******************************************************************************/
+uint32 RecordFirstSeq(uint8 user)
+{
+    uint32 seq = 1u;
+
+    if(recPart[user].rows != 0u)
+    {
+        seq = RecordRow(user, RecordOldest(user))->firstSeq;
+    }
+    return(seq);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordLastSeq
+********************************************************************************
+*
+* Summary:
+*   Returns the sequence number of the newest stored record, or 0 if the
+*   partition is empty.
+*
+*******************************************************************************/
+uint32 RecordLastSeq(uint8 user)
+{
+    uint32 seq = 0u;
+    const REC_ROW_T *row;
+
+    if(recPart[user].rows != 0u)
+    {
+        row = RecordRow(user, recPart[user].headSeq);
+        seq = row->firstSeq + row->count - 1u;
+    }
+    return(seq);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordFindRow
+********************************************************************************
+*
+* Summary:
+*   Binary search over the row headers for the oldest row whose last record
+*   has a sequence number of at least seq. The partition must not be empty.
+*
+* Return:
+*   Row sequence number; the newest row if all records are older than seq.
+*
+*******************************************************************************/
+static uint32 RecordFindRow(uint8 user, uint32 seq)
+{
+    uint32 lo = RecordOldest(user);
+    uint32 hi = recPart[user].headSeq;
+    uint32 mid;
+    const REC_ROW_T *row;
+
+    while(lo < hi)
+    {
+        mid = lo + ((hi - lo) >> 1u);
+        row = RecordRow(user, mid);
+        if((row->firstSeq + row->count - 1u) < seq)
+        {
+            lo = mid + 1u;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return(lo);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordSeqAtTime
+********************************************************************************
+*
+* Summary:
+*   Finds the oldest record stamped at or after the time. The rows are
+*   searched by the stamps of their last record kept in the row header, then
+*   the one row found is decoded. Time stamps are assumed not to decrease; after the clock is
+*   set back the result is approximate.
+*
+* Parameters:
+*   user - user partition.
+*   time - the time to look for.
+*   after - ENABLED to skip records stamped exactly at the time.
+*
+* Return:
+*   Record sequence number, or the last sequence number + 1 if all records
+*   are older.
+*
+*******************************************************************************/
+uint32 RecordSeqAtTime(uint8 user, const CYBLE_DATE_TIME_T *time, uint8 after)
+{
+    uint32 seq = RecordLastSeq(user) + 1u;
+    uint32 lo;
+    uint32 hi;
+    uint32 mid;
+    uint8 i;
+    uint8 pos = 0u;
+    CYBLE_BLS_BPM_T rec;
+    CYBLE_DATE_TIME_COMP_T comp;
+    const REC_ROW_T *row;
+
+    if(recPart[user].rows != 0u)
+    {
+        lo = RecordOldest(user);
+        hi = recPart[user].headSeq;
+        while(lo < hi)
+        {
+            mid = lo + ((hi - lo) >> 1u);
+            row = RecordRow(user, mid);
+            comp = RtcCompare(&row->lastTime, time);
+            if((comp == CYBLE_TIME_LESS) || ((comp == CYBLE_TIME_EQUAL) && (after == ENABLED)))
+            {
+                lo = mid + 1u;
+            }
+            else
+            {
+                hi = mid;
+            }
+        }
+
+        row = RecordRow(user, lo);
+        for(i = 0u; i < row->count; i++)
+        {
+            RecordDecode(row, &pos, &rec);
+            comp = RtcCompare(&rec.time, time);
+            if((comp == CYBLE_TIME_GREAT) || ((comp == CYBLE_TIME_EQUAL) && (after == DISABLED)))
+            {
+                seq = row->firstSeq + i;
+                break;
+            }
+        }
+    }
+    return(seq);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordRangeMask
+********************************************************************************
+*
+* Summary:
+*   Returns the bitmask of the records of the row within the sequence range.
+*
+*******************************************************************************/
+static uint16 RecordRangeMask(const REC_ROW_T *row, uint32 first, uint32 last)
+{
+    uint16 mask = 0u;
+    uint8 i;
+
+    for(i = 0u; i < row->count; i++)
+    {
+        if(((row->firstSeq + i) >= first) && ((row->firstSeq + i) <= last))
+        {
+            mask |= (uint16)(1u << i);
+        }
+    }
+    return(mask);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordCountRange
+********************************************************************************
+*
+* Summary:
+*   Returns the number of records within the sequence range that are not
+*   deleted. Only the rows overlapping the range are visited.
+*
+*******************************************************************************/
+uint32 RecordCountRange(uint8 user, uint32 first, uint32 last)
+{
+    uint32 count = 0u;
+    uint32 rowSeq;
+    uint16 mask;
+    const REC_ROW_T *row;
+
+    if((recPart[user].rows != 0u) && (first <= last))
+    {
+        for(rowSeq = RecordFindRow(user, first); rowSeq <= recPart[user].headSeq; rowSeq++)
+        {
+            row = RecordRow(user, rowSeq);
+            if(row->firstSeq > last)
+            {
+                break;
+            }
+            mask = RecordRangeMask(row, first, last) & (uint16)~row->deleted;
+            while(mask != 0u)
+            {
+                mask &= (uint16)(mask - 1u);
+                count++;
+            }
+        }
+    }
+    return(count);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordCount
+********************************************************************************
+*
+* Summary:
+*   Returns the number of records stored for the user.
+*
+*******************************************************************************/
+uint32 RecordCount(uint8 user)
+{
+    return(RecordCountRange(user, RecordFirstSeq(user), RecordLastSeq(user)));
+}
+
+
+/*******************************************************************************
+* Function Name: RecordDeleteRange
+********************************************************************************
+*
+* Summary:
+*   Marks the records within the sequence range as deleted. Only the headers
+*   of the affected rows are rewritten; the space is reclaimed when the ring
+*   overwrites the rows.
+*
+* Return:
+*   CYBLE_ERROR_OK on success or the CyBle_StoreAppData() error.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T RecordDeleteRange(uint8 user, uint32 first, uint32 last)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+    REC_ROW_T header;
+    const REC_ROW_T *row;
+    uint32 rowSeq;
+    uint16 mask;
+
+    if((recPart[user].rows != 0u) && (first <= last))
+    {
+        for(rowSeq = RecordFindRow(user, first);
+            (rowSeq <= recPart[user].headSeq) && (apiResult == CYBLE_ERROR_OK); rowSeq++)
+        {
+            row = RecordRow(user, rowSeq);
+            if(row->firstSeq > last)
+            {
+                break;
+            }
+            mask = RecordRangeMask(row, first, last);
+            if((mask & (uint16)~row->deleted) != 0u)
+            {
+                (void)memcpy(&header, row, REC_ROW_HDR_SIZE);
+                header.deleted |= mask;
+
+                EnergySubsystemStart(ENERGY_SUB_FLASH);
+                do
+                {
+                    CyBle_ProcessEvents();
+                    apiResult = CyBle_StoreAppData((uint8 *)&header, (const uint8 *)row, REC_ROW_HDR_SIZE, 0u);
+                }
+                while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+                EnergySubsystemStop(ENERGY_SUB_FLASH);
+            }
+        }
+    }
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordCursorInit
+********************************************************************************
+*
+* Summary:
+*   Positions the cursor at the oldest record of the user.
+*
+*******************************************************************************/
+void RecordCursorInit(REC_CURSOR_T *cursor, uint8 user)
+{
+    cursor->user = user;
+    cursor->rowSeq = RecordOldest(user);
+    cursor->idx = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: RecordCursorSeek
+********************************************************************************
+*
+* Summary:
+*   Positions the cursor at the oldest record with a sequence number of at
+*   least seq, or past the newest record if there is none.
+*
+*******************************************************************************/
+void RecordCursorSeek(REC_CURSOR_T *cursor, uint8 user, uint32 seq)
+{
+    const REC_ROW_T *row;
+
+    RecordCursorInit(cursor, user);
+    if(recPart[user].rows != 0u)
+    {
+        cursor->rowSeq = RecordFindRow(user, seq);
+        row = RecordRow(user, cursor->rowSeq);
+        if(seq > row->firstSeq)
+        {
+            cursor->idx = (seq > (row->firstSeq + row->count)) ? row->count : (uint8)(seq - row->firstSeq);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecordRead
+********************************************************************************
+*
+* Summary:
+*   Reads the record at the cursor, skipping deleted records. A cursor
+*   pointing to a row that has been overwritten in the meantime moves to the
+*   oldest record.
+*
+* Parameters:
+*   cursor - read position.
+*   record - receives the record.
+*   seq - receives the record sequence number.
+*
+* Return:
+*   ENABLED if a record was read, DISABLED at the end of the partition.
+*
+*******************************************************************************/
+uint8 RecordRead(REC_CURSOR_T *cursor, CYBLE_BLS_BPM_T *record, uint32 *seq)
+{
+    const REC_PART_T *part = &recPart[cursor->user];
+    const REC_ROW_T *row;
+    uint8 result = DISABLED;
+
+    if(part->rows != 0u)
+    {
+        if(cursor->rowSeq < RecordOldest(cursor->user))
+        {
+            cursor->rowSeq = RecordOldest(cursor->user);
+            cursor->idx = 0u;
+        }
+
+        while((result == DISABLED) && (cursor->rowSeq <= part->headSeq))
+        {
+            row = RecordRow(cursor->user, cursor->rowSeq);
+            if((row->rowSeq == cursor->rowSeq) && (cursor->idx < row->count))
+            {
+                if((row->deleted & (1u << cursor->idx)) != 0u)
+                {
+                    cursor->idx++;
+                }
+                else
+                {
+                    (void)RecordDecodeAt(row, cursor->idx, record);
+                    *seq = row->firstSeq + cursor->idx;
+                    result = ENABLED;
+                }
+            }
+            else if(cursor->rowSeq < part->headSeq)
+            {
+                cursor->rowSeq++;
+                cursor->idx = 0u;
+            }
+            else
+            {
+                /* End of the newest row, the cursor waits for the next record */
+                break;
+            }
+        }
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordNext
+********************************************************************************
+*
+* Summary:
+*   Moves the cursor past the record returned by RecordRead().
+*
+*******************************************************************************/
+void RecordNext(REC_CURSOR_T *cursor)
+{
+    cursor->idx++;
+}
+
+
+/*******************************************************************************
+* Function Name: RecordAcked
+********************************************************************************
+*
+* Summary:
+*   Returns the sequence number of the newest record the collector of the
+*   user has confirmed, 0 if none.
+*
+*******************************************************************************/
+uint32 RecordAcked(uint8 user)
+{
+    return(recAck.acked[user]);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordAck
+********************************************************************************
+*
+* Summary:
+*   Records the confirmation of the record by the collector of the user. The
+*   acknowledged sequence number only moves forward. It is kept in RAM until
+*   RecordAckStore() is called, so a confirmation costs no flash write.
+*
+*******************************************************************************/
+void RecordAck(uint8 user, uint32 seq)
+{
+    if(seq > recAck.acked[user])
+    {
+        recAck.acked[user] = seq;
+        recAckDirty = ENABLED;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RecordAckStore
+********************************************************************************
+*
+* Summary:
+*   Writes the acknowledged sequence numbers to flash if they have changed.
+*   Called from the main loop when an upload has caught up and after a
+*   disconnection, so at most the confirmations since the last catch up are
+*   lost on a reset, and those records are sent again with the same sequence
+*   numbers.
+*
+* Return:
+*   CYBLE_ERROR_OK on success or the CyBle_StoreAppData() error.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T RecordAckStore(void)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_OK;
+
+    if(recAckDirty == ENABLED)
+    {
+        EnergySubsystemStart(ENERGY_SUB_FLASH);
+        do
+        {
+            CyBle_ProcessEvents();
+            apiResult = CyBle_StoreAppData((uint8 *)&recAck, recAckFlash, sizeof(recAck), 0u);
+        }
+        while(apiResult == CYBLE_ERROR_FLASH_WRITE_NOT_PERMITED);
+        EnergySubsystemStop(ENERGY_SUB_FLASH);
+
+        if(apiResult == CYBLE_ERROR_OK)
+        {
+            recAckDirty = DISABLED;
+        }
+        else
+        {
+            printf("Record ack store API Error: %x \r\n", apiResult);
+        }
+    }
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: RecordPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the number of stored records, the sequence number range and the
+*   acknowledged sequence number per user.
+*
+*******************************************************************************/
+void RecordPrint(void)
+{
+    uint8 user;
+
+    for(user = 0u; user < REC_USERS; user++)
+    {
+        printf("User %d: %ld records, seq %ld..%ld, acked %ld \r\n", RecordUid(user), RecordCount(user),
+            RecordFirstSeq(user), RecordLastSeq(user), RecordAcked(user));
+    }
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,138 @@
+/*******************************************************************************
+* File Name: record.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the measurement record
+*  store.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RECORD_H)
+#define RECORD_H
+
+#include "blss.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#define REC_ROWS_PER_USER           (16u)       /* Flash rows per user partition, must be a power of two */
+
+
+/***************************************
+*          Constants
+***************************************/
+
+/* One partition per bond slot plus one for peers that are not bonded */
+#define REC_USERS                   (CYBLE_GAP_MAX_BONDED_DEVICE + 1u)
+#define REC_USER_GUEST              (CYBLE_GAP_MAX_BONDED_DEVICE)
+#define REC_UID_UNKNOWN             (0xFFu)     /* BLS "unknown user" */
+
+#define REC_ROWS_MASK               (REC_ROWS_PER_USER - 1u)
+#define REC_ROW_HDR_SIZE            (24u)
+#define REC_ROW_DATA_SIZE           (CY_FLASH_SIZEOF_ROW - REC_ROW_HDR_SIZE)
+#define REC_PER_ROW                 (16u)       /* Width of the deleted bitmask */
+#define REC_ROW_MAGIC               (0x5EC2u)
+#define REC_SEQ_MAX                 (0xFFFFFFFFu)
+#define REC_ACK_MAGIC               (0xAC01u)
+
+/* Encoded record sizes */
+#define REC_KEY_SIZE                (18u)       /* Keyframe, all fields but the User ID */
+#define REC_DELTA_MAX               (23u)       /* Control byte, flags, four varint differences,
+                                                *  status and a full time stamp */
+
+/* Control byte of a delta record, a set bit means the field follows */
+#define REC_D_FLAGS                 (0x01u)     /* Flags, 1 byte */
+#define REC_D_SYS                   (0x02u)     /* Systolic difference, zigzag varint */
+#define REC_D_DIA                   (0x04u)     /* Diastolic difference, zigzag varint */
+#define REC_D_MAP                   (0x08u)     /* Mean Arterial Pressure difference, zigzag varint */
+#define REC_D_PRT                   (0x10u)     /* Pulse Rate difference, zigzag varint */
+#define REC_D_MST                   (0x20u)     /* Measurement Status, 2 bytes */
+#define REC_D_TIME                  (0x40u)     /* Seconds since the previous record, varint */
+#define REC_D_TIME_FULL             (0x80u)     /* Time stamp, 7 bytes, when the clock went back */
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Flash row of a user partition. Rows are written in order and the row with
+*  sequence number n is stored at row n % REC_ROWS_PER_USER of the partition,
+*  so the partition is a ring that overwrites its oldest row. The header is
+*  the sparse index of the row: it bounds the sequence numbers and the times
+*  the row holds. The data starts with a keyframe holding the first record;
+*  each further record is stored as its differences to the previous one.
+*/
+typedef struct
+{
+    uint16 magic;
+    uint8  count;                               /* Records in the row */
+    uint8  uid;
+    uint16 deleted;                             /* Bitmask of deleted records */
+    uint8  used;                                /* Bytes of data used */
+    uint8  reserved;
+    uint32 rowSeq;                              /* Row sequence number, starts at 1 */
+    uint32 firstSeq;                            /* Record sequence number of the keyframe, starts at 1 */
+    CYBLE_DATE_TIME_T lastTime;                 /* Time stamp of the last record */
+    uint8  data[REC_ROW_DATA_SIZE];
+}REC_ROW_T;
+
+/* RAM state of a user partition, rebuilt from flash by RecordInit() */
+typedef struct
+{
+    uint32 headSeq;                             /* Newest row, 0 if the partition is empty */
+    uint8  rows;                                /* Valid rows */
+}REC_PART_T;
+
+/* Flash row with the last acknowledged record of every user */
+typedef struct
+{
+    uint16 magic;
+    uint16 reserved;
+    uint32 acked[REC_USERS];                    /* Sequence number confirmed by the collector, 0 if none */
+}REC_ACK_T;
+
+/* Read position within a user partition */
+typedef struct
+{
+    uint32 rowSeq;
+    uint8  user;
+    uint8  idx;
+}REC_CURSOR_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void RecordInit(void);
+uint8 RecordUserOf(uint8 bdHandle);
+uint8 RecordUid(uint8 user);
+CYBLE_API_RESULT_T RecordAppend(uint8 user, CYBLE_BLS_BPM_T *record);
+uint32 RecordCount(uint8 user);
+uint32 RecordFirstSeq(uint8 user);
+uint32 RecordLastSeq(uint8 user);
+uint32 RecordSeqAtTime(uint8 user, const CYBLE_DATE_TIME_T *time, uint8 after);
+uint32 RecordCountRange(uint8 user, uint32 first, uint32 last);
+CYBLE_API_RESULT_T RecordDeleteRange(uint8 user, uint32 first, uint32 last);
+void RecordCursorInit(REC_CURSOR_T *cursor, uint8 user);
+void RecordCursorSeek(REC_CURSOR_T *cursor, uint8 user, uint32 seq);
+uint8 RecordRead(REC_CURSOR_T *cursor, CYBLE_BLS_BPM_T *record, uint32 *seq);
+void RecordNext(REC_CURSOR_T *cursor);
+uint32 RecordAcked(uint8 user);
+void RecordAck(uint8 user, uint32 seq);
+CYBLE_API_RESULT_T RecordAckStore(void);
+void RecordPrint(void);
+
+
+#endif /* RECORD_H */
+
+/* [] END OF FILE */
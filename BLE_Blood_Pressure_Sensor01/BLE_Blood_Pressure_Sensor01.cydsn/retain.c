@@ -0,0 +1,108 @@
+/*******************************************************************************
+* File Name: retain.c
+*
+* Version 1.0
+*
+* Description:
+*  This file keeps the application state through Hibernate. Hibernate retains
+*  the SRAM but wakes up through a reset, so the snapshot lives in the
+*  .noinit section and is only trusted after a Hibernate wakeup with a valid
+*  version and CRC.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stddef.h>
+#include "retain.h"
+#include "blss.h"
+#include "calib.h"
+#include "record.h"
+
+#if defined(__ICCARM__)
+__no_init static RETAIN_T retain;
+#else
+static RETAIN_T retain __attribute__((section(".noinit")));
+#endif /* defined(__ICCARM__) */
+
+
+/*******************************************************************************
+* Function Name: RetainSave
+********************************************************************************
+*
+* Summary:
+*   Takes the snapshot right before CySysPmHibernate(). The measurement
+*   records are in flash already; the confirmations still held in RAM are
+*   written now.
+*
+*******************************************************************************/
+void RetainSave(void)
+{
+    uint32 hibernations = retain.hibernations;
+
+    if((retain.magic != RETAIN_MAGIC) || (retain.version != RETAIN_VERSION) ||
+       (retain.crc != CalCrc16((const uint8 *)&retain, offsetof(RETAIN_T, crc))))
+    {
+        hibernations = 0u;
+    }
+
+    (void)RecordAckStore();
+
+    retain.magic = RETAIN_MAGIC;
+    retain.version = RETAIN_VERSION;
+    retain.blsSim = blsSim;
+    retain.hibernations = hibernations + 1u;
+    retain.driftPpm = rtcDriftPpm;
+    RtcGetTime(&retain.time);
+    retain.reserved = 0u;
+    EnergyGetReport(&retain.energy);
+    retain.crc = CalCrc16((const uint8 *)&retain, offsetof(RETAIN_T, crc));
+}
+
+
+/*******************************************************************************
+* Function Name: RetainRestore
+********************************************************************************
+*
+* Summary:
+*   Restores the snapshot after a Hibernate wakeup. Called once at start-up
+*   after the modules are initialized. Any other reset invalidates it, the
+*   SRAM content is undefined after a power-up.
+*
+*   The clocks stop in Hibernate, so the calendar continues from the time
+*   Hibernate was entered until a collector sets it again.
+*
+* Return:
+*   ENABLED if the state was restored.
+*
+*******************************************************************************/
+uint8 RetainRestore(void)
+{
+    uint8 result = DISABLED;
+
+    if((CySysPmGetResetReason() == CY_PM_RESET_REASON_WAKEUP_HIB) &&
+       (retain.magic == RETAIN_MAGIC) && (retain.version == RETAIN_VERSION) &&
+       (retain.crc == CalCrc16((const uint8 *)&retain, offsetof(RETAIN_T, crc))))
+    {
+        blsSim = retain.blsSim;
+        rtcDriftPpm = retain.driftPpm;
+        RtcResume(&retain.time);
+        EnergyResume(&retain.energy);
+        printf("Resumed from Hibernate %lu \r\n", retain.hibernations);
+        result = ENABLED;
+    }
+    else
+    {
+        retain.magic = 0u;
+    }
+    return(result);
+}
+
+
+/* [] END OF FILE */
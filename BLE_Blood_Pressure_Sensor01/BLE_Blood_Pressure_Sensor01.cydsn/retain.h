@@ -0,0 +1,64 @@
+/*******************************************************************************
+* File Name: retain.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the application state
+*  retained through Hibernate.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RETAIN_H)
+#define RETAIN_H
+
+#include "common.h"
+#include "energy.h"
+#include "rtc.h"
+
+
+/***************************************
+*          Constants
+***************************************/
+#define RETAIN_MAGIC                (0x4842u)
+#define RETAIN_VERSION              (1u)        /* Increment when RETAIN_T changes */
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Snapshot kept in SRAM, which Hibernate retains, outside the sections the
+*  start-up code initializes */
+typedef struct
+{
+    uint16 magic;
+    uint8  version;
+    uint8  blsSim;                              /* Measurement simulation counter */
+    uint32 hibernations;                        /* Hibernate cycles since the last cold start */
+    int32  driftPpm;                            /* Clock drift estimate */
+    CYBLE_DATE_TIME_T time;                     /* Calendar when entering Hibernate */
+    uint8  reserved;
+    ENERGY_REPORT_T energy;                     /* Residency and charge */
+    uint16 crc;                                 /* CRC-16 over all preceding fields */
+}RETAIN_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void RetainSave(void);
+uint8 RetainRestore(void);
+
+
+#endif /* RETAIN_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,458 @@
+/*******************************************************************************
+* File Name: rtc.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the calendar real-time clock. The calendar is advanced
+*  one second at a time from the WDT seconds count, so reading the time needs
+*  no division. Each time set by a collector is also a reference point: the
+*  drift of the low frequency clock is estimated against the first reference
+*  and cancelled by dropping or inserting seconds.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "rtc.h"
+
+
+int32 rtcDriftPpm = 0;                          /* Positive when the clock runs fast */
+
+static const uint8 rtcDaysInMonth[12u] = {31u, 28u, 31u, 30u, 31u, 30u, 31u, 31u, 30u, 31u, 30u, 31u};
+
+static CYBLE_DATE_TIME_T rtcTime;
+static uint32 rtcWdtSeconds;                    /* WDT second the calendar is advanced to */
+static int32 rtcDriftAcc;                       /* Accumulated drift, ppm * s */
+
+/* First reference time and the WDT time it was received at */
+static uint8 rtcAnchorValid = DISABLED;
+static uint32 rtcAnchorEpoch;
+static uint32 rtcAnchorSeconds;
+static uint32 rtcAnchorTicks;
+
+
+/*******************************************************************************
+* Function Name: RtcDaysInMonth
+********************************************************************************
+*
+* Summary:
+*   Returns the number of days in the month of the given time, or 0 for a
+*   month out of range, which the calendar rolls over to January.
+*
+*******************************************************************************/
+static uint8 RtcDaysInMonth(const CYBLE_DATE_TIME_T *time)
+{
+    uint8 days = 0u;
+
+    if((time->month >= 1u) && (time->month <= 12u))
+    {
+        days = rtcDaysInMonth[time->month - 1u];
+        if((time->month == 2u) && ((time->year & 0x03u) == 0u))
+        {
+            days++;
+        }
+    }
+    return(days);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcAddSecond
+********************************************************************************
+*
+* Summary:
+*   Advances the calendar by one second.
+*
+*******************************************************************************/
+static void RtcAddSecond(void)
+{
+    rtcTime.seconds++;
+    if(rtcTime.seconds >= 60u)
+    {
+        rtcTime.seconds = 0u;
+        rtcTime.minutes++;
+        if(rtcTime.minutes >= 60u)
+        {
+            rtcTime.minutes = 0u;
+            rtcTime.hours++;
+            if(rtcTime.hours >= 24u)
+            {
+                rtcTime.hours = 0u;
+                rtcTime.day++;
+                if(rtcTime.day > RtcDaysInMonth(&rtcTime))
+                {
+                    rtcTime.day = 1u;
+                    rtcTime.month++;
+                    if(rtcTime.month > 12u)
+                    {
+                        rtcTime.month = 1u;
+                        rtcTime.year++;
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RtcToEpoch
+********************************************************************************
+*
+* Summary:
+*   Converts the time to seconds since RTC_YEAR_MIN. Used when the clock is
+*   set and when a record is stored, never on the clock tick.
+*
+*******************************************************************************/
+uint32 RtcToEpoch(const CYBLE_DATE_TIME_T *time)
+{
+    CYBLE_DATE_TIME_T date = *time;
+    uint32 days = time->day - 1u;
+    uint16 year;
+
+    for(year = RTC_YEAR_MIN; year < time->year; year++)
+    {
+        days += ((year & 0x03u) == 0u) ? 366u : 365u;
+    }
+    for(date.month = 1u; date.month < time->month; date.month++)
+    {
+        days += RtcDaysInMonth(&date);
+    }
+
+    return((((days * 24u) + time->hours) * 60u + time->minutes) * 60u + time->seconds);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcAddSeconds
+********************************************************************************
+*
+* Summary:
+*   Advances the time by a number of seconds. The days are carried month by
+*   month, so a short interval costs a few divisions and no year loop.
+*
+* Parameters:
+*   time - the time to advance.
+*   seconds - the interval.
+*
+*******************************************************************************/
+void RtcAddSeconds(CYBLE_DATE_TIME_T *time, uint32 seconds)
+{
+    uint32 days = seconds / RTC_SECONDS_PER_DAY;
+    uint32 daySeconds = (seconds - (days * RTC_SECONDS_PER_DAY)) +
+        (((uint32)time->hours * 60u) + time->minutes) * 60u + time->seconds;
+    uint8 daysInMonth;
+
+    if(daySeconds >= RTC_SECONDS_PER_DAY)
+    {
+        daySeconds -= RTC_SECONDS_PER_DAY;
+        days++;
+    }
+    time->hours = (uint8)(daySeconds / 3600u);
+    daySeconds -= (uint32)time->hours * 3600u;
+    time->minutes = (uint8)(daySeconds / 60u);
+    time->seconds = (uint8)(daySeconds - ((uint32)time->minutes * 60u));
+
+    days += time->day;
+    daysInMonth = RtcDaysInMonth(time);
+    while(days > daysInMonth)
+    {
+        days -= daysInMonth;
+        time->month++;
+        if(time->month > 12u)
+        {
+            time->month = 1u;
+            time->year++;
+        }
+        daysInMonth = RtcDaysInMonth(time);
+    }
+    time->day = (uint8)days;
+}
+
+
+/*******************************************************************************
+* Function Name: RtcInit
+********************************************************************************
+*
+* Summary:
+*   Starts the clock at the default time. Must be called after WDT_Start().
+*
+*******************************************************************************/
+void RtcInit(void)
+{
+    uint32 ticks;
+
+    rtcTime.year = RTC_DEFAULT_YEAR;
+    rtcTime.month = RTC_DEFAULT_MONTH;
+    rtcTime.day = RTC_DEFAULT_DAY;
+    rtcTime.hours = 0u;
+    rtcTime.minutes = 0u;
+    rtcTime.seconds = 0u;
+    rtcWdtSeconds = WDT_ReadTime(&ticks);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcResume
+********************************************************************************
+*
+* Summary:
+*   Continues the calendar from a time saved before Hibernate. Unlike
+*   RtcSetTime() it is no reference for the drift estimate.
+*
+*******************************************************************************/
+void RtcResume(const CYBLE_DATE_TIME_T *time)
+{
+    uint32 ticks;
+
+    rtcTime = *time;
+    rtcWdtSeconds = WDT_ReadTime(&ticks);
+    rtcDriftAcc = 0;
+}
+
+
+/*******************************************************************************
+* Function Name: RtcUpdate
+********************************************************************************
+*
+* Summary:
+*   Advances the calendar to the current WDT second. Each second the drift
+*   estimate is accumulated; a whole second of drift drops a second when the
+*   clock runs fast or inserts one when it runs slow. Called on every WDT
+*   tick so the catch up is a single step.
+*
+*******************************************************************************/
+void RtcUpdate(void)
+{
+    uint32 seconds = wdtSeconds;
+
+    while(rtcWdtSeconds != seconds)
+    {
+        rtcWdtSeconds++;
+        rtcDriftAcc += rtcDriftPpm;
+        if(rtcDriftAcc >= RTC_PPM)
+        {
+            rtcDriftAcc -= RTC_PPM;
+        }
+        else
+        {
+            RtcAddSecond();
+            if(rtcDriftAcc <= -RTC_PPM)
+            {
+                rtcDriftAcc += RTC_PPM;
+                RtcAddSecond();
+            }
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: RtcGetTime
+********************************************************************************
+*
+* Summary:
+*   Returns the current time.
+*
+*******************************************************************************/
+void RtcGetTime(CYBLE_DATE_TIME_T *time)
+{
+    RtcUpdate();
+    *time = rtcTime;
+}
+
+
+/*******************************************************************************
+* Function Name: RtcSetTime
+********************************************************************************
+*
+* Summary:
+*   Sets the clock to the reference time received from a collector. When at
+*   least RTC_DRIFT_MIN_SPAN has passed since the first reference, the drift
+*   is estimated from the uncorrected WDT time elapsed over the whole span.
+*   An implausible estimate, or a reference older than the first one, is
+*   taken as a deliberate clock change and restarts the estimate.
+*
+* Parameters:
+*   time - the reference time.
+*
+* Return:
+*   ENABLED if the time was valid and set, DISABLED otherwise.
+*
+*******************************************************************************/
+uint8 RtcSetTime(const CYBLE_DATE_TIME_T *time)
+{
+    uint8 result = DISABLED;
+    uint32 epoch;
+    uint32 seconds;
+    uint32 ticks;
+    int32 span;
+    int64 refTicks;
+    int64 ppm;
+
+    if((time->year >= RTC_YEAR_MIN) && (time->year <= RTC_YEAR_MAX) &&
+       (time->month >= 1u) && (time->month <= 12u) &&
+       (time->day >= 1u) && (time->day <= RtcDaysInMonth(time)) &&
+       (time->hours < 24u) && (time->minutes < 60u) && (time->seconds < 60u))
+    {
+        epoch = RtcToEpoch(time);
+        seconds = WDT_ReadTime(&ticks);
+
+        if(rtcAnchorValid == ENABLED)
+        {
+            span = (int32)(epoch - rtcAnchorEpoch);
+            if(span < 0)
+            {
+                rtcAnchorValid = DISABLED;
+            }
+            else if(span >= RTC_DRIFT_MIN_SPAN)
+            {
+                /* Rounded, a truncated estimate is biased by up to 1 ppm, 2.6 s a month */
+                refTicks = (int64)span << WDT_TICKS_SHIFT;
+                ppm = (((int64)(seconds - rtcAnchorSeconds) << WDT_TICKS_SHIFT) +
+                       (int64)ticks - (int64)rtcAnchorTicks - refTicks) * RTC_PPM;
+                ppm = (ppm + ((ppm < 0) ? -(refTicks >> 1) : (refTicks >> 1))) / refTicks;
+                if((ppm <= RTC_DRIFT_MAX_PPM) && (ppm >= -RTC_DRIFT_MAX_PPM))
+                {
+                    rtcDriftPpm = (int32)ppm;
+                }
+                else
+                {
+                    rtcAnchorValid = DISABLED;
+                }
+            }
+            else
+            {
+                /* Too close to the first reference for a useful estimate */
+            }
+        }
+
+        if(rtcAnchorValid == DISABLED)
+        {
+            rtcAnchorValid = ENABLED;
+            rtcAnchorEpoch = epoch;
+            rtcAnchorSeconds = seconds;
+            rtcAnchorTicks = ticks;
+        }
+
+        rtcTime = *time;
+        rtcWdtSeconds = seconds;
+        rtcDriftAcc = 0;
+        result = ENABLED;
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcWriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles a write of the Date Time characteristic by the collector.
+*
+* Parameters:
+*   handleValuePair - the written value in the Date Time characteristic
+*                     format.
+*
+* Return:
+*   CYBLE_GATT_ERR_NONE if the clock was set, otherwise the ATT error code.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T RtcWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+    CYBLE_DATE_TIME_T time;
+    const uint8 *val = handleValuePair->value.val;
+
+    if(handleValuePair->value.len != RTC_DATE_TIME_LEN)
+    {
+        gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    else
+    {
+        time.year = CyBle_Get16ByPtr(val);
+        time.month = val[2u];
+        time.day = val[3u];
+        time.hours = val[4u];
+        time.minutes = val[5u];
+        time.seconds = val[6u];
+        if(RtcSetTime(&time) == DISABLED)
+        {
+            gattErr = CYBLE_GATT_ERR_OUT_OF_RANGE;
+        }
+        else
+        {
+            RtcPrint();
+        }
+    }
+    return(gattErr);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcCompare
+********************************************************************************
+*
+* Summary:
+*   Compares two times. The date and the time of day are each packed into
+*   one word, so the comparison is two integer compares.
+*
+* Return:
+*   CYBLE_TIME_LESS if time1 is earlier than time2, CYBLE_TIME_GREAT if it
+*   is later, CYBLE_TIME_EQUAL otherwise.
+*
+*******************************************************************************/
+CYBLE_DATE_TIME_COMP_T RtcCompare(const CYBLE_DATE_TIME_T *time1, const CYBLE_DATE_TIME_T *time2)
+{
+    CYBLE_DATE_TIME_COMP_T result = CYBLE_TIME_EQUAL;
+    uint32 key1 = ((uint32)time1->year << 16u) | ((uint32)time1->month << 8u) | time1->day;
+    uint32 key2 = ((uint32)time2->year << 16u) | ((uint32)time2->month << 8u) | time2->day;
+
+    if(key1 == key2)
+    {
+        key1 = ((uint32)time1->hours << 16u) | ((uint32)time1->minutes << 8u) | time1->seconds;
+        key2 = ((uint32)time2->hours << 16u) | ((uint32)time2->minutes << 8u) | time2->seconds;
+    }
+    if(key1 < key2)
+    {
+        result = CYBLE_TIME_LESS;
+    }
+    else if(key1 > key2)
+    {
+        result = CYBLE_TIME_GREAT;
+    }
+    else
+    {
+        /* Equal */
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: RtcPrint
+********************************************************************************
+*
+* Summary:
+*   Prints the current time and the drift estimate.
+*
+*******************************************************************************/
+void RtcPrint(void)
+{
+    CYBLE_DATE_TIME_T time;
+
+    RtcGetTime(&time);
+    printf("Time: %d-%d-%d %d:%d:%d, drift %ld ppm \r\n", time.year, time.month, time.day,
+        time.hours, time.minutes, time.seconds, rtcDriftPpm);
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,70 @@
+/*******************************************************************************
+* File Name: rtc.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the calendar real-time
+*  clock.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(RTC_H)
+#define RTC_H
+
+#include "blss.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#define RTC_DRIFT_MIN_SPAN          (86400)     /* Shortest reference interval for a drift estimate, s */
+#define RTC_DRIFT_MAX_PPM           (1000)      /* Larger estimates are treated as a clock change */
+
+
+/***************************************
+*          Constants
+***************************************/
+#define RTC_YEAR_MIN                (2000u)     /* Supported range, every fourth year is a leap year */
+#define RTC_YEAR_MAX                (2099u)
+#define RTC_DEFAULT_YEAR            (2015u)     /* Time after reset until a collector sets the clock */
+#define RTC_DEFAULT_MONTH           (1u)
+#define RTC_DEFAULT_DAY             (1u)
+
+#define RTC_PPM                     (1000000)
+#define RTC_SECONDS_PER_DAY         (86400u)
+#define RTC_DATE_TIME_LEN           (7u)        /* Date Time characteristic format */
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+void RtcInit(void);
+void RtcUpdate(void);
+void RtcGetTime(CYBLE_DATE_TIME_T *time);
+uint8 RtcSetTime(const CYBLE_DATE_TIME_T *time);
+void RtcResume(const CYBLE_DATE_TIME_T *time);
+CYBLE_GATT_ERR_CODE_T RtcWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair);
+uint32 RtcToEpoch(const CYBLE_DATE_TIME_T *time);
+void RtcAddSeconds(CYBLE_DATE_TIME_T *time, uint32 seconds);
+CYBLE_DATE_TIME_COMP_T RtcCompare(const CYBLE_DATE_TIME_T *time1, const CYBLE_DATE_TIME_T *time2);
+void RtcPrint(void);
+
+
+/***************************************
+* External data references
+***************************************/
+extern int32 rtcDriftPpm;
+
+
+#endif /* RTC_H */
+
+/* [] END OF FILE */
@@ -15,7 +15,22 @@
 
 #include <project.h>
 #include <stdio.h>
+#include <string.h>
 #include "common.h"
+#include "boot.h"
+#include "retain.h"
+#include "clock.h"
+#include "record.h"
+
+static uint8 serverBdHandle = SERVER_BD_HANDLE_NONE;    /* Peer of the connection */
+
+#if (SERVER_CCCD_CACHE != 0)
+/* CCCDs of every bond slot, rows as in cyBle_attValuesCCCDFlashMemory[]. The
+*  cache holds the changes the component has not stored to flash yet. Peers
+*  that are not bonded share the last row, REC_USER_GUEST. */
+static uint8 serverCccd[CYBLE_GAP_MAX_BONDED_DEVICE + 1u][CYBLE_GATT_DB_CCCD_COUNT];
+static uint8 serverCccdRow = REC_USER_GUEST;            /* Row of the peer of the connection */
+#endif /* (SERVER_CCCD_CACHE != 0) */
 
 
 /*******************************************************************************
@@ -44,6 +59,13 @@ void StartAdvertisement(void)
     }
     else
     {
+        if(BootStamp(BOOT_STAGE_ADVERTISE) != DISABLED)
+        {
+            BootPrint();
+
+            /* The start-up runs at full speed */
+            ClockInit();
+        }
         printf("Start Advertisement with addr: ");
         CyBle_GetDeviceAddress(&localAddr);
         for(i = CYBLE_GAP_BD_ADDR_SIZE; i > 0u; i--)
@@ -54,6 +76,83 @@ void StartAdvertisement(void)
     }
 }
 
+/*******************************************************************************
+* Function Name: ServerCccdInit
+********************************************************************************
+*
+* Summary:
+*   Loads the CCCDs stored for every bond slot. Called once at startup, after
+*   that the cache is kept current from the GATT database.
+*
+*******************************************************************************/
+void ServerCccdInit(void)
+{
+#if (SERVER_CCCD_CACHE != 0)
+    (void)memcpy(serverCccd, cyBle_attValuesCCCDFlashMemory, sizeof(serverCccd));
+#endif /* (SERVER_CCCD_CACHE != 0) */
+    serverBdHandle = SERVER_BD_HANDLE_NONE;
+}
+
+
+/*******************************************************************************
+* Function Name: ServerConnected
+********************************************************************************
+*
+* Summary:
+*   Restores the CCCDs of the connected peer into the GATT database. The
+*   component loads them from flash, which misses the changes of the last
+*   connection when they were not stored before the link was lost. The
+*   service modules take over the subscriptions from the database.
+*
+*   The stack hands out device handles to peers that never pair as well, so
+*   the row of a handle is restored only while the peer's address is in the
+*   bonded device list, the match of RecordUserOf(). Every other peer starts
+*   unsubscribed from the cleared guest row.
+*
+*******************************************************************************/
+void ServerConnected(void)
+{
+    serverBdHandle = cyBle_connHandle.bdHandle;
+#if (SERVER_CCCD_CACHE != 0)
+    serverCccdRow = RecordUserOf(serverBdHandle);
+    if(serverCccdRow == REC_USER_GUEST)
+    {
+        (void)memset(serverCccd[REC_USER_GUEST], 0, CYBLE_GATT_DB_CCCD_COUNT);
+    }
+    (void)memcpy(cyBle_attValuesCCCD, serverCccd[serverCccdRow], CYBLE_GATT_DB_CCCD_COUNT);
+#endif /* (SERVER_CCCD_CACHE != 0) */
+}
+
+
+/*******************************************************************************
+* Function Name: ServerDisconnected
+********************************************************************************
+*
+* Summary:
+*   Keeps the CCCDs of the peer that disconnected for its next connection.
+*   The handle is the one saved on connect, the component clears
+*   cyBle_connHandle when GATT disconnects. A guest is looked up again, so a
+*   peer that bonded during the connection keeps its subscriptions; any
+*   other guest only writes the guest row.
+*
+*******************************************************************************/
+void ServerDisconnected(void)
+{
+#if (SERVER_CCCD_CACHE != 0)
+    if(serverBdHandle != SERVER_BD_HANDLE_NONE)
+    {
+        if(serverCccdRow == REC_USER_GUEST)
+        {
+            serverCccdRow = RecordUserOf(serverBdHandle);
+        }
+        (void)memcpy(serverCccd[serverCccdRow], cyBle_attValuesCCCD, CYBLE_GATT_DB_CCCD_COUNT);
+    }
+    serverCccdRow = REC_USER_GUEST;
+#endif /* (SERVER_CCCD_CACHE != 0) */
+    serverBdHandle = SERVER_BD_HANDLE_NONE;
+}
+
+
 /*******************************************************************************
 * Function Name: ServerDebugOut
 ********************************************************************************
@@ -81,6 +180,7 @@ void ServerDebugOut(uint32 event, void* eventParam)
                 /* Fast and slow advertising period complete, go to low power  
                  * mode (Hibernate mode) and wait for an external
                  * user event to wake up the device again */
+                RetainSave();
                 printf("Hibernate \r\n");
                 Advertising_LED_Write(LED_OFF);
                 Disconnect_LED_Write(LED_ON);
@@ -16,7 +16,23 @@
 #include <project.h>
 #include <stdio.h>
 
+/* The CCCDs are cached when the component keeps them per bond. Define
+*  SERVER_CCCD_CACHE as 0 in the build settings to leave them to the
+*  component. */
+#if !defined(SERVER_CCCD_CACHE)
+    #if((CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES) && (CYBLE_GATT_DB_CCCD_COUNT != 0u))
+        #define SERVER_CCCD_CACHE   (1)
+    #else
+        #define SERVER_CCCD_CACHE   (0)
+    #endif /* (CYBLE_BONDING_REQUIREMENT == CYBLE_BONDING_YES) && (CYBLE_GATT_DB_CCCD_COUNT != 0u) */
+#endif /* !defined(SERVER_CCCD_CACHE) */
+
+#define SERVER_BD_HANDLE_NONE       (0xFFu)     /* No peer connected */
+
 void StartAdvertisement(void);
+void ServerCccdInit(void);
+void ServerConnected(void);
+void ServerDisconnected(void);
 void ServerDebugOut(uint32 event, void* eventParam);
 
 /* [] END OF FILE */
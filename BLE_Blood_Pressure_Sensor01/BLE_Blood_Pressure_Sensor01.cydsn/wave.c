@@ -0,0 +1,385 @@
+/*******************************************************************************
+* File Name: wave.c
+*
+* Version 1.0
+*
+* Description:
+*  This file contains the raw cuff pressure waveform streaming. WDT counter 0
+*  clocks the samples: each match interrupt reads the conversion started at
+*  the previous match and starts the next one, so the interrupt never waits
+*  for the ADC. Samples are compressed into sequence numbered packets in the
+*  interrupt by the lossless codec and notified from the main loop. A packet that finds the queue
+*  full is dropped, which the collector sees as a gap in the sequence
+*  numbers.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "wave.h"
+#include "calib.h"
+#include "energy.h"
+#include "analog.h"
+
+#if (CAL_PRESSURE_ENABLE != 0u)
+
+static volatile uint8 waveRunning = DISABLED;
+static uint8 waveConverting;                    /* A conversion was started at the last match */
+
+/* Packet being filled by the interrupt */
+static uint8 waveBuild[WAVE_PKT_MAX];
+static CODEC_ENC_T waveEnc;
+static uint16 waveSeq;
+static volatile uint8 wavePktSize = CYBLE_GATT_DEFAULT_MTU - WAVE_ATT_HDR_SIZE;
+
+/* Packets produced by the interrupt and consumed by the main loop */
+static uint8 wavePkt[WAVE_PKT_QUEUE][WAVE_PKT_MAX];
+static uint8 wavePktLen[WAVE_PKT_QUEUE];
+static volatile uint8 waveHead;
+static volatile uint8 waveTail;
+
+static WAVE_STATS_T waveStats;
+static uint32 waveSamples;                      /* Samples notified */
+static uint32 waveLastSamples;
+static volatile uint32 waveOverflow;            /* Packets dropped by the interrupt, queue full */
+static uint32 waveRejected;                     /* Packets dropped by the stack */
+
+
+/*******************************************************************************
+* Function Name: WaveStart
+********************************************************************************
+*
+* Summary:
+*   Starts sampling at the rate closest to the requested one that divides
+*   the WDT clock.
+*
+* Parameters:
+*   rate - samples per second, WAVE_RATE_MIN to WAVE_RATE_MAX.
+*
+*******************************************************************************/
+void WaveStart(uint16 rate)
+{
+    uint32 period = (WAVE_CLOCK_HZ + (rate >> 1u)) / rate;
+
+    WaveStop();
+
+    waveSeq = 0u;
+    CodecStart(&waveEnc, waveBuild, wavePktSize, waveSeq, CODEC_K_INIT);
+    waveHead = 0u;
+    waveTail = 0u;
+    waveConverting = DISABLED;
+    (void)memset(&waveStats, 0, sizeof(waveStats));
+    waveStats.rate = (uint16)(WAVE_CLOCK_HZ / period);
+    waveSamples = 0u;
+    waveLastSamples = 0u;
+    waveOverflow = 0u;
+    waveRejected = 0u;
+
+    AnalogAcquire(ANALOG_USER_WAVE);
+    EnergySubsystemStart(ENERGY_SUB_ADC);
+    waveRunning = ENABLED;
+
+    CySysWdtUnlock();
+    CySysWdtWriteMode(WAVE_WDT_COUNTER, CY_SYS_WDT_MODE_INT);
+    CySysWdtWriteClearOnMatch(WAVE_WDT_COUNTER, 1u);
+    CySysWdtWriteMatch(WAVE_WDT_COUNTER, period - 1u);
+    CySysWdtResetCounters(WAVE_WDT_COUNTER_RESET);
+    CySysWdtEnable(WAVE_WDT_COUNTER_MASK);
+    CySysWdtLock();
+
+    printf("Waveform started, %d samples/s \r\n", waveStats.rate);
+}
+
+
+/*******************************************************************************
+* Function Name: WaveStop
+********************************************************************************
+*
+* Summary:
+*   Stops sampling. Packets already queued are discarded.
+*
+*******************************************************************************/
+void WaveStop(void)
+{
+    if(waveRunning == ENABLED)
+    {
+        CySysWdtUnlock();
+        CySysWdtDisable(WAVE_WDT_COUNTER_MASK);
+        CySysWdtLock();
+        CySysWdtClearInterrupt(WAVE_WDT_INTERRUPT_SOURCE);
+
+        waveRunning = DISABLED;
+        waveTail = waveHead;
+        EnergySubsystemStop(ENERGY_SUB_ADC);
+        AnalogRelease(ANALOG_USER_WAVE);
+        printf("Waveform stopped \r\n");
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WaveSetMtu
+********************************************************************************
+*
+* Summary:
+*   Sizes the packets to the notification payload of the negotiated MTU, up
+*   to the MTU configured in the BLE component. The packet being filled
+*   keeps its size; the next one starts with the new size.
+*
+* Parameters:
+*   mtu - the ATT MTU of the connection.
+*
+*******************************************************************************/
+void WaveSetMtu(uint16 mtu)
+{
+    uint16 size = mtu - WAVE_ATT_HDR_SIZE;
+
+    wavePktSize = (uint8)((size < WAVE_PKT_MAX) ? size : WAVE_PKT_MAX);
+}
+
+
+/*******************************************************************************
+* Function Name: WaveRunning
+********************************************************************************
+*
+* Summary:
+*   Checks whether the waveform is sampled. Other ADC users stay off the ADC
+*   meanwhile.
+*
+*******************************************************************************/
+uint8 WaveRunning(void)
+{
+    return(waveRunning);
+}
+
+
+/*******************************************************************************
+* Function Name: WaveSample
+********************************************************************************
+*
+* Summary:
+*   Takes one sample. Called from the WDT interrupt on the sample clock
+*   match.
+*
+*******************************************************************************/
+void WaveSample(void)
+{
+    int16 sample;
+
+    if(waveRunning == ENABLED)
+    {
+        if(waveConverting == ENABLED)
+        {
+            sample = ADC_GetResult16(ADC_PRESSURE_CHANNEL);
+            if(CodecPut(&waveEnc, sample) == 0u)
+            {
+                /* The packet is full, queue it and start the next one with the sample */
+                if((uint8)(waveHead - waveTail) < WAVE_PKT_QUEUE)
+                {
+                    /* A block the sample count ends before the MTU goes without its unused bytes */
+                    (void)memcpy(wavePkt[waveHead & WAVE_PKT_QUEUE_MASK], waveBuild, (waveEnc.bitPos + 7u) >> 3u);
+                    wavePktLen[waveHead & WAVE_PKT_QUEUE_MASK] = (uint8)((waveEnc.bitPos + 7u) >> 3u);
+
+                    /* The packet must be complete before the main loop can see it */
+                    __DMB();
+                    waveHead++;
+                }
+                else
+                {
+                    waveOverflow++;
+                }
+                waveSeq++;
+                CodecStart(&waveEnc, waveBuild, wavePktSize, waveSeq, waveEnc.k);
+                (void)CodecPut(&waveEnc, sample);
+            }
+        }
+
+        ADC_StartConvert();
+        waveConverting = ENABLED;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WaveProcess
+********************************************************************************
+*
+* Summary:
+*   Notifies the queued packets while the stack accepts them. A packet the
+*   stack rejects for another reason than a full buffer is dropped. Called
+*   from the main loop while connected.
+*
+*******************************************************************************/
+void WaveProcess(void)
+{
+#if defined(CYBLE_WAVEFORM_DATA_CHAR_HANDLE)
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T ntfParam;
+
+    while((waveTail != waveHead) && (CyBle_GattGetBusyStatus() == CYBLE_STACK_STATE_FREE))
+    {
+        ntfParam.attrHandle = CYBLE_WAVEFORM_DATA_CHAR_HANDLE;
+        ntfParam.value.val = wavePkt[waveTail & WAVE_PKT_QUEUE_MASK];
+        ntfParam.value.len = wavePktLen[waveTail & WAVE_PKT_QUEUE_MASK];
+        apiResult = CyBle_GattsNotification(cyBle_connHandle, &ntfParam);
+        if(apiResult == CYBLE_ERROR_MEMORY_ALLOCATION_FAILED)
+        {
+            /* The stack buffers are full, retry after the next connection event */
+            break;
+        }
+        if(apiResult == CYBLE_ERROR_OK)
+        {
+            waveStats.packets++;
+            waveSamples += wavePkt[waveTail & WAVE_PKT_QUEUE_MASK][CODEC_HDR_COUNT];
+        }
+        else
+        {
+            waveRejected++;
+        }
+        waveTail++;
+    }
+#else
+    waveTail = waveHead;
+#endif /* defined(CYBLE_WAVEFORM_DATA_CHAR_HANDLE) */
+}
+
+
+/*******************************************************************************
+* Function Name: WaveTick
+********************************************************************************
+*
+* Summary:
+*   Measures the throughput of the last second and publishes the statistics
+*   in the Stats characteristic. Called every second.
+*
+*******************************************************************************/
+void WaveTick(void)
+{
+    if(waveRunning == ENABLED)
+    {
+        waveStats.throughput = (uint16)(waveSamples - waveLastSamples);
+        waveLastSamples = waveSamples;
+        waveStats.dropped = waveOverflow + waveRejected;
+
+    #if defined(CYBLE_WAVEFORM_STATS_CHAR_HANDLE)
+        {
+            CYBLE_GATT_HANDLE_VALUE_PAIR_T handleValuePair;
+
+            handleValuePair.attrHandle = CYBLE_WAVEFORM_STATS_CHAR_HANDLE;
+            handleValuePair.value.val = (uint8 *)&waveStats;
+            handleValuePair.value.len = sizeof(waveStats);
+            (void)CyBle_GattsWriteAttributeValue(&handleValuePair, 0u, &cyBle_connHandle,
+                                                 CYBLE_GATT_DB_LOCALLY_INITIATED);
+        }
+    #endif /* defined(CYBLE_WAVEFORM_STATS_CHAR_HANDLE) */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: WaveWriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles a write of the Control characteristic by the collector.
+*
+* Parameters:
+*   handleValuePair - WAVE_CTRL_STOP, or WAVE_CTRL_START and the rate.
+*
+* Return:
+*   CYBLE_GATT_ERR_NONE if the request was carried out, otherwise the ATT
+*   error code.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T WaveWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+    const uint8 *val = handleValuePair->value.val;
+    uint16 rate;
+
+    if((handleValuePair->value.len == 1u) && (val[0u] == WAVE_CTRL_STOP))
+    {
+        WaveStop();
+    }
+    else if((handleValuePair->value.len == WAVE_CTRL_START_LEN) && (val[0u] == WAVE_CTRL_START))
+    {
+        rate = CyBle_Get16ByPtr(&val[1u]);
+        if((rate < WAVE_RATE_MIN) || (rate > WAVE_RATE_MAX))
+        {
+            gattErr = CYBLE_GATT_ERR_OUT_OF_RANGE;
+        }
+        else
+        {
+            WaveStart(rate);
+        }
+    }
+    else if((handleValuePair->value.len == 0u) || (val[0u] > WAVE_CTRL_START))
+    {
+        gattErr = CYBLE_GATT_ERR_REQUEST_NOT_SUPPORTED;
+    }
+    else
+    {
+        gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    return(gattErr);
+}
+
+
+/*******************************************************************************
+* Function Name: WaveCccdWriteRequest
+********************************************************************************
+*
+* Summary:
+*   Handles a write of the Data characteristic Client Characteristic
+*   Configuration descriptor. Disabling the notifications stops sampling.
+*
+* Return:
+*   CYBLE_GATT_ERR_NONE if the value is valid, otherwise the ATT error code.
+*
+*******************************************************************************/
+CYBLE_GATT_ERR_CODE_T WaveCccdWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair)
+{
+    CYBLE_GATT_ERR_CODE_T gattErr = CYBLE_GATT_ERR_NONE;
+
+    if(handleValuePair->value.len != CYBLE_CCCD_LEN)
+    {
+        gattErr = CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN;
+    }
+    else if(CYBLE_IS_NOTIFICATION_ENABLED_IN_PTR(handleValuePair->value.val))
+    {
+        printf("Waveform Notification is Enabled \r\n");
+    }
+    else
+    {
+        printf("Waveform Notification is Disabled \r\n");
+        WaveStop();
+    }
+    return(gattErr);
+}
+
+
+/*******************************************************************************
+* Function Name: WavePrint
+********************************************************************************
+*
+* Summary:
+*   Prints the streaming statistics.
+*
+*******************************************************************************/
+void WavePrint(void)
+{
+    waveStats.dropped = waveOverflow + waveRejected;
+    printf("Waveform: %d samples/s, sent %ld packets, dropped %ld, throughput %d samples/s \r\n",
+        waveStats.rate, waveStats.packets, waveStats.dropped, waveStats.throughput);
+}
+
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+/* [] END OF FILE */
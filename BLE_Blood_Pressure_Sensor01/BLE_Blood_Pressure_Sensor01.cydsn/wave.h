@@ -0,0 +1,103 @@
+/*******************************************************************************
+* File Name: wave.h
+*
+* Version 1.0
+*
+* Description:
+*  Contains the function prototypes and constants for the raw cuff pressure
+*  waveform streaming.
+*
+* Hardware Dependency:
+*  CY8CKIT-042 BLE
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(WAVE_H)
+#define WAVE_H
+
+#include "common.h"
+#include "codec.h"
+#include "calib.h"
+
+
+/***************************************
+*  Conditional Compilation Parameters
+***************************************/
+#define WAVE_WDT_COUNTER            (CY_SYS_WDT_COUNTER0)   /* Sample clock */
+#define WAVE_WDT_COUNTER_MASK       (CY_SYS_WDT_COUNTER0_MASK)
+#define WAVE_WDT_INTERRUPT_SOURCE   (CY_SYS_WDT_COUNTER0_INT)
+#define WAVE_WDT_COUNTER_RESET      (CY_SYS_WDT_COUNTER0_RESET)
+
+#define WAVE_RATE_DEFAULT           (100u)      /* Samples per second */
+#define WAVE_RATE_MIN               (1u)
+#define WAVE_RATE_MAX               (1000u)     /* Sample clock interrupt load limit */
+#define WAVE_PKT_QUEUE              (4u)        /* Packets waiting for the stack, must be a power of two */
+
+
+/***************************************
+*          Constants
+***************************************/
+#define WAVE_CLOCK_HZ               (1u << WDT_TICKS_SHIFT)
+
+/* Packet: one codec block filling the notification payload of the MTU in use */
+#define WAVE_ATT_HDR_SIZE           (3u)        /* Handle Value Notification op code and handle */
+#define WAVE_PKT_MAX                (((CYBLE_GATT_MTU - WAVE_ATT_HDR_SIZE) < CODEC_BLOCK_MAX) ? \
+                                     (CYBLE_GATT_MTU - WAVE_ATT_HDR_SIZE) : CODEC_BLOCK_MAX)
+#define WAVE_PKT_QUEUE_MASK         (WAVE_PKT_QUEUE - 1u)
+
+/* Control characteristic op codes */
+#define WAVE_CTRL_STOP              (0x00u)     /* Op code only */
+#define WAVE_CTRL_START             (0x01u)     /* Op code, rate (uint16, samples per second) */
+#define WAVE_CTRL_START_LEN         (3u)
+
+
+/***************************************
+*       Data Types
+***************************************/
+
+/* Streaming statistics, the value of the Stats characteristic */
+typedef struct
+{
+    uint32 packets;                             /* Packets notified */
+    uint32 dropped;                             /* Packets lost, seen as sequence number gaps */
+    uint16 rate;                                /* Actual sample rate, samples per second */
+    uint16 throughput;                          /* Samples notified in the last second */
+}WAVE_STATS_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+#if (CAL_PRESSURE_ENABLE != 0u)
+void WaveStart(uint16 rate);
+void WaveStop(void);
+void WaveSetMtu(uint16 mtu);
+uint8 WaveRunning(void);
+void WaveSample(void);
+void WaveProcess(void);
+void WaveTick(void);
+CYBLE_GATT_ERR_CODE_T WaveWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair);
+CYBLE_GATT_ERR_CODE_T WaveCccdWriteRequest(const CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair);
+void WavePrint(void);
+#else
+/* No transducer channel to stream: the service refuses to start */
+#define WaveStop()
+#define WaveSetMtu(mtu)
+#define WaveRunning()               (DISABLED)
+#define WaveSample()
+#define WaveProcess()
+#define WaveTick()
+#define WaveWriteRequest(handleValuePair)       (CYBLE_GATT_ERR_REQUEST_NOT_SUPPORTED)
+#define WaveCccdWriteRequest(handleValuePair)   (CYBLE_GATT_ERR_NONE)
+#define WavePrint()
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+
+#endif /* WAVE_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,86 @@
+# Reports the memory of a PSoC Creator ARM GCC image from its linker map:
+# the output sections, and the part of them that the newlib printf and
+# heap members take. DebugPrintf replaces printf, so with it these members
+# drop out of the link, apart from the .heap reservation, which is set in
+# the System settings of the design.
+#
+#   cmake -DMAP=<map> -P mapsize.cmake
+
+if(NOT DEFINED MAP)
+    message(FATAL_ERROR "mapsize.cmake: set MAP to the linker map")
+endif()
+
+# newlib members that printf pulls in: stdio, FILE buffers, malloc and the
+# system calls behind them
+set(PRINTF_MEMBERS "printf|puts|vfprintf|vfprintf_i|wbuf|wsetup|fflush|findfp|fvwrite|fwalk|makebuf|stdio"
+                   "nano-mallocr|nano-freer|nano-reallocr|nano-msizer|sbrkr|reent|impure"
+                   "writer|closer|fstatr|isattyr|lseekr|readr|close|fstat|isatty|lseek|read")
+string(REPLACE ";" "|" PRINTF_MEMBERS "${PRINTF_MEMBERS}")
+
+set(PRINTF_text 0)
+set(PRINTF_data 0)
+set(PRINTF_bss 0)
+
+# map_input(<section> <size> <file>): adds a newlib printf input section to
+# the PRINTF_ counts; _sbrk of Cm0Start.c serves malloc only
+function(map_input SECTION SIZE FILE)
+    if((FILE MATCHES "\\((lib_a-)?(${PRINTF_MEMBERS})\\.o\\)$") OR (SECTION STREQUAL ".text._sbrk"))
+        if(SECTION MATCHES "^\\.(text|rodata)")
+            math(EXPR PRINTF_text "${PRINTF_text} + ${SIZE}")
+            set(PRINTF_text ${PRINTF_text} PARENT_SCOPE)
+        elseif(SECTION MATCHES "^\\.data")
+            math(EXPR PRINTF_data "${PRINTF_data} + ${SIZE}")
+            set(PRINTF_data ${PRINTF_data} PARENT_SCOPE)
+        elseif(SECTION MATCHES "^(\\.bss|COMMON)")
+            math(EXPR PRINTF_bss "${PRINTF_bss} + ${SIZE}")
+            set(PRINTF_bss ${PRINTF_bss} PARENT_SCOPE)
+        endif()
+    endif()
+endfunction()
+
+# The memory map follows the list of discarded sections. An input section
+# with a long name goes on a line of its own, its address on the next.
+file(STRINGS ${MAP} LINES)
+set(IN_MAP FALSE)
+set(PENDING "")
+foreach(LINE IN LISTS LINES)
+    if(NOT IN_MAP)
+        if(LINE MATCHES "^Linker script and memory map")
+            set(IN_MAP TRUE)
+        endif()
+    elseif(LINE MATCHES "^\\.([a-z]+)[ ]+0x[0-9a-f]+[ ]+(0x[0-9a-f]+)")
+        set(OUT_${CMAKE_MATCH_1} ${CMAKE_MATCH_2})
+        set(PENDING "")
+    elseif(LINE MATCHES "^ (\\.[^ ]+|COMMON)$")
+        set(PENDING ${CMAKE_MATCH_1})
+    elseif(LINE MATCHES "^ (\\.[^ ]+|COMMON)[ ]+0x[0-9a-f]+[ ]+(0x[0-9a-f]+) (.+)$")
+        map_input(${CMAKE_MATCH_1} ${CMAKE_MATCH_2} "${CMAKE_MATCH_3}")
+        set(PENDING "")
+    elseif((NOT PENDING STREQUAL "") AND (LINE MATCHES "^[ ]+0x[0-9a-f]+[ ]+(0x[0-9a-f]+) (.+)$"))
+        map_input(${PENDING} ${CMAKE_MATCH_1} "${CMAKE_MATCH_2}")
+        set(PENDING "")
+    else()
+        set(PENDING "")
+    endif()
+endforeach()
+
+if(NOT IN_MAP)
+    message(FATAL_ERROR "mapsize.cmake: ${MAP} has no memory map")
+endif()
+
+foreach(SECTION text rodata data bss heap stack)
+    if(NOT DEFINED OUT_${SECTION})
+        set(OUT_${SECTION} 0)
+    endif()
+    math(EXPR OUT_${SECTION} "${OUT_${SECTION}}")
+endforeach()
+math(EXPR FLASH "${OUT_text} + ${OUT_rodata} + ${OUT_data}")
+math(EXPR RAM "${OUT_data} + ${OUT_bss}")
+math(EXPR PRINTF_FLASH "${PRINTF_text} + ${PRINTF_data}")
+math(EXPR PRINTF_RAM "${PRINTF_data} + ${PRINTF_bss}")
+
+message("Linker map, bytes:     .text  .rodata  .data  .bss  .heap  .stack")
+message("  output sections:     ${OUT_text}  ${OUT_rodata}  ${OUT_data}  ${OUT_bss}  ${OUT_heap}  ${OUT_stack}")
+message("  newlib printf, heap: ${PRINTF_text} with .rodata  ${PRINTF_data}  ${PRINTF_bss}")
+message("Flash ${FLASH}, of which newlib printf ${PRINTF_FLASH}")
+message("Static RAM ${RAM}, of which newlib printf ${PRINTF_RAM}, plus the .heap of ${OUT_heap}")
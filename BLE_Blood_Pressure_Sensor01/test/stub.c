@@ -0,0 +1,413 @@
+/*******************************************************************************
+* File Name: stub.c
+*
+* Version 1.0
+*
+* Description:
+*  Host stubs of the PSoC components, the BLE stack and the application
+*  modules a test does not build. All of them are weak: a test that needs a
+*  behaviour defines its own, and a module the test builds replaces its
+*  stubs. The debug UART writes to stdout, flash writes copy to the row.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include "test.h"
+#include "analog.h"
+#include "bas.h"
+#include "blss.h"
+#include "boot.h"
+#include "clock.h"
+#include "energy.h"
+#include "profile.h"
+#include "record.h"
+#include "retain.h"
+#include "rtc.h"
+#include "wave.h"
+
+#define STUB                        __attribute__((weak))
+#define STUB_PAGE_SIZE              (4096u)
+
+
+/***************************************
+*       Component data
+***************************************/
+STUB CYBLE_CONN_HANDLE_T cyBle_connHandle;
+STUB volatile uint8 cyBle_busyStatus;
+STUB CYBLE_STATE_T cyBle_state;
+STUB uint8 UART_DEB_initVar;
+
+/* The Blood Pressure service handles and its CCCDs in the GATT database */
+STUB uint8 cyBle_attValuesCCCD[CYBLE_GATT_DB_CCCD_COUNT];
+STUB const CYBLE_BLSS_T cyBle_blss =
+{
+    0x000Cu,
+    {
+        {0x000Eu, 0x000Fu},
+        {0x0011u, 0x0012u},
+        {0x0014u, CYBLE_GATT_INVALID_ATTR_HANDLE_VALUE},
+    },
+};
+STUB const CYBLE_GATTS_DB_T cyBle_gattDB[CYBLE_GATT_DB_INDEX_COUNT] =
+{
+    [0x000Eu] = {0x000Fu, 0x2902u, 0x00000A0Eu, 0x000Fu, {{0x0002u, (void *)&cyBle_attValuesCCCD[2]}}},
+    [0x0011u] = {0x0012u, 0x2902u, 0x00000A0Eu, 0x0012u, {{0x0002u, (void *)&cyBle_attValuesCCCD[4]}}},
+};
+
+
+/***************************************
+*       Application data
+***************************************/
+STUB CYBLE_API_RESULT_T apiResult;
+STUB volatile uint32 wdtSeconds;
+STUB uint16 gattMtu = CYBLE_GATT_DEFAULT_MTU;
+
+
+/***************************************
+*       Components
+***************************************/
+STUB void UART_DEB_Start(void)
+{
+}
+
+STUB void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    (void)putchar((int)txData);
+}
+
+STUB uint32 UART_DEB_SpiUartGetTxBufferSize(void)
+{
+    return(0u);
+}
+
+STUB void ADC_Start(void)
+{
+}
+
+STUB void ADC_Sleep(void)
+{
+}
+
+STUB void ADC_Wakeup(void)
+{
+}
+
+STUB void ADC_StartConvert(void)
+{
+}
+
+STUB uint32 ADC_IsEndConversion(uint32 retMode)
+{
+    return(1u);
+}
+
+STUB void ADC_EnableInjection(void)
+{
+}
+
+STUB int16 ADC_GetResult16(uint32 chan)
+{
+    return(0);
+}
+
+STUB void CyDelay(uint32 milliseconds)
+{
+}
+
+STUB uint8 CyEnterCriticalSection(void)
+{
+    return(0u);
+}
+
+STUB void CyExitCriticalSection(uint8 savedIntrStatus)
+{
+}
+
+STUB void LowPower_LED_Write(uint8 value)
+{
+}
+
+STUB void Advertising_LED_Write(uint8 value)
+{
+}
+
+STUB void Disconnect_LED_Write(uint8 value)
+{
+}
+
+STUB uint8 SW2_ClearInterrupt(void)
+{
+    return(0u);
+}
+
+STUB void Wakeup_Interrupt_ClearPending(void)
+{
+}
+
+STUB void Wakeup_Interrupt_Start(void)
+{
+}
+
+STUB void CySysPmHibernate(void)
+{
+}
+
+STUB void CySysTickEnable(void)
+{
+}
+
+STUB void CySysTickClear(void)
+{
+}
+
+STUB void CySysTickDisableInterrupt(void)
+{
+}
+
+STUB void CySysTickSetClockSource(uint32 clockSource)
+{
+}
+
+STUB void CySysTickSetReload(uint32 value)
+{
+}
+
+STUB void CySysClkWriteSysclkDiv(uint32 divider)
+{
+}
+
+STUB void CySysFlashSetWaitCycles(uint32 freq)
+{
+}
+
+STUB void CySysWdtLock(void)
+{
+}
+
+STUB void CySysWdtUnlock(void)
+{
+}
+
+STUB void CySysWdtWriteMode(uint32 counterNum, uint32 mode)
+{
+}
+
+STUB void CySysWdtWriteClearOnMatch(uint32 counterNum, uint32 enable)
+{
+}
+
+STUB void CySysWdtWriteMatch(uint32 counterNum, uint32 match)
+{
+}
+
+STUB void CySysWdtResetCounters(uint32 countersMask)
+{
+}
+
+STUB void CySysWdtEnable(uint32 counterMask)
+{
+}
+
+STUB void CySysWdtDisable(uint32 counterMask)
+{
+}
+
+STUB void CySysWdtClearInterrupt(uint32 counterMask)
+{
+}
+
+STUB uint32 CySysPmGetResetReason(void)
+{
+    return(CY_PM_RESET_REASON_XRES);
+}
+
+
+/***************************************
+*       BLE stack
+***************************************/
+STUB void CyBle_ProcessEvents(void)
+{
+}
+
+STUB CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_GetDeviceAddress(CYBLE_GAP_BD_ADDR_T* bdAddr)
+{
+    (void)memset(bdAddr, 0, sizeof(CYBLE_GAP_BD_ADDR_T));
+    return(CYBLE_ERROR_OK);
+}
+
+STUB uint16 CyBle_Get16ByPtr(const uint8 ptr[])
+{
+    return((uint16)(ptr[0u] | ((uint16)ptr[1u] << 8u)));
+}
+
+STUB void CyBle_Set16ByPtr(uint8 ptr[], uint16 value)
+{
+    ptr[0u] = LO8(value);
+    ptr[1u] = HI8(value);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_StoreAppData(uint8 *srcBuff, const uint8 destAddr[], uint32 buffLen,
+    uint8 isForceWrite)
+{
+    uintptr_t page = (uintptr_t)destAddr & ~(uintptr_t)(STUB_PAGE_SIZE - 1u);
+
+    /* The rows are const data, which the host maps read-only */
+    (void)mprotect((void *)page, ((uintptr_t)destAddr + buffLen) - page, PROT_READ | PROT_WRITE);
+    (void)memcpy((void *)destAddr, srcBuff, buffLen);
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_GapGetPeerBdAddr(uint8 bdHandle, CYBLE_GAP_BD_ADDR_T* peerBdAddr)
+{
+    return(CYBLE_ERROR_NO_DEVICE_ENTITY);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_GapGetBondedDevicesList(CYBLE_GAP_BONDED_DEV_ADDR_LIST_T* bondedDevList)
+{
+    bondedDevList->count = 0u;
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle,
+    CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_GATT_ERR_CODE_T CyBle_GattsWriteAttributeValue(CYBLE_GATT_HANDLE_VALUE_PAIR_T *handleValuePair,
+    uint16 offset, CYBLE_CONN_HANDLE_T *connHandle, uint8 flags)
+{
+    return(CYBLE_GATT_ERR_NONE);
+}
+
+STUB void CyBle_BasRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+}
+
+STUB CYBLE_API_RESULT_T CyBle_BassGetCharacteristicDescriptor(uint8 serviceIndex,
+    CYBLE_BAS_CHAR_INDEX_T charIndex, CYBLE_BAS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue)
+{
+    (void)memset(attrValue, 0, attrSize);
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_BassSetCharacteristicValue(uint8 serviceIndex, CYBLE_BAS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_BassSendNotification(CYBLE_CONN_HANDLE_T connHandle, uint8 serviceIndex,
+    CYBLE_BAS_CHAR_INDEX_T charIndex, uint8 attrSize, uint8 *attrValue)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+STUB void CyBle_BlsRegisterAttrCallback(CYBLE_CALLBACK_T callbackFunc)
+{
+}
+
+STUB CYBLE_API_RESULT_T CyBle_BlssSendNotification(CYBLE_CONN_HANDLE_T connHandle,
+    CYBLE_BLS_CHAR_INDEX_T charIndex, uint8 attrSize, uint8 *attrValue)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+STUB CYBLE_API_RESULT_T CyBle_BlssSendIndication(CYBLE_CONN_HANDLE_T connHandle,
+    CYBLE_BLS_CHAR_INDEX_T charIndex, uint8 attrSize, uint8 *attrValue)
+{
+    return(CYBLE_ERROR_OK);
+}
+
+
+/***************************************
+*       Application modules
+***************************************/
+STUB uint32 WDT_ReadTime(uint32 *ticks)
+{
+    *ticks = 0u;
+    return(wdtSeconds);
+}
+
+STUB void BootUartStart(void)
+{
+}
+
+STUB uint8 BootAdcStart(void)
+{
+    return(DISABLED);
+}
+
+STUB uint8 BootStamp(BOOT_STAGE_T stage)
+{
+    return(DISABLED);
+}
+
+STUB void BootPrint(void)
+{
+}
+
+STUB void ClockInit(void)
+{
+}
+
+STUB void RetainSave(void)
+{
+}
+
+STUB void ServerDebugOut(uint32 event, void *eventParam)
+{
+}
+
+STUB uint8 RecordUserOf(uint8 bdHandle)
+{
+    return(REC_USER_GUEST);
+}
+
+STUB void EnergySubsystemStart(ENERGY_SUB_T sub)
+{
+}
+
+STUB void EnergySubsystemStop(ENERGY_SUB_T sub)
+{
+}
+
+STUB void AnalogAcquire(ANALOG_USER_T user)
+{
+}
+
+STUB void AnalogRelease(ANALOG_USER_T user)
+{
+}
+
+#if (CAL_PRESSURE_ENABLE != 0u)
+STUB uint8 WaveRunning(void)
+{
+    return(DISABLED);
+}
+#endif /* (CAL_PRESSURE_ENABLE != 0u) */
+
+#if (PROFILE_ENABLE != 0)
+STUB void ProfileEnter(PROFILE_REGION_T region)
+{
+}
+
+STUB void ProfileExit(PROFILE_REGION_T region)
+{
+}
+#endif /* (PROFILE_ENABLE != 0) */
+
+
+/* [] END OF FILE */
@@ -0,0 +1,94 @@
+/*******************************************************************************
+* File Name: test.c
+*
+* Version 1.0
+*
+* Description:
+*  Host test checks. Failures are counted and reported through the
+*  application's trace formatter, so the test output reads like the debug
+*  UART of the kit.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+
+TEST_REG_T testReg;
+
+static uint32 testChecks = 0u;
+static uint32 testFailures = 0u;
+
+
+/*******************************************************************************
+* Function Name: TestCheck
+********************************************************************************
+*
+* Summary:
+*   Counts a check and reports it when it fails.
+*
+* Parameters:
+*   pass - ENABLED if the condition held.
+*   line - source line of the check.
+*   text - the condition.
+*
+* Return:
+*   pass.
+*
+*******************************************************************************/
+uint8 TestCheck(uint8 pass, uint32 line, const char *text)
+{
+    testChecks++;
+    if(pass == DISABLED)
+    {
+        testFailures++;
+        printf("FAIL line %ld: %s \r\n", line, text);
+    }
+    return(pass);
+}
+
+
+/*******************************************************************************
+* Function Name: TestEqual
+********************************************************************************
+*
+* Summary:
+*   Counts a check and reports both values when they differ.
+*
+*******************************************************************************/
+uint8 TestEqual(int32 value, int32 expected, uint32 line, const char *text)
+{
+    uint8 pass = (value == expected) ? ENABLED : DISABLED;
+
+    testChecks++;
+    if(pass == DISABLED)
+    {
+        testFailures++;
+        printf("FAIL line %ld: %s is %ld, expected %ld \r\n", line, text, value, expected);
+    }
+    return(pass);
+}
+
+
+/*******************************************************************************
+* Function Name: TestResult
+********************************************************************************
+*
+* Summary:
+*   Prints the summary of the test.
+*
+* Return:
+*   Exit status of the test: 0 if all checks passed.
+*
+*******************************************************************************/
+int TestResult(const char *name)
+{
+    printf("%s: %ld checks, %ld failed \r\n", name, testChecks, testFailures);
+    return((testFailures == 0u) ? 0 : 1);
+}
+
+
+/* [] END OF FILE */
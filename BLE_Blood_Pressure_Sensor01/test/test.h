@@ -0,0 +1,86 @@
+/*******************************************************************************
+* File Name: test.h
+*
+* Version 1.0
+*
+* Description:
+*  Host test support. Replaces the Cortex-M0 intrinsics the application uses
+*  with host equivalents, after the generated headers have defined them, and
+*  provides the checks. A test includes this file before the sources of the
+*  modules it tests.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#if !defined(TEST_H)
+#define TEST_H
+
+#include <stdint.h>
+#include "common.h"
+
+#undef CyGlobalIntEnable
+#define CyGlobalIntEnable           do { } while(0)
+#undef CyGlobalIntDisable
+#define CyGlobalIntDisable          do { } while(0)
+#define __DMB()                     __sync_synchronize()
+#undef __get_MSP
+#define __get_MSP()                 (testReg.msp)
+
+/* Registers the application accesses directly */
+#undef ADC_SAR_CTRL_REG
+#define ADC_SAR_CTRL_REG            (testReg.sarCtrl)
+#undef ADC_SAR_STATUS_REG
+#define ADC_SAR_STATUS_REG          (testReg.sarStatus)
+#undef ADC_SAR_INJ_CHAN_CONFIG_REG
+#define ADC_SAR_INJ_CHAN_CONFIG_REG (testReg.sarInjConfig)
+#undef ADC_SAR_INTR_REG
+#define ADC_SAR_INTR_REG            (testReg.sarIntr)
+#undef CY_SYS_SYST_CVR_REG
+#define CY_SYS_SYST_CVR_REG         (testReg.systCvr)
+#undef UART_DEB_GET_TX_FIFO_SR_VALID
+#define UART_DEB_GET_TX_FIFO_SR_VALID (testReg.uartTxFifo)
+
+
+/***************************************
+*       Checks
+***************************************/
+#define TEST_CHECK(cond)            TestCheck((cond) ? ENABLED : DISABLED, __LINE__, #cond)
+#define TEST_EQUAL(a, b)            TestEqual((int32)(a), (int32)(b), __LINE__, #a)
+
+
+/***************************************
+*       Data Types
+***************************************/
+typedef struct
+{
+    uint32 sarCtrl;
+    uint32 sarStatus;
+    uint32 sarInjConfig;
+    uint32 sarIntr;                             /* The injection end of conversion of the sequencer model */
+    uint32 systCvr;                             /* SysTick counts down from CY_SYS_SYST_RVR_CNT_MASK */
+    uint32 uartTxFifo;
+    uintptr_t msp;                              /* Main stack pointer, an address of the test */
+}TEST_REG_T;
+
+
+/***************************************
+*       Function Prototypes
+***************************************/
+uint8 TestCheck(uint8 pass, uint32 line, const char *text);
+uint8 TestEqual(int32 value, int32 expected, uint32 line, const char *text);
+int TestResult(const char *name);
+
+
+/***************************************
+* External data references
+***************************************/
+extern TEST_REG_T testReg;
+
+
+#endif /* TEST_H */
+
+/* [] END OF FILE */
@@ -0,0 +1,243 @@
+/*******************************************************************************
+* File Name: test_analog.c
+*
+* Version 1.0
+*
+* Description:
+*  Analog front end gating in a host energy simulation of a day: a battery
+*  read every minute, a 40 s waveform stream every hour and three
+*  calibration captures. The rails must be powered exactly while a user
+*  needs them, the SAR started once and then slept and woken in turn, and
+*  the transducer settled on every power up. The energy accounting has to
+*  match the powered time of the model. Reports the idle current saved per
+*  subsystem against rails that stay powered, less the settling.
+*
+*  Built with and without the Sensor_Power pin (TEST_SENSOR_SWITCH).
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "test.h"
+#if (TEST_SENSOR_SWITCH != 0u)
+    #define Sensor_Power__PC        (0u)
+    void Sensor_Power_Write(uint8 value);
+#endif /* (TEST_SENSOR_SWITCH != 0u) */
+#include "analog.c"
+#include "energy.c"
+
+#define TEST_SECONDS                (86400u)    /* One day */
+#define TEST_SECOND_TICKS           (1u << WDT_TICKS_SHIFT)
+#define TEST_BATTERY_PERIOD         (60u)       /* s */
+#define TEST_BATTERY_TICKS          (66u)       /* Battery read window, about 2 ms */
+#define TEST_WAVE_PERIOD            (3600u)     /* s, one blood pressure measurement per hour */
+#define TEST_WAVE_SECONDS           (40u)
+#define TEST_WAVE_OFFSET            (30u)       /* s, the stream starts between two battery reads */
+#define TEST_CALIB_FIRST            (100u)      /* s, three captures of one second */
+#define TEST_CALIB_COUNT            (3u)
+
+static uint32 testTicks;
+static uint8 testAdcStarted;
+static uint8 testAdcAwake;
+static uint32 testAdcWakeups;
+static uint32 testAdcErrors;
+static uint8 testSensorPin;
+static uint32 testSettles;
+
+
+/***************************************
+*       Components
+***************************************/
+uint32 WDT_ReadTicks(void)
+{
+    return(testTicks);
+}
+
+uint8 BootAdcStart(void)
+{
+    uint8 started = DISABLED;
+
+    if(testAdcStarted == DISABLED)
+    {
+        testAdcStarted = ENABLED;
+        testAdcAwake = ENABLED;
+        started = ENABLED;
+    }
+    return(started);
+}
+
+void ADC_Sleep(void)
+{
+    testAdcErrors += (testAdcAwake != DISABLED) ? 0u : 1u;
+    testAdcAwake = DISABLED;
+}
+
+void ADC_Wakeup(void)
+{
+    testAdcErrors += ((testAdcStarted != DISABLED) && (testAdcAwake == DISABLED)) ? 0u : 1u;
+    testAdcAwake = ENABLED;
+    testAdcWakeups++;
+}
+
+void CyDelay(uint32 milliseconds)
+{
+    /* The settling must follow the power up of the transducer */
+    testAdcErrors += ((milliseconds == ANALOG_SENSOR_SETTLE_MS) && (testSensorPin == ANALOG_SENSOR_ON)) ? 0u : 1u;
+    testSettles++;
+}
+
+#if (TEST_SENSOR_SWITCH != 0u)
+void Sensor_Power_Write(uint8 value)
+{
+    testSensorPin = value;
+}
+#endif /* (TEST_SENSOR_SWITCH != 0u) */
+
+
+/*******************************************************************************
+* Function Name: TestTicks
+********************************************************************************
+*
+* Summary:
+*   Returns the accumulated time in WDT ticks.
+*
+*******************************************************************************/
+static uint32 TestTicks(const ENERGY_TIME_T *time)
+{
+    return((time->seconds << ENERGY_TICKS_SHIFT) + time->ticks);
+}
+
+
+/*******************************************************************************
+* Function Name: TestSet
+********************************************************************************
+*
+* Summary:
+*   Acquires or releases the user when its state changes.
+*
+*******************************************************************************/
+static void TestSet(ANALOG_USER_T user, uint8 *active, uint8 need)
+{
+    if((need != DISABLED) && (*active == DISABLED))
+    {
+        AnalogAcquire(user);
+    }
+    else if((need == DISABLED) && (*active != DISABLED))
+    {
+        AnalogRelease(user);
+    }
+    else
+    {
+        /* Unchanged */
+    }
+    *active = need;
+}
+
+
+/*******************************************************************************
+* Function Name: TestDay
+********************************************************************************
+*
+* Summary:
+*   Runs the day second by second and checks the rails, the SAR sequence,
+*   the settling and the accounted powered time.
+*
+*******************************************************************************/
+static void TestDay(void)
+{
+    uint8 battery = DISABLED;
+    uint8 calib = DISABLED;
+    uint8 wave = DISABLED;
+    uint8 sensor;
+    uint8 sensorWas = DISABLED;
+    uint32 sarUps = 0u;
+    uint32 sensorUps = 0u;
+    uint32 sarTicks = 0u;
+    uint32 sensorTicks = 0u;
+    uint32 railErrors = 0u;
+    uint32 settleUas;
+    uint32 savedUah[2u];
+    uint32 s;
+
+    testTicks = 0u;
+    EnergyInit();
+    for(s = 0u; s < TEST_SECONDS; s++)
+    {
+        testTicks = s * TEST_SECOND_TICKS;
+        TestSet(ANALOG_USER_WAVE, &wave, (((s + TEST_WAVE_PERIOD - TEST_WAVE_OFFSET) % TEST_WAVE_PERIOD) <
+            TEST_WAVE_SECONDS) ? ENABLED : DISABLED);
+        TestSet(ANALOG_USER_CALIB, &calib, ((s >= TEST_CALIB_FIRST) && (s < (TEST_CALIB_FIRST + TEST_CALIB_COUNT))) ?
+            ENABLED : DISABLED);
+        sensor = ((wave | calib) != DISABLED) ? ENABLED : DISABLED;
+        sensorUps += ((sensor != DISABLED) && (sensorWas == DISABLED)) ? 1u : 0u;
+        sensorTicks += (sensor != DISABLED) ? TEST_SECOND_TICKS : 0u;
+
+        /* Between the battery reads the SAR is powered with the transducer */
+        sarUps += ((sensor != DISABLED) && (sensorWas == DISABLED)) ? 1u : 0u;
+        sarTicks += (sensor != DISABLED) ? TEST_SECOND_TICKS : 0u;
+        if((s % TEST_BATTERY_PERIOD) == 0u)
+        {
+            TestSet(ANALOG_USER_BATTERY, &battery, ENABLED);
+            railErrors += ((analogRails & ANALOG_RAIL_SAR) != 0u) ? 0u : 1u;
+            testTicks += TEST_BATTERY_TICKS;
+            TestSet(ANALOG_USER_BATTERY, &battery, DISABLED);
+            sarUps += (sensor != DISABLED) ? 0u : 1u;
+            sarTicks += (sensor != DISABLED) ? 0u : TEST_BATTERY_TICKS;
+        }
+        sensorWas = sensor;
+
+        railErrors += (analogRails == ((sensor != DISABLED) ? (ANALOG_RAIL_SAR | ANALOG_RAIL_SENSOR) : 0u)) ? 0u : 1u;
+        railErrors += (testAdcAwake == sensor) ? 0u : 1u;
+    #if (TEST_SENSOR_SWITCH != 0u)
+        railErrors += (testSensorPin == ((sensor != DISABLED) ? ANALOG_SENSOR_ON : ANALOG_SENSOR_OFF)) ? 0u : 1u;
+    #endif /* (TEST_SENSOR_SWITCH != 0u) */
+    }
+    testTicks = TEST_SECONDS * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+
+    TEST_EQUAL(railErrors, 0u);
+    TEST_EQUAL(testAdcErrors, 0u);
+    TEST_EQUAL(testAdcWakeups, sarUps - 1u);
+    TEST_EQUAL(testSettles, (TEST_SENSOR_SWITCH != 0u) ? sensorUps : 0u);
+    TEST_EQUAL(TestTicks(&energySub[ENERGY_SUB_SAR]), sarTicks);
+    TEST_EQUAL(TestTicks(&energySub[ENERGY_SUB_SENSOR]), sensorTicks);
+    TEST_EQUAL(energyMode[ENERGY_MODE_ACTIVE].seconds, TEST_SECONDS);
+
+    /* Idle current saved per subsystem against rails that stay powered, uAh */
+    savedUah[0u] = (uint32)(((uint64)(TEST_SECONDS * TEST_SECOND_TICKS - sarTicks) * ENERGY_UA_SAR) /
+        (3600u * TEST_SECOND_TICKS));
+    savedUah[1u] = (uint32)(((uint64)(TEST_SECONDS * TEST_SECOND_TICKS - sensorTicks) * ENERGY_UA_SENSOR) /
+        (3600u * TEST_SECOND_TICKS));
+
+    /* The saving EnergyPrint() reports, from whole seconds */
+    TEST_CHECK(abs((int32)savedUah[0u] - (int32)(((TEST_SECONDS - energySub[ENERGY_SUB_SAR].seconds) *
+        ENERGY_UA_SAR) / 3600u)) <= 1);
+    TEST_CHECK(abs((int32)savedUah[1u] - (int32)(((TEST_SECONDS - energySub[ENERGY_SUB_SENSOR].seconds) *
+        ENERGY_UA_SENSOR) / 3600u)) <= 1);
+
+    /* The CPU waits in Active mode with the transducer powered while it settles */
+    settleUas = (testSettles * ANALOG_SENSOR_SETTLE_MS * (ENERGY_UA_ACTIVE + ENERGY_UA_SENSOR)) / 1000u;
+    TEST_CHECK(((savedUah[0u] + savedUah[1u]) * 3600u) > (settleUas * 100u));
+
+    printf("Analog gating, sensor switch %d, one day: sar powered %ld ms, %ld wakeups, sensor powered %ld ms, "
+        "%ld power ups \r\n", TEST_SENSOR_SWITCH, EnergyTimeToMs(&energySub[ENERGY_SUB_SAR]), testAdcWakeups,
+        EnergyTimeToMs(&energySub[ENERGY_SUB_SENSOR]), sensorUps);
+    printf("  saved: sar %ld uAh, sensor %ld uAh, settling costs %ld uAs \r\n", savedUah[0u], savedUah[1u],
+        settleUas);
+    EnergyPrint();
+}
+
+
+int main(void)
+{
+    TestDay();
+
+    return(TestResult("analog"));
+}
+
+
+/* [] END OF FILE */
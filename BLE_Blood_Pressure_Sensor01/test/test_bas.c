@@ -0,0 +1,374 @@
+/*******************************************************************************
+* File Name: test_bas.c
+*
+* Version 1.0
+*
+* Description:
+*  Checks the battery voltage lookup table and the discharge curve of the
+*  selected BAS_BATTERY_PROFILE against the division formulas they
+*  replace, for every ADC code, and the notification timers. Built for the
+*  reference capacitor method the table serves; the injection channel is
+*  checked by test_inj.
+*
+*  A discharge of the battery with a count of ADC noise is measured every
+*  BATTERY_TIMEOUT seconds, and the notifications are counted against a
+*  model of the rule and against a notification per measurement. Built
+*  also with BATTERY_NTF_HYSTERESIS 0, which notifies every measurement.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#undef ADC_INJ_CHANNEL_ENABLED
+#define ADC_INJ_CHANNEL_ENABLED     (0u)        /* The reference capacitor method */
+#include "bas.c"
+
+#define TEST_ADC_CODE_MAX           (2047)
+#define TEST_LUT_ADC_MAX            (BAS_LUT_ADC_MIN + (int32)BAS_LUT_CODE_MAX)
+#define TEST_MVOLTS_ERROR           (2)         /* Interpolation error of the table in mV */
+#define TEST_LEVEL_ERROR            (1)         /* Rounding of the Q16 slopes in percent */
+#define TEST_DISCHARGE_SECONDS      (6u * 3600u)
+#define TEST_NOISE_CODES            (1)         /* ADC noise, counts either way */
+
+static int16 testAdcResult;
+static uint32 testNotifications;
+static uint32 testValues;                       /* Measurements written to the characteristic */
+static uint8 testValue;
+static uint8 testQuiet;
+
+
+/*******************************************************************************
+* Function Name: ADC_GetResult16
+********************************************************************************
+*
+* Summary:
+*   Returns the ADC code the test set.
+*
+*******************************************************************************/
+int16 ADC_GetResult16(uint32 chan)
+{
+    return(testAdcResult);
+}
+
+
+/*******************************************************************************
+* Function Name: UART_DEB_SpiUartWriteTxData
+********************************************************************************
+*
+* Summary:
+*   Discards the traces of the simulation.
+*
+*******************************************************************************/
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testQuiet == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_BassSetCharacteristicValue
+********************************************************************************
+*
+* Summary:
+*   Takes the measured Battery Level.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_BassSetCharacteristicValue(uint8 serviceIndex, CYBLE_BAS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    testValue = *attrValue;
+    testValues++;
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_BassSendNotification
+********************************************************************************
+*
+* Summary:
+*   Counts the notifications; the level sent must be the last measured.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_BassSendNotification(CYBLE_CONN_HANDLE_T connHandle, uint8 serviceIndex,
+    CYBLE_BAS_CHAR_INDEX_T charIndex, uint8 attrSize, uint8 *attrValue)
+{
+    TEST_EQUAL(*attrValue, testValue);
+    testNotifications++;
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: TestLevel
+********************************************************************************
+*
+* Summary:
+*   The discharge curve with divisions, as MeasureBattery() computed it.
+*
+*******************************************************************************/
+static int32 TestLevel(int32 mvolts)
+{
+    int32 level;
+
+    if(mvolts < MEASURE_BATTERY_MIN)
+    {
+        level = 0;
+    }
+    else if(mvolts < MEASURE_BATTERY_MID)
+    {
+        level = (mvolts - MEASURE_BATTERY_MIN) * MEASURE_BATTERY_MID_PERCENT /
+                (MEASURE_BATTERY_MID - MEASURE_BATTERY_MIN);
+    }
+    else if(mvolts < MEASURE_BATTERY_MAX)
+    {
+        level = MEASURE_BATTERY_MID_PERCENT +
+                (mvolts - MEASURE_BATTERY_MID) * (100 - MEASURE_BATTERY_MID_PERCENT) /
+                (MEASURE_BATTERY_MAX - MEASURE_BATTERY_MID);
+    }
+    else
+    {
+        level = CYBLE_BAS_MAX_BATTERY_LEVEL_VALUE;
+    }
+    return(level);
+}
+
+
+/*******************************************************************************
+* Function Name: TestDischarge
+********************************************************************************
+*
+* Summary:
+*   Discharges the battery from MEASURE_BATTERY_MAX to MEASURE_BATTERY_MIN
+*   in TEST_DISCHARGE_SECONDS with the timer of the main loop. The
+*   notifications must follow the rule, notified level and age, of a model
+*   run on the measured levels, and the hysteresis must cut the radio
+*   traffic of a notification per measurement at least tenfold.
+*
+*******************************************************************************/
+static void TestDischarge(void)
+{
+    uint32 random = 1u;
+    uint32 s;
+    uint32 first;
+    uint32 values;
+    uint32 model = 0u;
+    uint32 modelStale = 0u;
+    uint8 modelLevel = BATTERY_LEVEL_INVALID;
+    int32 mvolts;
+
+    batteryMeasure = ENABLED;
+    batteryNtfLevel = BATTERY_LEVEL_INVALID;
+    basStaleTimer = 0u;
+    testNotifications = 0u;
+    first = testValues;
+    testQuiet = ENABLED;
+    for(s = 0u; s < TEST_DISCHARGE_SECONDS; s++)
+    {
+        mvolts = MEASURE_BATTERY_MAX - (int32)(((uint32)(MEASURE_BATTERY_MAX - MEASURE_BATTERY_MIN) * s) /
+            TEST_DISCHARGE_SECONDS);
+        random = (random * 1103515245u) + 12345u;
+        testAdcResult = (int16)(((1024 * 2048) / mvolts) + (int32)((random >> 16u) % 3u) - TEST_NOISE_CODES);
+
+        BasTick();
+        modelStale += (modelStale < BATTERY_NTF_MAX_STALE) ? 1u : 0u;
+        values = testValues;
+        MeasureBattery();
+        if(testValues != values)
+        {
+            if((modelLevel == BATTERY_LEVEL_INVALID) || (modelStale >= BATTERY_NTF_MAX_STALE) ||
+               (testValue >= (modelLevel + BATTERY_NTF_HYSTERESIS)) ||
+               ((testValue + BATTERY_NTF_HYSTERESIS) <= modelLevel))
+            {
+                modelLevel = testValue;
+                modelStale = 0u;
+                model++;
+            }
+        }
+    }
+    testQuiet = DISABLED;
+
+    TEST_EQUAL(testValues - first, TEST_DISCHARGE_SECONDS / BATTERY_TIMEOUT);
+    TEST_EQUAL(testNotifications, model);
+    TEST_CHECK(testNotifications >= (TEST_DISCHARGE_SECONDS / BATTERY_NTF_MAX_STALE));
+    if(BATTERY_NTF_HYSTERESIS == 0u)
+    {
+        TEST_EQUAL(testNotifications, TEST_DISCHARGE_SECONDS / BATTERY_TIMEOUT);
+    }
+    else
+    {
+        TEST_CHECK((testNotifications * 10u) < (TEST_DISCHARGE_SECONDS / BATTERY_TIMEOUT));
+    }
+    printf("Discharge over %ld h, hysteresis %d %%: %ld notifications for %ld measurements \r\n",
+        TEST_DISCHARGE_SECONDS / 3600u, BATTERY_NTF_HYSTERESIS, testNotifications,
+        TEST_DISCHARGE_SECONDS / BATTERY_TIMEOUT);
+}
+
+
+/*******************************************************************************
+* Function Name: TestReconnect
+********************************************************************************
+*
+* Summary:
+*   A notification the busy stack held back when the link dropped must not
+*   be sent on the next connection: the first notification after the
+*   reconnect carries a new measurement.
+*
+*******************************************************************************/
+static void TestReconnect(void)
+{
+    uint32 values;
+    uint32 i;
+
+    batteryMeasure = ENABLED;
+    batteryNtfLevel = BATTERY_LEVEL_INVALID;
+    testQuiet = ENABLED;
+    cyBle_busyStatus = CYBLE_STACK_STATE_BUSY;
+    values = testValues;
+    for(i = 0u; (i < BATTERY_TIMEOUT) && (testValues == values); i++)
+    {
+        MeasureBattery();
+    }
+    TEST_EQUAL(basNtfPending, ENABLED);
+    BasDisconnected();
+    TEST_EQUAL(basNtfPending, DISABLED);
+    TEST_EQUAL(batteryMeasure, DISABLED);
+
+    cyBle_busyStatus = CYBLE_STACK_STATE_FREE;
+    batteryMeasure = ENABLED;
+    batteryNtfLevel = BATTERY_LEVEL_INVALID;
+    testNotifications = 0u;
+    for(i = 0u; (i < BATTERY_TIMEOUT) && (testNotifications == 0u); i++)
+    {
+        values = testValues;
+        MeasureBattery();
+    }
+    testQuiet = DISABLED;
+    TEST_EQUAL(testNotifications, 1u);
+    TEST_EQUAL(testValues, values + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: main
+********************************************************************************
+*
+* Summary:
+*   Compares the table with the formula for every ADC code. Within the table
+*   the voltage may differ by the interpolation error; outside it the
+*   voltage is clamped to the first or last entry.
+*
+*******************************************************************************/
+int main(void)
+{
+    int32 code;
+    int32 mvolts;
+    int32 expected;
+    int32 error;
+    int32 maxError = 0;
+    int32 levelError;
+    int32 maxLevelError = 0;
+    uint32 levelDiffers = 0u;
+    uint16 measured = 0u;
+
+    for(code = 1; code <= TEST_ADC_CODE_MAX; code++)
+    {
+        mvolts = BasAdcToMvolts((int16)code);
+        expected = BAS_ADC_TO_MV(code);
+        if(code < BAS_LUT_ADC_MIN)
+        {
+            TEST_EQUAL(mvolts, basMvoltsLut[0u]);
+            TEST_CHECK(mvolts < expected);
+        }
+        else if(code > TEST_LUT_ADC_MAX)
+        {
+            TEST_EQUAL(mvolts, basMvoltsLut[BAS_LUT_SIZE - 1u]);
+            TEST_CHECK(mvolts > expected);
+        }
+        else
+        {
+            error = (mvolts > expected) ? (mvolts - expected) : (expected - mvolts);
+            maxError = (error > maxError) ? error : maxError;
+            if(TEST_CHECK(error <= TEST_MVOLTS_ERROR) == DISABLED)
+            {
+                printf("ADC code %ld: %ld mV, expected %ld mV \r\n", code, mvolts, expected);
+            }
+        }
+
+        levelError = (int32)BasMvoltsToLevel((uint16)mvolts) - TestLevel(expected);
+        levelError = (levelError < 0) ? -levelError : levelError;
+        maxLevelError = (levelError > maxLevelError) ? levelError : maxLevelError;
+        if(levelError != 0)
+        {
+            levelDiffers++;
+        }
+        if(TEST_CHECK(levelError <= TEST_LEVEL_ERROR) == DISABLED)
+        {
+            printf("ADC code %ld: level %d, expected %ld \r\n", code, BasMvoltsToLevel((uint16)mvolts),
+                TestLevel(expected));
+        }
+    }
+
+    /* Every voltage of the profile maps into 0..100 % and does not decrease */
+    for(mvolts = 0; mvolts < 4000; mvolts++)
+    {
+        TEST_CHECK(BasMvoltsToLevel((uint16)mvolts) <= CYBLE_BAS_MAX_BATTERY_LEVEL_VALUE);
+        if(mvolts > 0)
+        {
+            TEST_CHECK(BasMvoltsToLevel((uint16)mvolts) >= BasMvoltsToLevel((uint16)(mvolts - 1)));
+        }
+    }
+    TEST_EQUAL(BasMvoltsToLevel(MEASURE_BATTERY_MIN), 0);
+    TEST_EQUAL(BasMvoltsToLevel(MEASURE_BATTERY_MID), MEASURE_BATTERY_MID_PERCENT);
+    TEST_EQUAL(BasMvoltsToLevel(MEASURE_BATTERY_MAX), CYBLE_BAS_MAX_BATTERY_LEVEL_VALUE);
+
+    /* The measurement converts through the same table */
+    testAdcResult = 700;
+    TEST_EQUAL(BasReadMvolts(&measured), ENABLED);
+    TEST_EQUAL(measured, BasAdcToMvolts(700));
+
+    /* The statistics and the notification age advance on the timer tick, subscribed or not */
+    batteryNtfSuppressed = 5u;
+    for(code = 1; code < (int32)BATTERY_NTF_STAT_PERIOD; code++)
+    {
+        BasTick();
+    }
+    TEST_EQUAL(batteryNtfSuppressed, 5u);
+    BasTick();
+    TEST_EQUAL(batteryNtfSuppressedLastHour, 5u);
+    TEST_EQUAL(batteryNtfSuppressed, 0u);
+    TEST_EQUAL(basStaleTimer, BATTERY_NTF_MAX_STALE);
+
+    /* An unchanged level is notified on the first measurement after subscribing, once stale */
+    batteryNtfLevel = BasMvoltsToLevel(measured);
+    for(code = 0; code < (int32)BATTERY_TIMEOUT; code++)
+    {
+        MeasureBattery();
+    }
+    TEST_EQUAL(basStaleTimer, 0u);
+    TEST_EQUAL(batteryNtfSuppressed, 0u);
+    for(code = 0; code < (int32)BATTERY_TIMEOUT; code++)
+    {
+        BasTick();
+        MeasureBattery();
+    }
+    TEST_EQUAL(basStaleTimer, (BATTERY_NTF_HYSTERESIS != 0u) ? BATTERY_TIMEOUT : 0u);
+    TEST_EQUAL(batteryNtfSuppressed, (BATTERY_NTF_HYSTERESIS != 0u) ? 1u : 0u);
+
+    TestDischarge();
+    TestReconnect();
+
+    printf("Profile %d: voltage error at most %ld mV, level differs on %ld codes by at most %ld %% \r\n",
+        BAS_BATTERY_PROFILE, maxError, levelDiffers, maxLevelError);
+    return(TestResult("bas"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,296 @@
+/*******************************************************************************
+* File Name: test_blss.c
+*
+* Version 1.0
+*
+* Description:
+*  Runs the record upload against a simulated collector over a link that
+*  drops at random. A dropped link loses the indication in flight, or only
+*  its confirmation, and some disconnections are followed by a reset. The
+*  collector has to receive every record, with no gap, and a record again
+*  only after its confirmation was lost or had not been stored yet.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#include "blss.c"
+
+#define TEST_STEPS                  (200000u)
+#define TEST_BACKLOG_MAX            (150u)      /* Records not stored as confirmed, below the partition size */
+#define TEST_SEQ_MAX                (40000u)
+
+/* Chances per step, out of 1024 */
+#define TEST_P_APPEND               (96u)       /* A measurement is taken */
+#define TEST_P_CONFIRM              (512u)      /* The collector confirms the indication in flight */
+#define TEST_P_DISCONNECT           (12u)       /* The link drops */
+#define TEST_P_RECEIVED             (512u)      /* The indication in flight arrived, its confirmation did not */
+#define TEST_P_RESET                (256u)      /* The device resets while disconnected */
+#define TEST_P_RESET_CONNECTED      (2u)        /* The device resets during the connection */
+
+static uint32 testRandom = 1u;
+static uint8 testAir;                           /* Indication in flight */
+static uint32 testAirSeq;
+static uint8 testQuiet;
+static CYBLE_DATE_TIME_T testBase = {2015u, 6u, 1u, 8u, 0u, 0u};
+static uint32 testReceived[TEST_SEQ_MAX + 1u];  /* Times the collector received each record */
+static uint32 testLast;                         /* Newest record the collector has */
+static uint32 testConnLast;                     /* Newest record received on this connection */
+
+extern const uint8 recAckFlash[CY_FLASH_SIZEOF_ROW];
+
+
+/*******************************************************************************
+* Function Name: TestStoredAck
+********************************************************************************
+*
+* Summary:
+*   Returns the confirmed sequence number that survives a reset.
+*
+*******************************************************************************/
+static uint32 TestStoredAck(void)
+{
+    /* The compiler may keep an earlier read of the const row */
+    return(CY_GET_REG32(&((const REC_ACK_T *)recAckFlash)->acked[REC_USER_GUEST]));
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandom
+********************************************************************************
+*
+* Summary:
+*   Returns ENABLED with the given chance out of 1024.
+*
+*******************************************************************************/
+static uint8 TestRandom(uint32 chance)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((((testRandom >> 16u) & 0x3FFu) < chance) ? ENABLED : DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: UART_DEB_SpiUartWriteTxData
+********************************************************************************
+*
+* Summary:
+*   Discards the traces of the simulation.
+*
+*******************************************************************************/
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testQuiet == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_BlssSendIndication
+********************************************************************************
+*
+* Summary:
+*   Puts the measurement on the air. The collector tells the records apart
+*   by the time stamp, which is one minute per sequence number.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_BlssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_BLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    CYBLE_DATE_TIME_T time;
+
+    TEST_EQUAL(charIndex, CYBLE_BLS_BPM);
+    TEST_EQUAL(testAir, DISABLED);
+    time.year = CyBle_Get16ByPtr(&attrValue[7u]);
+    time.month = attrValue[9u];
+    time.day = attrValue[10u];
+    time.hours = attrValue[11u];
+    time.minutes = attrValue[12u];
+    time.seconds = attrValue[13u];
+    testAirSeq = ((RtcToEpoch(&time) - RtcToEpoch(&testBase)) / 60u) + 1u;
+    testAir = ENABLED;
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: RacpBusy
+********************************************************************************
+*
+* Summary:
+*   No record access control point procedure runs in this test.
+*
+*******************************************************************************/
+uint8 RacpBusy(void)
+{
+    return(DISABLED);
+}
+
+void RacpReportDone(uint8 rspCode)
+{
+    TEST_CHECK(DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCollect
+********************************************************************************
+*
+* Summary:
+*   The collector takes the record in flight. Within a connection the
+*   records have to come in order without a gap; a record it already has is
+*   allowed only across a disconnection and only if the confirmation of the
+*   device was lost or not stored.
+*
+*******************************************************************************/
+static void TestCollect(void)
+{
+    TEST_CHECK(testAirSeq <= (testLast + 1u));
+    TEST_CHECK(testAirSeq > testConnLast);
+    if(testAirSeq <= testLast)
+    {
+        TEST_CHECK(testAirSeq > TestStoredAck());
+    }
+    testReceived[testAirSeq]++;
+    testConnLast = testAirSeq;
+    testLast = (testAirSeq > testLast) ? testAirSeq : testLast;
+}
+
+
+/*******************************************************************************
+* Function Name: TestConnect
+********************************************************************************
+*
+* Summary:
+*   The collector connects, the indications are enabled from the bonding
+*   data.
+*
+*******************************************************************************/
+static void TestConnect(void)
+{
+    cyBle_state = CYBLE_STATE_CONNECTED;
+    testConnLast = 0u;
+    BlsConnected();
+    TEST_EQUAL(blsFlag & IND, IND);
+}
+
+
+/*******************************************************************************
+* Function Name: TestDisconnect
+********************************************************************************
+*
+* Summary:
+*   The link drops with the indication in flight lost on the way out or on
+*   the way back. The main loop stores the confirmations while
+*   disconnected, and the device may reset before the collector returns.
+*
+*******************************************************************************/
+static void TestDisconnect(void)
+{
+    if((testAir == ENABLED) && (TestRandom(TEST_P_RECEIVED) == ENABLED))
+    {
+        TestCollect();
+    }
+    testAir = DISABLED;
+    cyBle_state = CYBLE_STATE_DISCONNECTED;
+    (void)RecordAckStore();
+    if(TestRandom(TEST_P_RESET) == ENABLED)
+    {
+        RecordInit();
+    }
+    TestConnect();
+}
+
+
+int main(void)
+{
+    CYBLE_BLS_BPM_T bpm = blsBpm[0u];
+    uint32 step;
+    uint32 seq = 0u;
+    uint32 missing = 0u;
+    uint32 duplicates = 0u;
+    uint32 disconnects = 0u;
+    uint32 resets = 0u;
+
+    /* The collector has subscribed, the CCCD is restored on every connection */
+    CyBle_Set16ByPtr(CYBLE_GATT_DB_ATTR_GET_ATTR_GEN_PTR(cyBle_blss.charInfo[CYBLE_BLS_BPM].cccdHandle),
+        CYBLE_CCCD_INDICATION);
+    testQuiet = ENABLED;
+    RecordInit();
+    TestConnect();
+
+    for(step = 0u; step < TEST_STEPS; step++)
+    {
+        if((TestRandom(TEST_P_APPEND) == ENABLED) && (seq < TEST_SEQ_MAX) &&
+           ((seq - TestStoredAck()) < TEST_BACKLOG_MAX))
+        {
+            seq++;
+            bpm.time = testBase;
+            RtcAddSeconds(&bpm.time, (seq - 1u) * 60u);
+            TEST_EQUAL(RecordAppend(REC_USER_GUEST, &bpm), CYBLE_ERROR_OK);
+            TEST_EQUAL(RecordLastSeq(REC_USER_GUEST), seq);
+        }
+
+        BlsUpload();
+
+        if(TestRandom(TEST_P_DISCONNECT) == ENABLED)
+        {
+            disconnects++;
+            TestDisconnect();
+        }
+        else if(TestRandom(TEST_P_RESET_CONNECTED) == ENABLED)
+        {
+            /* Power lost: the confirmations since the last catch up are gone */
+            resets++;
+            testAir = DISABLED;
+            RecordInit();
+            TestConnect();
+        }
+        else if((testAir == ENABLED) && (TestRandom(TEST_P_CONFIRM) == ENABLED))
+        {
+            TestCollect();
+            testAir = DISABLED;
+            BlsCallBack(CYBLE_EVT_BLSS_INDICATION_CONFIRMED, NULL);
+        }
+    }
+
+    /* A last connection that stays up */
+    while((testLast < seq) && (step < (TEST_STEPS * 2u)))
+    {
+        BlsUpload();
+        if(testAir == ENABLED)
+        {
+            TestCollect();
+            testAir = DISABLED;
+            BlsCallBack(CYBLE_EVT_BLSS_INDICATION_CONFIRMED, NULL);
+        }
+        step++;
+    }
+    BlsUpload();
+    testQuiet = DISABLED;
+
+    for(step = 1u; step <= seq; step++)
+    {
+        missing += (testReceived[step] == 0u) ? 1u : 0u;
+        duplicates += (testReceived[step] > 1u) ? (testReceived[step] - 1u) : 0u;
+    }
+    TEST_CHECK(seq > (TEST_STEPS / 16u));
+    TEST_EQUAL(missing, 0u);
+    TEST_EQUAL(testLast, seq);
+    TEST_EQUAL(RecordAcked(REC_USER_GUEST), seq);
+    TEST_EQUAL(TestStoredAck(), seq);
+    TEST_EQUAL(testAir, DISABLED);
+
+    printf("Records %ld, disconnections %ld, resets while connected %ld: missing %ld, sent again %ld \r\n",
+        seq, disconnects, resets, missing, duplicates);
+    return(TestResult("blss"));
+}
+
+
+/* [] END OF FILE */
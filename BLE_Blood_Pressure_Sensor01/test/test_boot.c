@@ -0,0 +1,292 @@
+/*******************************************************************************
+* File Name: test_boot.c
+*
+* Version 1.0
+*
+* Description:
+*  Boot profiler on a model of the SysTick: the start-up of main() and the
+*  stack is replayed with a cost per stage, through the StartAdvertisement()
+*  of the application, and the stamps, the reported time to advertise and
+*  the extension of the 24-bit counter are checked. The debug UART and the
+*  ADC must not be started on the way to the first advertisement.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "boot.c"
+#include "server.c"
+
+#define TEST_OUT_SIZE               (4096u)
+#define TEST_RUNS                   (1000u)
+#define TEST_TICKS_MAX              (CY_SYS_SYST_RVR_CNT_MASK)  /* Longest interval between two stamps */
+
+/* Cycles of each stage of the replayed start-up, at 48 MHz */
+#define TEST_CYCLES_MAIN            (480000u)   /* initialize_psoc(), 10 ms */
+#define TEST_CYCLES_BLE_START       (2400000u)  /* CyBle_Start(), 50 ms */
+#define TEST_CYCLES_APP_INIT        (960000u)   /* Services, records and timers, 20 ms */
+#define TEST_CYCLES_STACK_ON        (4800000u)  /* First CyBle_ProcessEvents() to the event, 100 ms */
+#define TEST_CYCLES_ADVERTISE       (96000u)    /* CyBle_GappStartAdvertisement(), 2 ms */
+
+const uint8 cyBle_attValuesCCCDFlashMemory[CYBLE_GAP_MAX_BONDED_DEVICE + 1u][CYBLE_GATT_DB_CCCD_COUNT];
+
+static char testOut[TEST_OUT_SIZE];
+static uint32 testOutLen;
+static uint8 testCapture;
+static uint32 testUartStarts;
+static uint32 testAdcStarts;
+static uint32 testClockInits;
+static CYBLE_API_RESULT_T testAdvResult;
+static uint32 testRandom = 7u;
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return(((testRandom >> 8u) | (testRandom << 24u)) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestAdvance
+********************************************************************************
+*
+* Summary:
+*   Runs the SysTick model for the cycles, counting down and wrapping at
+*   24 bits.
+*
+*******************************************************************************/
+static void TestAdvance(uint32 cycles)
+{
+    testReg.systCvr = (testReg.systCvr - cycles) & CY_SYS_SYST_RVR_CNT_MASK;
+}
+
+
+/***************************************
+*       Components and BLE stack
+***************************************/
+void UART_DEB_Start(void)
+{
+    UART_DEB_initVar = 1u;
+    testUartStarts++;
+}
+
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testCapture == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+    else if(testOutLen < (TEST_OUT_SIZE - 1u))
+    {
+        testOut[testOutLen] = (char)txData;
+        testOutLen++;
+    }
+    else
+    {
+        /* A longer output fails on the missing report */
+    }
+}
+
+void ADC_Start(void)
+{
+    testAdcStarts++;
+}
+
+void ClockInit(void)
+{
+    testClockInits++;
+}
+
+CYBLE_API_RESULT_T CyBle_GappStartAdvertisement(uint8 advertisingIntervalType)
+{
+    TestAdvance(TEST_CYCLES_ADVERTISE);
+    return(testAdvResult);
+}
+
+CYBLE_API_RESULT_T CyBle_GetDeviceAddress(CYBLE_GAP_BD_ADDR_T* bdAddr)
+{
+    (void)memset(bdAddr, 0xA5, sizeof(CYBLE_GAP_BD_ADDR_T));
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: TestTimeToAdvertise
+********************************************************************************
+*
+* Summary:
+*   Returns the time to advertise printed by BootPrint(), or 0 if it was not
+*   printed, and checks that it is printed at most once.
+*
+*******************************************************************************/
+static uint32 TestTimeToAdvertise(void)
+{
+    static const char label[] = "Time to advertise: ";
+    const char *line;
+    unsigned long us = 0u;
+
+    testOut[testOutLen] = '\0';
+    line = strstr(testOut, label);
+    if(line != NULL)
+    {
+        (void)sscanf(&line[sizeof(label) - 1u], "%lu", &us);
+        TEST_CHECK(strstr(&line[1u], label) == NULL);
+    }
+    return((uint32)us);
+}
+
+
+/*******************************************************************************
+* Function Name: TestStartUp
+********************************************************************************
+*
+* Summary:
+*   Replays the start-up of main() up to the first advertisement, with a
+*   first advertisement request the stack rejects. Checks the stamps, the
+*   reported time to advertise, and that nothing started the debug UART or
+*   the ADC before the advertisement.
+*
+*******************************************************************************/
+static void TestStartUp(void)
+{
+    uint32 expected;
+
+    testReg.systCvr = CY_SYS_SYST_RVR_CNT_MASK;
+    BootReset();
+    TestAdvance(TEST_CYCLES_MAIN);
+    TEST_EQUAL(BootStamp(BOOT_STAGE_MAIN), ENABLED);
+    TestAdvance(TEST_CYCLES_BLE_START);
+    TEST_EQUAL(BootStamp(BOOT_STAGE_BLE_START), ENABLED);
+    ServerCccdInit();
+    TestAdvance(TEST_CYCLES_APP_INIT);
+    TEST_EQUAL(BootStamp(BOOT_STAGE_APP_INIT), ENABLED);
+    TEST_EQUAL(testUartStarts, 0u);
+    TEST_EQUAL(testAdcStarts, 0u);
+
+    /* CYBLE_EVT_STACK_ON, the stack is not ready for the first request */
+    TestAdvance(TEST_CYCLES_STACK_ON);
+    TEST_EQUAL(BootStamp(BOOT_STAGE_STACK_ON), ENABLED);
+    testAdvResult = CYBLE_ERROR_INVALID_STATE;
+    testCapture = ENABLED;
+    StartAdvertisement();
+    testCapture = DISABLED;
+    TEST_EQUAL(bootStamped & (1u << BOOT_STAGE_ADVERTISE), 0u);
+    TEST_EQUAL(TestTimeToAdvertise(), 0u);
+    TEST_EQUAL(testClockInits, 0u);
+
+    /* The error trace is the first use of the UART */
+    TEST_EQUAL(testUartStarts, 1u);
+
+    testAdvResult = CYBLE_ERROR_OK;
+    testCapture = ENABLED;
+    StartAdvertisement();
+    testCapture = DISABLED;
+    expected = TEST_CYCLES_MAIN + TEST_CYCLES_BLE_START + TEST_CYCLES_APP_INIT + TEST_CYCLES_STACK_ON +
+        (2u * TEST_CYCLES_ADVERTISE);
+    TEST_EQUAL(bootStamp[BOOT_STAGE_MAIN], TEST_CYCLES_MAIN);
+    TEST_EQUAL(bootStamp[BOOT_STAGE_STACK_ON], expected - (2u * TEST_CYCLES_ADVERTISE));
+    TEST_EQUAL(bootStamp[BOOT_STAGE_ADVERTISE], expected);
+    TEST_EQUAL(TestTimeToAdvertise(), expected / BOOT_CYCLES_PER_US);
+    TEST_EQUAL(testClockInits, 1u);
+    TEST_EQUAL(testUartStarts, 1u);
+    TEST_EQUAL(testAdcStarts, 0u);
+
+    /* Later advertisements, after a disconnect, neither stamp nor report */
+    TestAdvance(TEST_TICKS_MAX);
+    TEST_EQUAL(BootStamp(BOOT_STAGE_STACK_ON), DISABLED);
+    testCapture = ENABLED;
+    StartAdvertisement();
+    testCapture = DISABLED;
+    TEST_EQUAL(bootStamp[BOOT_STAGE_ADVERTISE], expected);
+    TEST_EQUAL(TestTimeToAdvertise(), expected / BOOT_CYCLES_PER_US);
+    TEST_EQUAL(testClockInits, 1u);
+
+    /* The first battery measurement starts the ADC, once */
+    TEST_EQUAL(BootAdcStart(), ENABLED);
+    TEST_EQUAL(BootAdcStart(), DISABLED);
+    TEST_EQUAL(testAdcStarts, 1u);
+    TEST_EQUAL(testUartStarts, 1u);
+
+    printf("Time to advertise of the replayed start-up: %ld us \r\n", expected / BOOT_CYCLES_PER_US);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCounter
+********************************************************************************
+*
+* Summary:
+*   Stamps the stages after random intervals up to the SysTick period, from
+*   a random counter value, so that the boot wraps the 24-bit counter many
+*   times. Every stamp must be the sum of the intervals before it.
+*
+*******************************************************************************/
+static void TestCounter(void)
+{
+    uint32 cycles[BOOT_STAGE_COUNT];
+    uint32 run;
+    uint32 interval;
+    uint32 part;
+    uint32 errors = 0u;
+    uint32 wraps = 0u;
+    uint8 stage;
+
+    for(run = 0u; run < TEST_RUNS; run++)
+    {
+        testReg.systCvr = TestRand(CY_SYS_SYST_RVR_CNT_MASK + 1u);
+        BootReset();
+        cycles[BOOT_STAGE_RESET] = 0u;
+        for(stage = BOOT_STAGE_MAIN; stage < BOOT_STAGE_COUNT; stage++)
+        {
+            interval = TestRand(TEST_TICKS_MAX + 1u);
+            wraps += (interval > testReg.systCvr) ? 1u : 0u;
+
+            /* The previous stage, stamped again on the way, keeps its first time */
+            part = TestRand(interval + 1u);
+            TestAdvance(part);
+            errors += (BootStamp((BOOT_STAGE_T)(stage - 1u)) == DISABLED) ? 0u : 1u;
+            TestAdvance(interval - part);
+            errors += (BootStamp((BOOT_STAGE_T)stage) == ENABLED) ? 0u : 1u;
+            cycles[stage] = cycles[stage - 1u] + interval;
+        }
+        for(stage = 0u; stage < BOOT_STAGE_COUNT; stage++)
+        {
+            errors += (bootStamp[stage] == cycles[stage]) ? 0u : 1u;
+        }
+    }
+    TEST_EQUAL(errors, 0u);
+    TEST_CHECK(wraps > TEST_RUNS);
+
+    /* Without the .preinit_array entry, the first stamp starts the profiler */
+    bootStamped = 0u;
+    testReg.systCvr = 0x123456u;
+    TEST_EQUAL(BootStamp(BOOT_STAGE_MAIN), ENABLED);
+    TEST_EQUAL(bootStamp[BOOT_STAGE_MAIN], 0u);
+    TEST_EQUAL(bootStamped, (1u << BOOT_STAGE_RESET) | (1u << BOOT_STAGE_MAIN));
+}
+
+
+int main(void)
+{
+    TestStartUp();
+    TestCounter();
+
+    return(TestResult("boot"));
+}
+
+
+/* [] END OF FILE */
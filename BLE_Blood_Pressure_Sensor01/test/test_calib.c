@@ -0,0 +1,169 @@
+/*******************************************************************************
+* File Name: test_calib.c
+*
+* Version 1.0
+*
+* Description:
+*  Calibrates a simulated pressure transducer whose transfer function bows
+*  away from a straight line, and checks the correction table against the
+*  applied pressure over the whole range. A three-point calibration has to
+*  take out most of the bow a two-point calibration leaves.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#include "calib.c"
+
+/* Transducer: counts = offset + gain * p + bow * p * (300 - p), p in mmHg */
+#define TEST_SENSOR_OFFSET          (180)       /* Counts at 0 mmHg */
+#define TEST_SENSOR_GAIN_Q8         (1450)      /* Counts per mmHg, Q8 */
+#define TEST_SENSOR_BOW_Q16         (73)        /* Non-linearity, Q16: 25 counts or 4 mmHg at 150 mmHg */
+#define TEST_SENSOR_NOISE           (3)         /* Counts, peak, averaged out by the capture */
+
+#define TEST_P_MAX                  (300)
+#define TEST_ERROR_2POINT           (5 << CAL_Q)    /* Bound of the bow left by two points */
+#define TEST_ERROR_3POINT           (3 << (CAL_Q - 1u)) /* 1.5 mmHg */
+
+static int32 testPressure;                      /* Applied pressure, mmHg */
+static uint32 testNoise = 1u;
+
+
+/*******************************************************************************
+* Function Name: TestCounts
+********************************************************************************
+*
+* Summary:
+*   The transfer function of the simulated transducer, without noise.
+*
+*******************************************************************************/
+static int32 TestCounts(int32 pressure)
+{
+    return(TEST_SENSOR_OFFSET + ((pressure * TEST_SENSOR_GAIN_Q8) >> 8) +
+           ((pressure * (TEST_P_MAX - pressure) * TEST_SENSOR_BOW_Q16) >> 16));
+}
+
+
+/*******************************************************************************
+* Function Name: ADC_GetResult16
+********************************************************************************
+*
+* Summary:
+*   Converts the applied pressure with symmetric noise, which the sixteen
+*   averaged conversions of a capture cancel.
+*
+*******************************************************************************/
+int16 ADC_GetResult16(uint32 chan)
+{
+    static const int8 noise[4u] = {TEST_SENSOR_NOISE, -TEST_SENSOR_NOISE, 1, -1};
+
+    TEST_EQUAL(chan, ADC_PRESSURE_CHANNEL);
+    testNoise++;
+    return((int16)(TestCounts(testPressure) + noise[testNoise & 3u]));
+}
+
+
+/*******************************************************************************
+* Function Name: TestMaxError
+********************************************************************************
+*
+* Summary:
+*   Sweeps the applied pressure over the range and returns the largest
+*   difference of the corrected reading, in 1/16 mmHg.
+*
+*******************************************************************************/
+static int32 TestMaxError(void)
+{
+    int32 pressure;
+    int32 error;
+    int32 maxError = 0;
+
+    for(pressure = 0; pressure <= TEST_P_MAX; pressure++)
+    {
+        error = CalApply((int16)TestCounts(pressure)) - (pressure << CAL_Q);
+        error = (error < 0) ? -error : error;
+        maxError = (error > maxError) ? error : maxError;
+    }
+    return(maxError);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCapture
+********************************************************************************
+*
+* Summary:
+*   Applies the reference pressure of the point and captures it.
+*
+*******************************************************************************/
+static void TestCapture(uint8 point)
+{
+    testPressure = calRefPoint[point];
+    CalCapture(point);
+    TEST_EQUAL(calRecord.adc[point], TestCounts(testPressure));
+}
+
+
+int main(void)
+{
+    int32 error2;
+    int32 error3;
+    uint8 point;
+
+    /* Erased flash: the nominal transfer function */
+    CalInit();
+    TEST_EQUAL(calValid, DISABLED);
+    TEST_EQUAL(CalApply(CAL_ADC_MAX), (CAL_ADC_MAX * CAL_NOMINAL_MUL) >> CAL_NOMINAL_SHIFT);
+    TEST_EQUAL(CalApply(-5), 0);
+
+    /* One point, or points that do not increase, are refused */
+    TestCapture(0u);
+    TEST_EQUAL(CalStore(), CYBLE_ERROR_INVALID_PARAMETER);
+    calRecord.adc[2u] = calRecord.adc[0u];
+    calRecord.ref[2u] = CAL_REF_POINT2;
+    calRecord.points |= 1u << 2u;
+    TEST_EQUAL(CalStore(), CYBLE_ERROR_INVALID_PARAMETER);
+    TEST_EQUAL(calValid, DISABLED);
+
+    /* Two points: exact at the ends, the bow remains in between */
+    TestCapture(2u);
+    TEST_EQUAL(CalStore(), CYBLE_ERROR_OK);
+    TEST_EQUAL(calValid, ENABLED);
+    TEST_EQUAL(CalApply((int16)TestCounts(CAL_REF_POINT0)), CAL_REF_POINT0 << CAL_Q);
+    TEST_EQUAL(CalApply((int16)TestCounts(CAL_REF_POINT2)), CAL_REF_POINT2 << CAL_Q);
+    error2 = TestMaxError();
+    TEST_CHECK(error2 <= TEST_ERROR_2POINT);
+
+    /* Three points */
+    TestCapture(1u);
+    TEST_EQUAL(CalStore(), CYBLE_ERROR_OK);
+    for(point = 0u; point < CAL_POINTS_MAX; point++)
+    {
+        TEST_EQUAL(CalApply((int16)TestCounts(calRefPoint[point])), calRefPoint[point] << CAL_Q);
+    }
+    error3 = TestMaxError();
+    TEST_CHECK(error3 <= TEST_ERROR_3POINT);
+    TEST_CHECK((error3 * 2) < error2);
+
+    /* The table survives a reset, a damaged record falls back to nominal */
+    (void)memset(&calRecord, 0, sizeof(calRecord));
+    CalInit();
+    TEST_EQUAL(calValid, ENABLED);
+    TEST_EQUAL(TestMaxError(), error3);
+    calRecord.adc[1u]++;
+    (void)CyBle_StoreAppData((uint8 *)&calRecord, calRecordFlash, sizeof(calRecord), 0u);
+    CalInit();
+    TEST_EQUAL(calValid, DISABLED);
+
+    printf("Non-linearity %d mmHg: two-point error %ld/16 mmHg, three-point error %ld/16 mmHg \r\n",
+        (int16)((TestCounts(TEST_P_MAX / 2) - ((TestCounts(0) + TestCounts(TEST_P_MAX)) / 2)) * 256 /
+                TEST_SENSOR_GAIN_Q8), error2, error3);
+    return(TestResult("calib"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,246 @@
+/*******************************************************************************
+* File Name: test_clock.c
+*
+* Version 1.0
+*
+* Description:
+*  System clock manager with a model of SYSCLK, the flash wait states and
+*  the WDT. The flash must never be slower than SYSCLK, bursts nest and
+*  time their cycles across the 24-bit SysTick wrap. A measurement period,
+*  a computation burst, time bound BLE housekeeping and Deep Sleep for the
+*  rest of the second, is run through the energy accounting at each
+*  operating point and with the clock manager, and the charge per
+*  measurement is reported and checked against ClockCharge().
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <stdlib.h>
+#include "test.h"
+#include "clock.c"
+#include "energy.c"
+
+#define TEST_MEASUREMENTS           (1000u)
+#define TEST_PERIOD_TICKS           (1u << WDT_TICKS_SHIFT)     /* One measurement per second */
+#define TEST_HOUSEKEEPING_TICKS     (66u)       /* BLE event handling, about 2 ms whatever the clock */
+#define TEST_BURST_CYCLES           (CLOCK_MODEL_CYCLES)        /* Filter and estimation of a measurement */
+#define TEST_TOLERANCE              (50)        /* nAs, rounding of ClockCharge() and of the accounting */
+
+/* Policies of the energy model */
+#define TEST_POLICY_LOW             (0u)        /* Everything at the low operating point */
+#define TEST_POLICY_HIGH            (1u)        /* Everything at full speed */
+#define TEST_POLICY_MANAGED         (2u)        /* Bursts at full speed, housekeeping at the low point */
+#define TEST_POLICY_COUNT           (3u)
+
+static uint32 testTicks;
+static uint32 testTicksFrac;                    /* Cycles * WDT ticks per second below one tick */
+static uint32 testSysclkMhz = CYDEV_BCLK__HFCLK__MHZ;
+static uint32 testFlashMhz = CYDEV_BCLK__HFCLK__MHZ;
+static uint32 testSlowFlash;                    /* Clock changes with the flash slower than SYSCLK */
+static uint32 testSwitches;
+
+
+/***************************************
+*       Components
+***************************************/
+uint32 WDT_ReadTicks(void)
+{
+    return(testTicks);
+}
+
+void CySysClkWriteSysclkDiv(uint32 divider)
+{
+    testSysclkMhz = CYDEV_BCLK__HFCLK__MHZ >> divider;
+    testSlowFlash += (testFlashMhz < testSysclkMhz) ? 1u : 0u;
+    testSwitches++;
+}
+
+void CySysFlashSetWaitCycles(uint32 freq)
+{
+    testFlashMhz = freq;
+    testSlowFlash += (testFlashMhz < testSysclkMhz) ? 1u : 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: TestRun
+********************************************************************************
+*
+* Summary:
+*   Runs the CPU for the cycles at the current SYSCLK: SysTick counts them
+*   and the WDT advances by their time.
+*
+*******************************************************************************/
+static void TestRun(uint32 cycles)
+{
+    uint64 frac = ((uint64)cycles << WDT_TICKS_SHIFT) + testTicksFrac;
+    uint64 perTick = (uint64)testSysclkMhz * 1000000u;
+
+    testReg.systCvr = (testReg.systCvr - cycles) & CY_SYS_SYST_RVR_CNT_MASK;
+    testTicks += (uint32)(frac / perTick);
+    testTicksFrac = (uint32)(frac % perTick);
+}
+
+
+/*******************************************************************************
+* Function Name: TestSwitching
+********************************************************************************
+*
+* Summary:
+*   Operating point changes, nested bursts and the burst length.
+*
+*******************************************************************************/
+static void TestSwitching(void)
+{
+    testReg.systCvr = 0x000100u;
+    TEST_EQUAL(ClockGetLevel(), CLOCK_HIGH);
+    ClockInit();
+    TEST_EQUAL(ClockGetLevel(), CLOCK_LOW);
+    TEST_EQUAL(testSysclkMhz, CLOCK_LOW_MHZ);
+    TEST_EQUAL(energyModeCurrent[ENERGY_MODE_ACTIVE], CLOCK_UA_LOW);
+
+    /* An unmatched exit leaves the clock alone */
+    ClockBurstExit();
+    TEST_EQUAL(ClockGetLevel(), CLOCK_LOW);
+
+    ClockBurstEnter();
+    TEST_EQUAL(testSysclkMhz, CLOCK_HIGH_MHZ);
+    TEST_EQUAL(energyModeCurrent[ENERGY_MODE_ACTIVE], CLOCK_UA_HIGH);
+    TestRun(1000u);
+    ClockBurstEnter();
+    TestRun(2000u);
+    ClockBurstExit();
+    TEST_EQUAL(ClockGetLevel(), CLOCK_HIGH);
+    TestRun(3000u);
+    ClockBurstExit();
+    TEST_EQUAL(ClockGetLevel(), CLOCK_LOW);
+    TEST_EQUAL(testSysclkMhz, CLOCK_LOW_MHZ);
+    TEST_EQUAL(energyModeCurrent[ENERGY_MODE_ACTIVE], CLOCK_UA_LOW);
+
+    /* The burst started before the SysTick wrapped */
+    TEST_EQUAL(clockBurstCycles, 6000u);
+    TEST_EQUAL(clockBursts, 1u);
+    TEST_EQUAL(testSwitches, 3u);
+    TEST_EQUAL(testSlowFlash, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestMeasurement
+********************************************************************************
+*
+* Summary:
+*   Runs the measurement periods with the policy through the energy
+*   accounting and returns the charge per measurement, nAs.
+*
+*******************************************************************************/
+static uint32 TestMeasurement(uint32 policy)
+{
+    uint32 start;
+    uint32 end;
+    uint32 charge;
+    uint32 i;
+
+    ClockSet((policy == TEST_POLICY_HIGH) ? CLOCK_HIGH : CLOCK_LOW);
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    start = energyCharge;
+    for(i = 0u; i < TEST_MEASUREMENTS; i++)
+    {
+        end = testTicks + TEST_PERIOD_TICKS;
+        if(policy == TEST_POLICY_MANAGED)
+        {
+            ClockBurstEnter();
+            TestRun(TEST_BURST_CYCLES);
+            ClockBurstExit();
+        }
+        else
+        {
+            TestRun(TEST_BURST_CYCLES);
+        }
+        testTicks += TEST_HOUSEKEEPING_TICKS;
+
+        EnergySetMode(ENERGY_MODE_DEEPSLEEP, 0u);
+        testTicks = end;
+        EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    }
+    charge = energyCharge - start;
+    return((uint32)(((uint64)charge * 1000u) / TEST_MEASUREMENTS));
+}
+
+
+/*******************************************************************************
+* Function Name: TestEnergy
+********************************************************************************
+*
+* Summary:
+*   Charge per measurement at each operating point and with the clock
+*   manager. The burst alone has to match ClockCharge(), computation has to
+*   be cheaper at full speed and housekeeping at the low point, so the
+*   manager has to beat both fixed operating points.
+*
+*******************************************************************************/
+static void TestEnergy(void)
+{
+    static const char *const name[TEST_POLICY_COUNT] = {"low", "high", "managed"};
+    uint32 charge[TEST_POLICY_COUNT];
+    uint32 burst[CLOCK_LEVEL_COUNT];
+    uint32 housekeeping[CLOCK_LEVEL_COUNT];
+    uint32 sleep[CLOCK_LEVEL_COUNT];
+    uint32 ticks;
+    uint32 level;
+    uint32 policy;
+
+    testTicks = 0xFFFF0000u;
+    EnergyInit();
+    for(policy = 0u; policy < TEST_POLICY_COUNT; policy++)
+    {
+        charge[policy] = TestMeasurement(policy);
+    }
+
+    /* The parts of the period, nAs. Deep Sleep follows the burst at its operating point. */
+    for(level = 0u; level < CLOCK_LEVEL_COUNT; level++)
+    {
+        burst[level] = ClockCharge((CLOCK_LEVEL_T)level, TEST_BURST_CYCLES);
+        housekeeping[level] = (uint32)(((uint64)TEST_HOUSEKEEPING_TICKS * clockPoint[level].current * 1000u) >>
+            WDT_TICKS_SHIFT);
+        ticks = (uint32)(((uint64)TEST_BURST_CYCLES << WDT_TICKS_SHIFT) / (clockPoint[level].mhz * 1000000u));
+        sleep[level] = (uint32)(((uint64)(TEST_PERIOD_TICKS - ticks - TEST_HOUSEKEEPING_TICKS) *
+            ENERGY_UA_DEEPSLEEP * 1000u) >> WDT_TICKS_SHIFT);
+    }
+    TEST_CHECK(burst[CLOCK_HIGH] < burst[CLOCK_LOW]);
+    TEST_CHECK(housekeeping[CLOCK_LOW] < housekeeping[CLOCK_HIGH]);
+
+    TEST_CHECK(abs((int32)charge[TEST_POLICY_LOW] -
+        (int32)(burst[CLOCK_LOW] + housekeeping[CLOCK_LOW] + sleep[CLOCK_LOW])) < TEST_TOLERANCE);
+    TEST_CHECK(abs((int32)charge[TEST_POLICY_HIGH] -
+        (int32)(burst[CLOCK_HIGH] + housekeeping[CLOCK_HIGH] + sleep[CLOCK_HIGH])) < TEST_TOLERANCE);
+    TEST_CHECK(abs((int32)charge[TEST_POLICY_MANAGED] -
+        (int32)(burst[CLOCK_HIGH] + housekeeping[CLOCK_LOW] + sleep[CLOCK_HIGH])) < TEST_TOLERANCE);
+    TEST_CHECK(charge[TEST_POLICY_MANAGED] < charge[TEST_POLICY_LOW]);
+    TEST_CHECK(charge[TEST_POLICY_MANAGED] < charge[TEST_POLICY_HIGH]);
+    TEST_EQUAL(testSlowFlash, 0u);
+
+    printf("Charge per measurement, %ld cycles, %ld ms housekeeping, 1 s period: \r\n", TEST_BURST_CYCLES,
+        (TEST_HOUSEKEEPING_TICKS * 1000u) >> WDT_TICKS_SHIFT);
+    for(policy = 0u; policy < TEST_POLICY_COUNT; policy++)
+    {
+        printf("  %s: %ld nAs \r\n", name[policy], charge[policy]);
+    }
+    ClockPrint();
+}
+
+
+int main(void)
+{
+    TestSwitching();
+    TestEnergy();
+
+    return(TestResult("clock"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,250 @@
+/*******************************************************************************
+* File Name: test_codec.c
+*
+* Version 1.0
+*
+* Description:
+*  Round trip of the waveform codec on synthetic cuff waveforms at the
+*  streaming rates, on full-scale spikes, white noise and alternating
+*  extremes, in the 20-byte notification payload and the largest block.
+*  Reports the compression against plain 12-bit packing and the host
+*  encode and decode time per sample.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <math.h>
+#include <time.h>
+#include "test.h"
+#include "codec.c"
+
+#define TEST_SECONDS                (30u)
+#define TEST_SAMPLES_MAX            (TEST_SECONDS * 1000u)
+#define TEST_PAYLOAD                (CYBLE_GATT_DEFAULT_MTU - 3u)   /* Notification payload of the default MTU */
+#define TEST_BLOCKS_MAX             (TEST_SAMPLES_MAX)
+#define TEST_SAMPLE_MIN             (-2048)
+#define TEST_SAMPLE_MAX             (2047)
+
+/* Signals */
+#define TEST_CUFF                   (0u)        /* Deflating cuff with oscillations and noise */
+#define TEST_CUFF_SPIKES            (1u)        /* The same with full-scale spikes */
+#define TEST_NOISE                  (2u)        /* White noise over the full range */
+#define TEST_EXTREMES               (3u)        /* Alternating full-scale extremes */
+#define TEST_CONSTANT               (4u)
+
+static int16 testIn[TEST_SAMPLES_MAX];
+static int16 testOut[TEST_SAMPLES_MAX];
+static uint8 testBlock[TEST_BLOCKS_MAX][TEST_PAYLOAD];
+static uint32 testRandom = 2u;
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((testRandom >> 8u) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestSignal
+********************************************************************************
+*
+* Summary:
+*   Generates the samples of the signal at the rate. The cuff deflates from
+*   180 to 45 mmHg at 6.82 counts per mmHg; the oscillations peak around
+*   95 mmHg at 1.2 beats per second.
+*
+*******************************************************************************/
+static void TestSignal(uint8 signal, uint32 rate, uint32 n)
+{
+    double t;
+    double p;
+    double v;
+    uint32 i;
+
+    for(i = 0u; i < n; i++)
+    {
+        t = (double)i / (double)rate;
+        p = 180.0 - (4.5 * t);
+        v = (p * 6.82) + (2.5 * 6.82 * exp(-pow((p - 95.0) / 30.0, 2.0)) * sin(2.0 * M_PI * 1.2 * t)) +
+            (double)TestRand(5u) - 2.0;
+        switch(signal)
+        {
+            case TEST_CUFF:
+                testIn[i] = (int16)lrint(v);
+                break;
+
+            case TEST_CUFF_SPIKES:
+                testIn[i] = ((i % 97u) == 0u) ? (int16)(TEST_SAMPLE_MIN + (int32)TestRand(4096u)) : (int16)lrint(v);
+                break;
+
+            case TEST_NOISE:
+                testIn[i] = (int16)(TEST_SAMPLE_MIN + (int32)TestRand(4096u));
+                break;
+
+            case TEST_EXTREMES:
+                testIn[i] = ((i & 1u) != 0u) ? TEST_SAMPLE_MIN : TEST_SAMPLE_MAX;
+                break;
+
+            default:
+                testIn[i] = 1234;
+                break;
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestRoundTrip
+********************************************************************************
+*
+* Summary:
+*   Encodes the samples into blocks of the size the way the waveform stream
+*   does, carrying k from block to block, decodes them and compares.
+*   Returns the number of blocks.
+*
+*******************************************************************************/
+static uint32 TestRoundTrip(uint32 n, uint8 size, uint32 *encodeNs, uint32 *decodeNs)
+{
+    static uint8 big[(TEST_SAMPLES_MAX / 2u) + 1u][CODEC_BLOCK_MAX];
+    CODEC_ENC_T enc;
+    struct timespec start;
+    struct timespec end;
+    uint8 *block;
+    uint32 blocks = 0u;
+    uint32 decoded = 0u;
+    uint32 mismatches = 0u;
+    uint32 minBits = (uint32)size * 8u;
+    uint32 i;
+    uint8 count;
+
+    block = (size <= TEST_PAYLOAD) ? testBlock[0u] : big[0u];
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    CodecStart(&enc, block, size, 0u, CODEC_K_INIT);
+    for(i = 0u; i < n; i++)
+    {
+        if(CodecPut(&enc, testIn[i]) == 0u)
+        {
+            blocks++;
+            block = (size <= TEST_PAYLOAD) ? testBlock[blocks] : big[blocks];
+            CodecStart(&enc, block, size, (uint16)blocks, enc.k);
+            (void)CodecPut(&enc, testIn[i]);
+        }
+    }
+    blocks++;
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    *encodeNs = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) / n);
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0u; i < blocks; i++)
+    {
+        block = (size <= TEST_PAYLOAD) ? testBlock[i] : big[i];
+        count = CodecDecode(block, size, &testOut[decoded], CODEC_COUNT_MAX);
+        TEST_EQUAL(count, block[CODEC_HDR_COUNT]);
+        TEST_EQUAL(block[CODEC_HDR_SEQ] | (block[CODEC_HDR_SEQ + 1u] << 8u), (uint16)i);
+
+        /* A full block: a sample takes at most the escape and a raw difference */
+        if(i < (blocks - 1u))
+        {
+            TEST_CHECK(count >= (1u + ((minBits - (CODEC_HDR_SIZE * 8u) - CODEC_SAMPLE_BITS) /
+                                       (CODEC_ESCAPE + CODEC_RAW_BITS))));
+        }
+        decoded += count;
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    *decodeNs = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) / n);
+
+    TEST_EQUAL(decoded, n);
+    for(i = 0u; i < n; i++)
+    {
+        mismatches += (testOut[i] == testIn[i]) ? 0u : 1u;
+    }
+    TEST_EQUAL(mismatches, 0u);
+    return(blocks);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCase
+********************************************************************************
+*
+* Summary:
+*   Runs the round trip of a signal and prints the samples per block, the
+*   ratio to 12-bit packing of the same payload and the time per sample.
+*   Returns the ratio in hundredths.
+*
+*******************************************************************************/
+static uint32 TestCase(const char *name, uint8 signal, uint32 rate, uint8 size)
+{
+    uint32 n = TEST_SECONDS * rate;
+    uint32 blocks;
+    uint32 encodeNs;
+    uint32 decodeNs;
+    uint32 ratio;
+
+    TestSignal(signal, rate, n);
+    blocks = TestRoundTrip(n, size, &encodeNs, &decodeNs);
+
+    /* Against the samples plain 12-bit packing fits behind the same header */
+    ratio = (n * 100u) / (blocks * (((uint32)(size - CODEC_HDR_SIZE) * 8u) / CODEC_SAMPLE_BITS));
+    printf("%s, %ld samples/s, %d-byte blocks: %ld samples per block, ratio %ld.%02ld, "
+        "encode %ld ns, decode %ld ns per sample \r\n", name, rate, size, n / blocks, ratio / 100u, ratio % 100u,
+        encodeNs, decodeNs);
+    return(ratio);
+}
+
+
+int main(void)
+{
+    int16 samples[CODEC_COUNT_MAX];
+    CODEC_ENC_T enc;
+    uint8 block[TEST_PAYLOAD];
+
+    /* The stream: cuff waveforms in the notification payload */
+    TEST_CHECK(TestCase("Cuff", TEST_CUFF, 100u, TEST_PAYLOAD) >= 250u);
+    TEST_CHECK(TestCase("Cuff", TEST_CUFF, 250u, TEST_PAYLOAD) >= 250u);
+    TEST_CHECK(TestCase("Cuff", TEST_CUFF, 1000u, TEST_PAYLOAD) >= 250u);
+    TEST_CHECK(TestCase("Cuff with spikes", TEST_CUFF_SPIKES, 1000u, TEST_PAYLOAD) >= 150u);
+
+    /* Worst cases stay exact and bounded */
+    TEST_CHECK(TestCase("White noise", TEST_NOISE, 1000u, TEST_PAYLOAD) >= 50u);
+    TEST_CHECK(TestCase("Alternating extremes", TEST_EXTREMES, 1000u, TEST_PAYLOAD) >= 50u);
+
+    /* The largest block: the uint8 sample count, not the bits, fills it */
+    TEST_CHECK(TestCase("Cuff", TEST_CUFF, 1000u, CODEC_BLOCK_MAX) >= 150u);
+    (void)TestCase("Constant", TEST_CONSTANT, 1000u, CODEC_BLOCK_MAX);
+    (void)TestCase("White noise", TEST_NOISE, 1000u, CODEC_BLOCK_MAX);
+
+    /* A block with room for the first sample only, truncated blocks, and a short sample buffer */
+    CodecStart(&enc, block, CODEC_HDR_SIZE + 2u, 7u, CODEC_K_INIT);
+    TEST_EQUAL(CodecPut(&enc, TEST_SAMPLE_MIN), 1u);
+    TEST_EQUAL(CodecPut(&enc, TEST_SAMPLE_MAX), 0u);
+    TEST_EQUAL(CodecDecode(block, CODEC_HDR_SIZE + 2u, samples, CODEC_COUNT_MAX), 1u);
+    TEST_EQUAL(samples[0u], TEST_SAMPLE_MIN);
+    TEST_EQUAL(CodecDecode(block, CODEC_HDR_SIZE - 1u, samples, CODEC_COUNT_MAX), 0u);
+    TestSignal(TEST_CUFF, 250u, 100u);
+    CodecStart(&enc, block, sizeof(block), 0u, CODEC_K_INIT);
+    while(CodecPut(&enc, testIn[enc.count]) != 0u)
+    {
+    }
+    TEST_EQUAL(CodecDecode(block, sizeof(block) - 4u, samples, CODEC_COUNT_MAX) < enc.count, 1u);
+    TEST_EQUAL(CodecDecode(block, sizeof(block), samples, 3u), 3u);
+    TEST_EQUAL(samples[2u], testIn[2u]);
+
+    return(TestResult("codec"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,351 @@
+/*******************************************************************************
+* File Name: test_debug.c
+*
+* Version 1.0
+*
+* Description:
+*  Compares the trace formatter with glibc snprintf: the formats of the
+*  firmware traces, random combinations of the flags, width, precision and
+*  length the formatter supports, the 32-bit extremes and strings longer
+*  than 255 characters. Reports the host time per trace of both.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include <time.h>
+#include "test.h"
+#include "debug.c"
+
+#define TEST_OUT_SIZE               (1024u)
+#define TEST_RANDOM_CASES           (200000u)
+#define TEST_TIMED_CALLS            (200000u)
+#define TEST_STR_LONG               (300u)      /* Longer than a uint8 count */
+
+static char testOut[TEST_OUT_SIZE];
+static uint32 testOutLen;
+static uint8 testCapture;
+static uint32 testRandom = 5u;
+static uint32 testMismatches;
+
+
+/*******************************************************************************
+* Function Name: UART_DEB_SpiUartWriteTxData
+********************************************************************************
+*
+* Summary:
+*   Captures the characters of the formatter while a case runs.
+*
+*******************************************************************************/
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testCapture == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+    else if(testOutLen < (TEST_OUT_SIZE - 1u))
+    {
+        testOut[testOutLen] = (char)txData;
+        testOutLen++;
+    }
+    else
+    {
+        /* A case longer than the buffer fails on the comparison */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((testRandom >> 8u) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCompare
+********************************************************************************
+*
+* Summary:
+*   Compares the captured trace and its count with the reference, prints
+*   the first mismatches.
+*
+*******************************************************************************/
+static void TestCompare(const char *format, const char *ref, int refCount, int count)
+{
+    testOut[testOutLen] = '\0';
+    testCapture = DISABLED;
+    if((strcmp(testOut, ref) != 0) || (count != refCount))
+    {
+        testMismatches++;
+        if(testMismatches <= 10u)
+        {
+            printf("Mismatch \"%s\": \"%s\" %d, snprintf \"%s\" %d \r\n", format, testOut, count, ref, refCount);
+        }
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestValue
+********************************************************************************
+*
+* Summary:
+*   Formats the 32-bit value with one conversion, passed as the type the
+*   conversion takes, and compares with snprintf.
+*
+*******************************************************************************/
+static void TestValue(const char *format, uint8 isLong, uint8 isSigned, uint32 value)
+{
+    char ref[TEST_OUT_SIZE];
+    int refCount;
+    int count;
+
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    if(isLong != DISABLED)
+    {
+        /* long is 32 bits on the Cortex-M0 */
+        if(isSigned != DISABLED)
+        {
+            refCount = snprintf(ref, sizeof(ref), format, (long)(int32)value);
+            count = DebugPrintf(format, (long)(int32)value);
+        }
+        else
+        {
+            refCount = snprintf(ref, sizeof(ref), format, (unsigned long)value);
+            count = DebugPrintf(format, (unsigned long)value);
+        }
+    }
+    else if(isSigned != DISABLED)
+    {
+        refCount = snprintf(ref, sizeof(ref), format, (int)(int32)value);
+        count = DebugPrintf(format, (int)(int32)value);
+    }
+    else
+    {
+        refCount = snprintf(ref, sizeof(ref), format, (unsigned int)value);
+        count = DebugPrintf(format, (unsigned int)value);
+    }
+    TestCompare(format, ref, refCount, count);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandomValue
+********************************************************************************
+*
+* Summary:
+*   Returns a value with a random number of significant bits, often one of
+*   the extremes.
+*
+*******************************************************************************/
+static uint32 TestRandomValue(void)
+{
+    static const uint32 extremes[] = {0u, 1u, 9u, 10u, 0x7FFFFFFFu, 0x80000000u, 0xFFFFFFFFu, 999999999u,
+        1000000000u, 4294967295u};
+    uint32 value;
+
+    if(TestRand(8u) == 0u)
+    {
+        value = extremes[TestRand(sizeof(extremes) / sizeof(extremes[0u]))];
+    }
+    else
+    {
+        value = (TestRand(0x10000u) << 16u) ^ TestRand(0x10000u);
+        value >>= TestRand(32u);
+        value = (TestRand(2u) == 0u) ? value : (0u - value);
+    }
+    return(value);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandomFormats
+********************************************************************************
+*
+* Summary:
+*   Builds random conversions from the flags, width, precision and length
+*   the formatter supports, between literal text. A precision of 0 is left
+*   out: C prints no digit for a zero value there, the formatter prints one.
+*
+*******************************************************************************/
+static void TestRandomFormats(void)
+{
+    static const char conversions[] = "diuxX";
+    static const char *const flags[] = {"", "-", "0", "-0", "0-"};
+    char format[32];
+    char conversion;
+    uint8 isLong;
+    uint32 len;
+    uint32 i;
+
+    for(i = 0u; i < TEST_RANDOM_CASES; i++)
+    {
+        conversion = conversions[TestRand(sizeof(conversions) - 1u)];
+        isLong = (TestRand(2u) == 0u) ? ENABLED : DISABLED;
+        len = (uint32)sprintf(format, "<%%%s", flags[TestRand(sizeof(flags) / sizeof(flags[0u]))]);
+        if(TestRand(2u) == 0u)
+        {
+            len += (uint32)sprintf(&format[len], "%u", (unsigned int)(1u + TestRand(14u)));
+        }
+        if(TestRand(2u) == 0u)
+        {
+            len += (uint32)sprintf(&format[len], ".%u", (unsigned int)(1u + TestRand(14u)));
+        }
+        (void)sprintf(&format[len], "%s%c> \r\n", (isLong != DISABLED) ? "l" : "", conversion);
+        TestValue(format, isLong, ((conversion == 'd') || (conversion == 'i')) ? ENABLED : DISABLED,
+            TestRandomValue());
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestStrings
+********************************************************************************
+*
+* Summary:
+*   Strings and characters, with width and precision, and a string longer
+*   than 255 characters.
+*
+*******************************************************************************/
+static void TestStrings(void)
+{
+    static const char *const formats[] = {"%s|", "%10s|", "%-10s|", "%.2s|", "%8.3s|", "%-8.3s|", "%1s|"};
+    static const char *const strs[] = {"", "a", "Blood Pressure", "0123456789"};
+    char longStr[TEST_STR_LONG + 1u];
+    char ref[TEST_OUT_SIZE];
+    int refCount;
+    int count;
+    uint32 f;
+    uint32 s;
+
+    for(f = 0u; f < (sizeof(formats) / sizeof(formats[0u])); f++)
+    {
+        for(s = 0u; s < (sizeof(strs) / sizeof(strs[0u])); s++)
+        {
+            testOutLen = 0u;
+            testCapture = ENABLED;
+            refCount = snprintf(ref, sizeof(ref), formats[f], strs[s]);
+            count = DebugPrintf(formats[f], strs[s]);
+            TestCompare(formats[f], ref, refCount, count);
+        }
+    }
+
+    for(s = 0u; s < TEST_STR_LONG; s++)
+    {
+        longStr[s] = (char)('a' + (s % 26u));
+    }
+    longStr[TEST_STR_LONG] = '\0';
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    refCount = snprintf(ref, sizeof(ref), "[%s]", longStr);
+    count = DebugPrintf("[%s]", longStr);
+    TestCompare("[%s]", ref, refCount, count);
+    TEST_EQUAL(count, TEST_STR_LONG + 2u);
+
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    refCount = snprintf(ref, sizeof(ref), "%c%c%-3c|%3c", 'B', 'P', 'x', 'y');
+    count = DebugPrintf("%c%c%-3c|%3c", 'B', 'P', 'x', 'y');
+    TestCompare("%c%c%-3c|%3c", ref, refCount, count);
+}
+
+
+/*******************************************************************************
+* Function Name: TestTraces
+********************************************************************************
+*
+* Summary:
+*   The conversions of the firmware traces on their value ranges.
+*
+*******************************************************************************/
+static void TestTraces(void)
+{
+    char ref[TEST_OUT_SIZE];
+    int refCount;
+    int count;
+    int32 v;
+
+    for(v = -70000; v <= 70000; v += 7)
+    {
+        testOutLen = 0u;
+        testCapture = ENABLED;
+        refCount = snprintf(ref, sizeof(ref), "Update: %d, %ld mV %x %lx %2.2x %6.6ld %lu \r\n", (int)v, (long)v,
+            (unsigned int)v, (unsigned long)(uint32)v, (unsigned int)(v & 0xFF), (long)v, (unsigned long)(uint32)v);
+        count = DebugPrintf("Update: %d, %ld mV %x %lx %2.2x %6.6ld %lu \r\n", (int)v, (long)v,
+            (unsigned int)v, (unsigned long)(uint32)v, (unsigned int)(v & 0xFF), (long)v, (unsigned long)(uint32)v);
+        TestCompare("traces", ref, refCount, count);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestTiming
+********************************************************************************
+*
+* Summary:
+*   Prints the host time per trace of the formatter, writing to the capture
+*   buffer, and of snprintf.
+*
+*******************************************************************************/
+static void TestTiming(void)
+{
+    char ref[TEST_OUT_SIZE];
+    struct timespec start;
+    struct timespec end;
+    uint32 i;
+    uint32 ns[2u];
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0u; i < TEST_TIMED_CALLS; i++)
+    {
+        testOutLen = 0u;
+        testCapture = ENABLED;
+        (void)DebugPrintf("MeasureBatteryLevelUpdate: %d, %d mV %2.2x %6.6ld \r\n", (int)(i & 0x7Fu),
+            (int)(2000u + i), (unsigned int)(i & 0xFFu), (long)i);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    testCapture = DISABLED;
+    ns[0u] = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) /
+        TEST_TIMED_CALLS);
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0u; i < TEST_TIMED_CALLS; i++)
+    {
+        (void)snprintf(ref, sizeof(ref), "MeasureBatteryLevelUpdate: %d, %d mV %2.2x %6.6ld \r\n", (int)(i & 0x7Fu),
+            (int)(2000u + i), (unsigned int)(i & 0xFFu), (long)i);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    ns[1u] = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) /
+        TEST_TIMED_CALLS);
+
+    printf("Trace formatting on the host: DebugPrintf %ld ns, glibc snprintf %ld ns \r\n", ns[0u], ns[1u]);
+}
+
+
+int main(void)
+{
+    TestTraces();
+    TestRandomFormats();
+    TestStrings();
+    TEST_EQUAL(testMismatches, 0u);
+    TestTiming();
+
+    return(TestResult("debug"));
+}
+
+
+/* [] END OF FILE */
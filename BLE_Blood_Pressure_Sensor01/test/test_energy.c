@@ -0,0 +1,315 @@
+/*******************************************************************************
+* File Name: test_energy.c
+*
+* Version 1.0
+*
+* Description:
+*  Energy accounting on a model of the WDT counter. Power mode transitions
+*  with their Deep Sleep blockers, subsystem busy periods and Active
+*  current changes are replayed across the wrap of the counter. The
+*  residency per mode and per blocker, the busy time per subsystem and the
+*  charge must match a reference accounting of the same periods, the
+*  report must survive a Hibernate through EnergyResume(), and the UART
+*  report must carry the totals.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "energy.c"
+
+#define TEST_SECOND_TICKS           (1u << WDT_TICKS_SHIFT)
+#define TEST_TRANSITIONS            (100000u)
+#define TEST_PERIOD_MAX             (3u * TEST_SECOND_TICKS)    /* Longest period in one mode */
+#define TEST_OUT_SIZE               (1024u)
+
+static uint32 testTicks;
+static uint32 testRandom = 5u;
+static char testOut[TEST_OUT_SIZE];
+static uint32 testOutLen;
+static uint8 testCapture;
+
+
+/***************************************
+*       Components
+***************************************/
+uint32 WDT_ReadTicks(void)
+{
+    return(testTicks);
+}
+
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testCapture == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+    else if(testOutLen < (TEST_OUT_SIZE - 1u))
+    {
+        testOut[testOutLen] = (char)txData;
+        testOutLen++;
+    }
+    else
+    {
+        /* A longer output fails on the missing totals */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return(((testRandom >> 8u) | (testRandom << 24u)) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestTicks
+********************************************************************************
+*
+* Summary:
+*   Returns the accumulated time in WDT ticks.
+*
+*******************************************************************************/
+static uint64 TestTicks(const ENERGY_TIME_T *time)
+{
+    return(((uint64)time->seconds << ENERGY_TICKS_SHIFT) + time->ticks);
+}
+
+
+/*******************************************************************************
+* Function Name: TestReset
+********************************************************************************
+*
+* Summary:
+*   Clears the accounting and starts it at the WDT count.
+*
+*******************************************************************************/
+static void TestReset(uint32 ticks)
+{
+    (void)memset(energyMode, 0, sizeof(energyMode));
+    (void)memset(energyBlock, 0, sizeof(energyBlock));
+    (void)memset(energyBlockCount, 0, sizeof(energyBlockCount));
+    (void)memset(energySub, 0, sizeof(energySub));
+    energyCharge = 0u;
+    energyChargeFrac = 0u;
+    energyModeCurrent[ENERGY_MODE_ACTIVE] = ENERGY_UA_ACTIVE;
+    testTicks = ticks;
+    EnergyInit();
+}
+
+
+/*******************************************************************************
+* Function Name: TestPeriods
+********************************************************************************
+*
+* Summary:
+*   A short sequence with known totals: Active, Sleep blocked by the UART
+*   and the ADC, Deep Sleep, an ADC conversion and a flash write, across
+*   the wrap of the WDT counter.
+*
+*******************************************************************************/
+static void TestPeriods(void)
+{
+    uint64 charge;
+
+    TestReset(0xFFFFF000u);
+    testTicks += 1000u;
+    EnergySetMode(ENERGY_MODE_SLEEP, ENERGY_BLOCK_MASK(ENERGY_BLOCK_UART_TX) | ENERGY_BLOCK_MASK(ENERGY_BLOCK_ADC));
+    testTicks += 2000u;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    EnergySubsystemStart(ENERGY_SUB_ADC);
+    testTicks += 500u;
+    EnergySubsystemStop(ENERGY_SUB_ADC);
+    EnergySetMode(ENERGY_MODE_DEEPSLEEP, 0u);
+    testTicks += 3u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    EnergySubsystemStart(ENERGY_SUB_FLASH);
+    testTicks += TEST_SECOND_TICKS;
+    EnergySubsystemStop(ENERGY_SUB_FLASH);
+    EnergySetMode(ENERGY_MODE_SLEEP, ENERGY_BLOCK_MASK(ENERGY_BLOCK_UART_TX));
+    testTicks += 768u;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_ACTIVE]), 1000u + 500u + TEST_SECOND_TICKS);
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_SLEEP]), 2000u + 768u);
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_DEEPSLEEP]), 3u * TEST_SECOND_TICKS);
+    TEST_EQUAL(TestTicks(&energyBlock[ENERGY_BLOCK_UART_TX]), 2000u + 768u);
+    TEST_EQUAL(TestTicks(&energyBlock[ENERGY_BLOCK_ADC]), 2000u);
+    TEST_EQUAL(TestTicks(&energyBlock[ENERGY_BLOCK_BLESS]), 0u);
+    TEST_EQUAL(energyBlockCount[ENERGY_BLOCK_UART_TX], 2u);
+    TEST_EQUAL(energyBlockCount[ENERGY_BLOCK_ADC], 1u);
+    TEST_EQUAL(TestTicks(&energySub[ENERGY_SUB_ADC]), 500u);
+    TEST_EQUAL(TestTicks(&energySub[ENERGY_SUB_FLASH]), TEST_SECOND_TICKS);
+
+    charge = ((uint64)(1000u + 500u + TEST_SECOND_TICKS) * ENERGY_UA_ACTIVE) +
+             ((uint64)(2000u + 768u) * ENERGY_UA_SLEEP) + ((uint64)(3u * TEST_SECOND_TICKS) * ENERGY_UA_DEEPSLEEP) +
+             ((uint64)500u * ENERGY_UA_ADC) + ((uint64)TEST_SECOND_TICKS * ENERGY_UA_FLASH);
+    TEST_EQUAL(energyCharge, (uint32)(charge >> WDT_TICKS_SHIFT));
+
+    /* The Active current of the clock manager applies from the change on */
+    EnergySetActiveCurrent(850u);
+    testTicks += TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_SLEEP, 0u);
+    charge += (uint64)TEST_SECOND_TICKS * 850u;
+    TEST_EQUAL(energyCharge, (uint32)(charge >> WDT_TICKS_SHIFT));
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandom
+********************************************************************************
+*
+* Summary:
+*   Random transitions, blockers and busy periods over more than a day,
+*   against a reference accounting in ticks. The charge must be the
+*   reference charge rounded down to a whole uAs.
+*
+*******************************************************************************/
+static void TestRandom(void)
+{
+    uint64 mode[ENERGY_MODE_COUNT] = {0u, 0u, 0u};
+    uint64 block[ENERGY_BLOCK_COUNT] = {0u, 0u, 0u, 0u, 0u};
+    uint32 blockCount[ENERGY_BLOCK_COUNT] = {0u, 0u, 0u, 0u, 0u};
+    uint64 adc = 0u;
+    uint64 charge = 0u;
+    uint32 errors = 0u;
+    uint32 blockers = 0u;
+    uint32 period;
+    uint32 busy;
+    uint32 next;
+    uint32 cur = ENERGY_MODE_ACTIVE;
+    uint32 i;
+    uint32 b;
+
+    TestReset(TestRand(0xFFFFFFFFu));
+    for(i = 0u; i < TEST_TRANSITIONS; i++)
+    {
+        period = TestRand(TEST_PERIOD_MAX) + 1u;
+        if(cur == ENERGY_MODE_ACTIVE)
+        {
+            /* An ADC conversion within the Active period */
+            busy = TestRand(period);
+            EnergySubsystemStart(ENERGY_SUB_ADC);
+            testTicks += busy;
+            EnergySubsystemStop(ENERGY_SUB_ADC);
+            testTicks += period - busy;
+            adc += busy;
+            charge += (uint64)busy * ENERGY_UA_ADC;
+            next = ENERGY_MODE_SLEEP + TestRand(2u);
+        }
+        else
+        {
+            testTicks += period;
+            next = ENERGY_MODE_ACTIVE;
+        }
+        mode[cur] += period;
+        charge += (uint64)period * energyModeCurrent[cur];
+        for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+        {
+            block[b] += ((blockers & ENERGY_BLOCK_MASK(b)) != 0u) ? period : 0u;
+        }
+
+        /* Sleep is entered for any set of blockers, Deep Sleep without */
+        blockers = (next == ENERGY_MODE_SLEEP) ? (TestRand(1u << (ENERGY_BLOCK_COUNT - 1u)) << 1u) : 0u;
+        EnergySetMode((ENERGY_MODE_T)next, blockers);
+        for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+        {
+            blockCount[b] += ((blockers & ENERGY_BLOCK_MASK(b)) != 0u) ? 1u : 0u;
+        }
+        cur = next;
+    }
+
+    for(i = 0u; i < ENERGY_MODE_COUNT; i++)
+    {
+        errors += (TestTicks(&energyMode[i]) == mode[i]) ? 0u : 1u;
+    }
+    for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+    {
+        errors += (TestTicks(&energyBlock[b]) == block[b]) ? 0u : 1u;
+        errors += (energyBlockCount[b] == blockCount[b]) ? 0u : 1u;
+    }
+    TEST_EQUAL(errors, 0u);
+    TEST_CHECK(TestTicks(&energySub[ENERGY_SUB_ADC]) == adc);
+    TEST_CHECK(blockCount[ENERGY_BLOCK_EVENT] != 0u);
+    TEST_EQUAL(energyCharge, (uint32)(charge >> WDT_TICKS_SHIFT));
+    TEST_CHECK(((mode[ENERGY_MODE_ACTIVE] + mode[ENERGY_MODE_SLEEP] + mode[ENERGY_MODE_DEEPSLEEP]) >>
+        WDT_TICKS_SHIFT) > 86400u);
+
+    printf("Energy accounting, %ld transitions over %ld s: %ld uAs, %ld ms adc busy \r\n", TEST_TRANSITIONS,
+        (uint32)((mode[ENERGY_MODE_ACTIVE] + mode[ENERGY_MODE_SLEEP] + mode[ENERGY_MODE_DEEPSLEEP]) >>
+        WDT_TICKS_SHIFT), energyCharge, EnergyTimeToMs(&energySub[ENERGY_SUB_ADC]));
+}
+
+
+/*******************************************************************************
+* Function Name: TestReport
+********************************************************************************
+*
+* Summary:
+*   The report saved before Hibernate continues after the wake, and the UART
+*   report prints the residency and the charge.
+*
+*******************************************************************************/
+static void TestReport(void)
+{
+    ENERGY_REPORT_T saved;
+    ENERGY_REPORT_T report;
+    char line[80];
+
+    TestReset(0u);
+    testTicks += 10u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_DEEPSLEEP, 0u);
+    testTicks += 20u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    EnergyGetReport(&saved);
+    TEST_EQUAL(saved.active, 10u);
+    TEST_EQUAL(saved.deepSleep, 20u);
+    TEST_EQUAL(saved.charge, (10u * ENERGY_UA_ACTIVE) + (20u * ENERGY_UA_DEEPSLEEP));
+
+    /* Hibernate clears the RAM, the WDT restarts */
+    TestReset(0u);
+    EnergyResume(&saved);
+    testTicks += 5u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_SLEEP, 0u);
+    EnergyGetReport(&report);
+    TEST_EQUAL(report.active, 15u);
+    TEST_EQUAL(report.sleep, 0u);
+    TEST_EQUAL(report.deepSleep, 20u);
+    TEST_EQUAL(report.charge, saved.charge + (5u * ENERGY_UA_ACTIVE));
+
+    testCapture = ENABLED;
+    EnergyPrint();
+    testCapture = DISABLED;
+    testOut[testOutLen] = '\0';
+    (void)snprintf(line, sizeof(line), "Energy: active 15000 ms, sleep 0 ms, deep sleep 20000 ms, %u uAh",
+        (unsigned int)(report.charge / 3600u));
+    TEST_CHECK(strstr(testOut, line) != NULL);
+    TEST_CHECK(strstr(testOut, "Blockers: uart 0 (0 ms)") != NULL);
+}
+
+
+int main(void)
+{
+    TestPeriods();
+    TestRandom();
+    TestReport();
+
+    return(TestResult("energy"));
+}
+
+
+/* [] END OF FILE */
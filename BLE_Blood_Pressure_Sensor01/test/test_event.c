@@ -0,0 +1,119 @@
+/*******************************************************************************
+* File Name: test_event.c
+*
+* Version 1.0
+*
+* Description:
+*  Stresses the interrupt to main loop event queue. A producer thread stands
+*  in for the WDT interrupt and posts numbered ticks as fast as it can while
+*  the main thread drains them. A tick refused by the full queue is posted
+*  again, so every tick has to arrive exactly once and in order.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <pthread.h>
+#include <sched.h>
+#include "test.h"
+#include "event.c"
+
+#define TEST_TICKS                  (1000000u)
+
+static EVENT_QUEUE_T testQueue;
+
+
+/*******************************************************************************
+* Function Name: TestProducer
+********************************************************************************
+*
+* Summary:
+*   Posts the ticks 1 .. TEST_TICKS, retrying while the queue is full.
+*
+*******************************************************************************/
+static void *TestProducer(void *arg)
+{
+    uint32 tick;
+
+    for(tick = 1u; tick <= TEST_TICKS; tick++)
+    {
+        while(EventPost(&testQueue, EVENT_TIMER, tick) == DISABLED)
+        {
+            /* Main loop behind, the refusal is counted as an overflow */
+            (void)sched_yield();
+        }
+    }
+    return(NULL);
+}
+
+
+int main(void)
+{
+    pthread_t producer;
+    EVENT_T event;
+    uint32 received = 0u;
+    uint32 last = 0u;
+    uint32 outOfOrder = 0u;
+    uint8 i;
+
+    /* Single threaded: fill, overflow, drain across the 8-bit index wrap */
+    for(i = 0u; i < 40u; i++)
+    {
+        TEST_EQUAL(EventPost(&testQueue, EVENT_TIMER, i), ENABLED);
+        TEST_EQUAL(EventGet(&testQueue, &event), ENABLED);
+        TEST_EQUAL(event.payload, i);
+    }
+    for(i = 0u; i < EVENT_QUEUE_SIZE; i++)
+    {
+        TEST_EQUAL(EventPost(&testQueue, EVENT_TIMER, i), ENABLED);
+    }
+    TEST_EQUAL(EventPost(&testQueue, EVENT_TIMER, i), DISABLED);
+    TEST_EQUAL(testQueue.overflow, 1u);
+    TEST_EQUAL(testQueue.highWater, EVENT_QUEUE_SIZE);
+    TEST_EQUAL(EventPending(&testQueue), ENABLED);
+    for(i = 0u; i < EVENT_QUEUE_SIZE; i++)
+    {
+        TEST_EQUAL(EventGet(&testQueue, &event), ENABLED);
+        TEST_EQUAL(event.type, EVENT_TIMER);
+        TEST_EQUAL(event.payload, i);
+    }
+    TEST_EQUAL(EventGet(&testQueue, &event), DISABLED);
+    TEST_EQUAL(EventPending(&testQueue), DISABLED);
+
+    /* Concurrent producer */
+    (void)memset(&testQueue, 0, sizeof(testQueue));
+    TEST_EQUAL(pthread_create(&producer, NULL, &TestProducer, NULL), 0);
+    while(last < TEST_TICKS)
+    {
+        if(EventGet(&testQueue, &event) != DISABLED)
+        {
+            if((event.type != EVENT_TIMER) || (event.payload <= last))
+            {
+                outOfOrder++;
+            }
+            last = event.payload;
+            received++;
+        }
+        else
+        {
+            /* Producer still running */
+            (void)sched_yield();
+        }
+    }
+    (void)pthread_join(producer, NULL);
+
+    TEST_EQUAL(outOfOrder, 0u);
+    TEST_EQUAL(received, TEST_TICKS);
+    TEST_EQUAL(EventPending(&testQueue), DISABLED);
+    TEST_CHECK(testQueue.highWater <= EVENT_QUEUE_SIZE);
+
+    printf("Ticks %ld: received %ld, refused while full %ld, high-water %d \r\n", TEST_TICKS, received,
+        testQueue.overflow, testQueue.highWater);
+    return(TestResult("event"));
+}
+
+
+/* [] END OF FILE */
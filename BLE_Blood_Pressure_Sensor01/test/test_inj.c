@@ -0,0 +1,548 @@
+/*******************************************************************************
+* File Name: test_inj.c
+*
+* Version 1.0
+*
+* Description:
+*  Battery measurement on the injection channel, on a model of the SAR
+*  sequencer. The battery is read every BATTERY_TIMEOUT seconds while the
+*  pressure waveform streams at full rate: the injection conversion has to
+*  tailgate the stream scans without a scan of its own, and the collector
+*  has to decode every converted pressure sample, none lost, repeated or
+*  displaced. Battery reporting is then stopped while an injection is
+*  pending, by a disconnect, a disabled notification and a reconnect
+*  without the subscription: the injection must be disarmed and the SAR
+*  vote and the ADC busy time released.
+*
+*  Built with the ADC component configured for the transducer channel after
+*  the battery channel; the injection channel is enabled in the component.
+*  The battery converts against the internal 1.024V reference through the
+*  1:4 divider, 2 mV per count.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#undef ADC_SEQUENCED_CHANNELS_NUM
+#define ADC_SEQUENCED_CHANNELS_NUM  (2u)
+#include "bas.c"
+#include "wave.c"
+
+#define TEST_STREAM_SECONDS         (30u)
+#define TEST_IDLE_SECONDS           (10u)
+#define TEST_MAIN_LOOP_TICKS        (33u)       /* The main loop runs about every millisecond */
+#define TEST_TIMER_PHASE            (1234u)     /* 1 s timer against the sample clock, WDT ticks */
+#define TEST_BATTERY_COUNTS         (1450)      /* Battery through the divider */
+#define TEST_BATTERY_MVOLTS         (2900u)
+#define TEST_PENDING_TICKS_MAX      (BATTERY_TIMEOUT * WAVE_CLOCK_HZ * 2u)
+
+/* Ways the battery reporting stops */
+#define TEST_STOP_DISCONNECT        (0u)
+#define TEST_STOP_NOTIFICATION      (1u)
+#define TEST_STOP_RECONNECT         (2u)
+#define TEST_STOP_COUNT             (3u)
+
+static uint32 testTick;
+static uint32 testPeriod;                       /* Sample clock period, WDT ticks */
+static uint8 testInIsr;
+static uint8 testQuiet;
+
+/* SAR sequencer */
+static uint32 testScans;                        /* Scans of the pressure channel */
+static int16 testResult;
+static uint32 testInjections;                   /* Injection conversions */
+static uint8 testInjResult;                     /* Injection converted since it was armed */
+static uint32 testForeignScans;                 /* Scans started outside the sample clock while streaming */
+static uint32 testHangs;                        /* Waits for an injection that is not armed */
+static uint32 testStale;                        /* Injection results read without a conversion */
+
+/* Analog rails and ADC busy time */
+static uint8 testUsers;
+static int32 testAdcBusy;                       /* Busy periods started and not stopped */
+static uint32 testHoldErrors;
+
+/* Collector */
+static uint32 testStreamFirst;                  /* Scan of the first sample of the stream */
+static uint32 testReads;                        /* Samples the stream read */
+static uint32 testReceived;
+static uint32 testMismatches;
+static uint16 testSeq;
+static uint32 testLost;
+
+/* Battery Level */
+static uint32 testLevels;
+static uint32 testLevelErrors;
+static uint16 testCccd;
+
+
+/*******************************************************************************
+* Function Name: TestSample
+********************************************************************************
+*
+* Summary:
+*   Returns the cuff pressure the SAR converts in the scan: a deflation ramp
+*   with a few counts of noise, within the 12-bit range.
+*
+*******************************************************************************/
+static int16 TestSample(uint32 scan)
+{
+    return((int16)(1536 - (int16)((scan & 0x1FFu) * 2u) + (int16)((scan * 2654435761u) >> 29u)));
+}
+
+
+/***************************************
+*       Components
+***************************************/
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testQuiet == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+}
+
+void CySysWdtWriteMatch(uint32 counterNum, uint32 match)
+{
+    testPeriod = match + 1u;
+}
+
+void ADC_EnableInjection(void)
+{
+    ADC_SAR_INJ_CHAN_CONFIG_REG |= ADC_INJ_CHAN_EN;
+    testInjResult = DISABLED;
+}
+
+void AnalogAcquire(ANALOG_USER_T user)
+{
+    testUsers |= (uint8)(1u << user);
+}
+
+void AnalogRelease(ANALOG_USER_T user)
+{
+    testUsers &= (uint8)~(uint8)(1u << user);
+}
+
+void EnergySubsystemStart(ENERGY_SUB_T sub)
+{
+    testAdcBusy += (sub == ENERGY_SUB_ADC) ? 1 : 0;
+}
+
+void EnergySubsystemStop(ENERGY_SUB_T sub)
+{
+    testAdcBusy -= (sub == ENERGY_SUB_ADC) ? 1 : 0;
+    testHoldErrors += (testAdcBusy >= 0) ? 0u : 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: ADC_StartConvert
+********************************************************************************
+*
+* Summary:
+*   Runs a scan of the sequencer: the pressure channel, then the injection
+*   channel when it is armed, which disarms it and raises its end of
+*   conversion. Only the sample clock may start a scan while streaming.
+*
+*******************************************************************************/
+void ADC_StartConvert(void)
+{
+    testForeignScans += ((waveRunning == ENABLED) && (testInIsr == DISABLED)) ? 1u : 0u;
+    testResult = TestSample(testScans);
+    testScans++;
+    if((ADC_SAR_INJ_CHAN_CONFIG_REG & ADC_INJ_CHAN_EN) != 0u)
+    {
+        ADC_SAR_INJ_CHAN_CONFIG_REG &= ~ADC_INJ_CHAN_EN;
+        ADC_SAR_INTR_REG |= ADC_INJ_EOC_MASK;
+        testInjResult = ENABLED;
+        testInjections++;
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: ADC_IsEndConversion
+********************************************************************************
+*
+* Summary:
+*   Returns and clears the end of conversion of the injection channel.
+*   Waiting for it while no scan converts it would hang.
+*
+*******************************************************************************/
+uint32 ADC_IsEndConversion(uint32 retMode)
+{
+    uint32 status = ADC_SAR_INTR_REG & ADC_INJ_EOC_MASK;
+
+    TEST_CHECK((retMode == ADC_RETURN_STATUS_INJ) || (retMode == ADC_WAIT_FOR_RESULT_INJ));
+    if(status != 0u)
+    {
+        ADC_SAR_INTR_REG &= ~ADC_INJ_EOC_MASK;
+    }
+    else if(retMode == ADC_WAIT_FOR_RESULT_INJ)
+    {
+        testHangs++;
+    }
+    else
+    {
+        /* Still pending */
+    }
+    return(status);
+}
+
+
+/*******************************************************************************
+* Function Name: ADC_GetResult16
+********************************************************************************
+*
+* Summary:
+*   Returns the pressure of the last scan, or the battery of the last
+*   injection conversion.
+*
+*******************************************************************************/
+int16 ADC_GetResult16(uint32 chan)
+{
+    int16 result = testResult;
+
+    if(chan == ADC_BATTERY_INJ_CHANNEL)
+    {
+        testStale += (testInjResult != DISABLED) ? 0u : 1u;
+        testInjResult = DISABLED;
+        result = TEST_BATTERY_COUNTS;
+    }
+    else
+    {
+        TEST_EQUAL(chan, ADC_PRESSURE_CHANNEL);
+        testReads++;
+    }
+    return(result);
+}
+
+
+/***************************************
+*       BLE stack and collector
+***************************************/
+CYBLE_API_RESULT_T CyBle_BassGetCharacteristicDescriptor(uint8 serviceIndex,
+    CYBLE_BAS_CHAR_INDEX_T charIndex, CYBLE_BAS_DESCR_INDEX_T descrIndex, uint8 attrSize, uint8 *attrValue)
+{
+    (void)memcpy(attrValue, &testCccd, attrSize);
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_BassSetCharacteristicValue(uint8 serviceIndex, CYBLE_BAS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    testLevelErrors += (*attrValue == BasMvoltsToLevel(TEST_BATTERY_MVOLTS)) ? 0u : 1u;
+    testLevels++;
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsNotification
+********************************************************************************
+*
+* Summary:
+*   The collector decodes the packet and compares its samples with the
+*   scans of the stream, in order.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    int16 samples[CODEC_COUNT_MAX];
+    const uint8 *pkt = ntfParam->value.val;
+    uint16 seq = (uint16)pkt[CODEC_HDR_SEQ] | ((uint16)pkt[CODEC_HDR_SEQ + 1u] << 8u);
+    uint8 count;
+    uint8 i;
+
+    TEST_EQUAL(ntfParam->attrHandle, CYBLE_WAVEFORM_DATA_CHAR_HANDLE);
+    count = CodecDecode(pkt, (uint8)ntfParam->value.len, samples, CODEC_COUNT_MAX);
+    testLost += (uint16)(seq - testSeq);
+    testSeq = seq + 1u;
+    for(i = 0u; i < count; i++)
+    {
+        testMismatches += (samples[i] == TestSample(testStreamFirst + testReceived)) ? 0u : 1u;
+        testReceived++;
+    }
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: TestHolds
+********************************************************************************
+*
+* Summary:
+*   Checks that the battery holds the SAR vote and an ADC busy period
+*   exactly while its injection is pending, next to those of the stream.
+*
+*******************************************************************************/
+static void TestHolds(void)
+{
+    uint8 battery = ((testUsers & (1u << ANALOG_USER_BATTERY)) != 0u) ? ENABLED : DISABLED;
+    int32 busy = ((waveRunning == ENABLED) ? 1 : 0) + ((basInjPending != DISABLED) ? 1 : 0);
+
+    testHoldErrors += (battery == basInjPending) ? 0u : 1u;
+    testHoldErrors += (testAdcBusy == busy) ? 0u : 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: TestTick
+********************************************************************************
+*
+* Summary:
+*   Runs one WDT tick of the device while connected: the sample clock
+*   interrupt, the main loop and the 1 second timer with the battery
+*   condition of the main loop.
+*
+*******************************************************************************/
+static void TestTick(void)
+{
+    testQuiet = ENABLED;
+    testTick++;
+    if((waveRunning == ENABLED) && ((testTick % testPeriod) == 0u))
+    {
+        testInIsr = ENABLED;
+        WaveSample();
+        testInIsr = DISABLED;
+    }
+    if((testTick % TEST_MAIN_LOOP_TICKS) == 0u)
+    {
+        WaveProcess();
+    }
+    if(((testTick + TEST_TIMER_PHASE) % WAVE_CLOCK_HZ) == 0u)
+    {
+        BasTick();
+        if((batteryMeasure == ENABLED) && ((BAS_MEASURE_INJ != 0u) || (WaveRunning() == DISABLED)))
+        {
+            MeasureBattery();
+        }
+        TestHolds();
+    }
+    testQuiet = DISABLED;
+}
+
+
+/*******************************************************************************
+* Function Name: TestRun
+********************************************************************************
+*
+* Summary:
+*   Runs the device for the seconds.
+*
+*******************************************************************************/
+static void TestRun(uint32 seconds)
+{
+    uint32 tick;
+
+    for(tick = 0u; tick < (seconds * WAVE_CLOCK_HZ); tick++)
+    {
+        TestTick();
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestStreamStart
+********************************************************************************
+*
+* Summary:
+*   Starts the stream at full rate and the collector with it.
+*
+*******************************************************************************/
+static void TestStreamStart(void)
+{
+    testQuiet = ENABLED;
+    WaveSetMtu(CYBLE_GATT_MTU);
+    WaveStart(WAVE_RATE_MAX);
+    testQuiet = DISABLED;
+    testStreamFirst = testScans;
+    testReads = 0u;
+    testReceived = 0u;
+    testMismatches = 0u;
+    testSeq = 0u;
+    testLost = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: TestSubscribe
+********************************************************************************
+*
+* Summary:
+*   The collector enables the Battery Level notifications.
+*
+*******************************************************************************/
+static void TestSubscribe(void)
+{
+    CYBLE_BAS_CHAR_VALUE_T param;
+
+    param.serviceIndex = BAS_SERVICE_MEASURE;
+    testQuiet = ENABLED;
+    BasCallBack(CYBLE_EVT_BASS_NOTIFICATION_ENABLED, &param);
+    testQuiet = DISABLED;
+    TEST_EQUAL(batteryMeasure, ENABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestStream
+********************************************************************************
+*
+* Summary:
+*   Reads the battery while idle and while streaming at full rate. The
+*   battery reads must not start a scan during the stream nor lose, repeat
+*   or displace a pressure sample, and every read must convert.
+*
+*******************************************************************************/
+static void TestStream(void)
+{
+    uint32 levels;
+    uint32 injections;
+
+    TestSubscribe();
+    TestRun(TEST_IDLE_SECONDS);
+    TEST_CHECK(testLevels >= ((TEST_IDLE_SECONDS / BATTERY_TIMEOUT) - 1u));
+    TEST_EQUAL(testInjections, testLevels);
+
+    levels = testLevels;
+    injections = testInjections;
+    TestStreamStart();
+    TestRun(TEST_STREAM_SECONDS);
+    WaveProcess();
+
+    TEST_EQUAL(testForeignScans, 0u);
+    TEST_EQUAL(testMismatches, 0u);
+    TEST_EQUAL(testLost, 0u);
+    TEST_EQUAL(waveOverflow, 0u);
+    TEST_EQUAL(testReads, testReceived + waveEnc.count);
+    TEST_EQUAL(testScans - testStreamFirst, testReads + 1u);
+    TEST_CHECK(testReceived >= ((TEST_STREAM_SECONDS - 1u) * WAVE_RATE_MAX));
+
+    /* A read every BATTERY_TIMEOUT seconds, converted after the next stream scan */
+    TEST_CHECK((testLevels - levels) >= ((TEST_STREAM_SECONDS / (BATTERY_TIMEOUT + 1u)) - 1u));
+    TEST_EQUAL(testInjections - injections, testLevels - levels + ((basInjPending != DISABLED) ? 1u : 0u));
+    testQuiet = ENABLED;
+    WaveStop();
+    testQuiet = DISABLED;
+    TestHolds();
+
+    printf("Injection, %ld s at %d samples/s: %ld samples received, %ld lost, %ld mismatched, %ld battery reads \r\n",
+        TEST_STREAM_SECONDS, waveStats.rate, testReceived, testLost, testMismatches, testLevels - levels);
+
+    /* A read pending at the stop of the stream completes on its own scan */
+    TestRun(BATTERY_TIMEOUT);
+    TEST_EQUAL(basInjPending, DISABLED);
+    TEST_EQUAL(testInjections, testLevels);
+}
+
+
+/*******************************************************************************
+* Function Name: TestStop
+********************************************************************************
+*
+* Summary:
+*   Stops the battery reporting while an injection is pending, armed or
+*   converted by a stream scan and not polled yet. The injection must be
+*   disarmed, its end of conversion cleared and the holds released, and a
+*   new subscription must measure again.
+*
+*******************************************************************************/
+static void TestStop(uint32 stop, uint8 converted)
+{
+    CYBLE_BAS_CHAR_VALUE_T param;
+    uint32 ticks = 0u;
+    uint32 injections;
+    uint32 levels;
+
+    TestSubscribe();
+    TestStreamStart();
+    while((basInjPending == DISABLED) && (ticks < TEST_PENDING_TICKS_MAX))
+    {
+        TestTick();
+        ticks++;
+    }
+    while((converted != DISABLED) && (testInjResult == DISABLED) && (ticks < TEST_PENDING_TICKS_MAX))
+    {
+        TestTick();
+        ticks++;
+    }
+    TEST_EQUAL(basInjPending, ENABLED);
+    TEST_EQUAL(testInjResult, converted);
+    TEST_CHECK((testUsers & (1u << ANALOG_USER_BATTERY)) != 0u);
+
+    testQuiet = ENABLED;
+    switch(stop)
+    {
+        case TEST_STOP_DISCONNECT:
+            /* The disconnect of the application callback */
+            BasDisconnected();
+            WaveStop();
+            break;
+
+        case TEST_STOP_NOTIFICATION:
+            param.serviceIndex = BAS_SERVICE_MEASURE;
+            BasCallBack(CYBLE_EVT_BASS_NOTIFICATION_DISABLED, &param);
+            break;
+
+        default:    /* TEST_STOP_RECONNECT */
+            testCccd = 0u;
+            BasConnected();
+            break;
+    }
+    testQuiet = DISABLED;
+    TEST_EQUAL(batteryMeasure, DISABLED);
+    TEST_EQUAL(basInjPending, DISABLED);
+    TEST_EQUAL(ADC_SAR_INJ_CHAN_CONFIG_REG & ADC_INJ_CHAN_EN, 0u);
+    TEST_EQUAL(ADC_SAR_INTR_REG & ADC_INJ_EOC_MASK, 0u);
+    TEST_EQUAL(testUsers & (1u << ANALOG_USER_BATTERY), 0u);
+    TestHolds();
+
+    /* The stream goes on without converting the abandoned injection */
+    injections = testInjections;
+    TestRun(BATTERY_TIMEOUT + 1u);
+    TEST_EQUAL(testInjections, injections);
+    testQuiet = ENABLED;
+    WaveStop();
+    testQuiet = DISABLED;
+    TEST_EQUAL(testUsers, 0u);
+    TEST_EQUAL(testAdcBusy, 0);
+
+    /* A new subscription reads the battery again */
+    levels = testLevels;
+    TestSubscribe();
+    TestRun(BATTERY_TIMEOUT + 1u);
+    TEST_CHECK(testLevels > levels);
+    TEST_EQUAL(testAdcBusy, 0);
+    testQuiet = ENABLED;
+    BasDisconnected();
+    testQuiet = DISABLED;
+}
+
+
+int main(void)
+{
+    uint32 stop;
+
+    TestStream();
+    for(stop = 0u; stop < TEST_STOP_COUNT; stop++)
+    {
+        TestStop(stop, DISABLED);
+        TestStop(stop, ENABLED);
+    }
+
+    TEST_EQUAL(testHangs, 0u);
+    TEST_EQUAL(testStale, 0u);
+    TEST_EQUAL(testHoldErrors, 0u);
+    TEST_EQUAL(testLevelErrors, 0u);
+    TEST_EQUAL(testUsers, 0u);
+    TEST_EQUAL(testAdcBusy, 0);
+
+    return(TestResult("inj"));
+}
+
+
+/* [] END OF FILE */
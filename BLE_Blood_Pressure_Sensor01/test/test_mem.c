@@ -0,0 +1,275 @@
+/*******************************************************************************
+* File Name: test_mem.c
+*
+* Version 1.0
+*
+* Description:
+*  RAM usage instrumentation on a model of the PSoC RAM: the heap from end
+*  to __cy_heap_limit, then the free RAM and the stack up to __cy_stack. The
+*  build places the linker symbols of cm0gcc.ld in testRam. The stack is
+*  painted below a simulated stack pointer, used to random depths, and the
+*  scan has to find the deepest word written. The heap break has to stay
+*  within the reserved heap.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#include "mem.c"
+
+#define TEST_RAM_WORDS              (TEST_RAM_SIZE / 4u)
+#define TEST_HEAP_WORDS             (CYDEV_HEAP_SIZE / 4u)
+#define TEST_STACK_WORDS            (TEST_RAM_WORDS - TEST_HEAP_WORDS)
+#define TEST_SP_WORDS               (16u)       /* Stack in use when MemInit() runs */
+#define TEST_RUNS                   (2000u)
+#define TEST_GUARD_WORDS            (TEST_GUARD_SIZE / 4u)  /* Words around the model that must not change */
+
+/* end, __cy_heap_limit and __cy_stack point into ram, see CMakeLists.txt */
+struct
+{
+    uint32 below[TEST_GUARD_WORDS];
+    uint32 ram[TEST_RAM_WORDS];
+    uint32 above[TEST_GUARD_WORDS];
+}testRam;
+
+static uint32 testRandom = 3u;
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((testRandom >> 8u) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestAddress
+********************************************************************************
+*
+* Summary:
+*   Returns the address of the object. The compiler takes distinct objects
+*   for distinct addresses, and would fold the comparison of a linker symbol
+*   with the object it is placed in.
+*
+*******************************************************************************/
+static uintptr_t TestAddress(const void *object)
+{
+    const void * volatile address = object;
+
+    return((uintptr_t)address);
+}
+
+
+/*******************************************************************************
+* Function Name: TestGuardsIntact
+********************************************************************************
+*
+* Summary:
+*   Returns ENABLED if nothing was written around the RAM model.
+*
+*******************************************************************************/
+static uint8 TestGuardsIntact(void)
+{
+    uint32 i;
+    uint8 intact = ENABLED;
+
+    for(i = 0u; i < TEST_GUARD_WORDS; i++)
+    {
+        if((testRam.below[i] != i) || (testRam.above[i] != i))
+        {
+            intact = DISABLED;
+        }
+    }
+    return(intact);
+}
+
+
+/*******************************************************************************
+* Function Name: TestPaintScan
+********************************************************************************
+*
+* Summary:
+*   Paints random ranges of the RAM model, writes the top of each to a
+*   random depth with values other than the pattern, and checks that the
+*   paint stays inside the range and that the scan stops at the deepest word
+*   written.
+*
+*******************************************************************************/
+static void TestPaintScan(void)
+{
+    uint32 *ram = testRam.ram;
+    uint32 run;
+    uint32 from;
+    uint32 to;
+    uint32 depth;
+    uint32 i;
+    uint32 painted;
+    uint32 misses = 0u;
+
+    for(run = 0u; run < TEST_RUNS; run++)
+    {
+        from = TestRand(TEST_RAM_WORDS);
+        to = from + TestRand(TEST_RAM_WORDS - from + 1u);
+        depth = TestRand(to - from + 1u);
+        for(i = 0u; i < TEST_RAM_WORDS; i++)
+        {
+            ram[i] = i;
+        }
+
+        MemPaint(&ram[from], &ram[to]);
+        painted = 0u;
+        for(i = 0u; i < TEST_RAM_WORDS; i++)
+        {
+            painted += (ram[i] == MEM_PAINT) ? 1u : 0u;
+        }
+        TEST_EQUAL(painted, to - from);
+        TEST_EQUAL(ram[from], (from == to) ? from : MEM_PAINT);
+
+        /* The stack grows down: the last word written is the deepest */
+        for(i = to; i > (to - depth); i--)
+        {
+            ram[i - 1u] = (TestRand(2u) == 0u) ? 0u : ~MEM_PAINT;
+        }
+        misses += (MemScan(&ram[from], &ram[to]) == &ram[to - depth]) ? 0u : 1u;
+    }
+    TEST_EQUAL(misses, 0u);
+
+    /* An empty and an inverted range are left alone */
+    ram[0u] = 0u;
+    MemPaint(&ram[1u], &ram[1u]);
+    MemPaint(&ram[1u], &ram[0u]);
+    TEST_EQUAL(ram[0u], 0u);
+    TEST_EQUAL(ram[1u], 1u);
+    TEST_CHECK(MemScan(&ram[1u], &ram[1u]) == &ram[1u]);
+    TEST_CHECK(MemScan(&ram[1u], &ram[0u]) == &ram[1u]);
+    TEST_EQUAL(TestGuardsIntact(), ENABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestReport
+********************************************************************************
+*
+* Summary:
+*   Paints the RAM model the way main() does, runs the stack to a random
+*   depth and checks the deepest stack and the untouched RAM of the report.
+*
+*******************************************************************************/
+static void TestReport(void)
+{
+    MEM_REPORT_T report;
+    uint32 *stack = &testRam.ram[TEST_RAM_WORDS];
+    uint32 run;
+    uint32 depth;
+    uint32 deepest;
+    uint32 i;
+    uint32 errors = 0u;
+
+    for(run = 0u; run < TEST_RUNS; run++)
+    {
+        for(i = 0u; i < TEST_RAM_WORDS; i++)
+        {
+            testRam.ram[i] = ~MEM_PAINT;
+        }
+        testReg.msp = (uintptr_t)(stack - TEST_SP_WORDS);
+        MemInit();
+
+        /* The guard below the stack pointer and the stack in use keep their values */
+        TEST_EQUAL(stack[-(int32)TEST_SP_WORDS - 1], ~MEM_PAINT);
+        TEST_EQUAL(stack[-(int32)TEST_SP_WORDS - (int32)(MEM_PAINT_GUARD / 4u) - 1], MEM_PAINT);
+        TEST_EQUAL(testRam.ram[TEST_HEAP_WORDS], MEM_PAINT);
+        TEST_EQUAL(testRam.ram[TEST_HEAP_WORDS - 1u], ~MEM_PAINT);
+
+        /* Calls and interrupts go down to the deepest point, then return */
+        deepest = TEST_SP_WORDS + (MEM_PAINT_GUARD / 4u) + TestRand(TEST_STACK_WORDS - TEST_SP_WORDS -
+            (MEM_PAINT_GUARD / 4u));
+        for(depth = TEST_SP_WORDS; depth < deepest; depth++)
+        {
+            stack[-(int32)depth - 1] = TestRand(MEM_PAINT);
+        }
+
+        MemGetReport(&report);
+        errors += (report.stackMax == (deepest * 4u)) ? 0u : 1u;
+        errors += (report.free == ((TEST_STACK_WORDS - deepest) * 4u)) ? 0u : 1u;
+    }
+    TEST_EQUAL(errors, 0u);
+    TEST_EQUAL(report.heapSize, CYDEV_HEAP_SIZE);
+    TEST_EQUAL(report.stackSize, CYDEV_STACK_SIZE);
+
+    /* A stack that ran into the heap limit leaves nothing untouched */
+    for(depth = 0u; depth < TEST_STACK_WORDS; depth++)
+    {
+        stack[-(int32)depth - 1] = 0u;
+    }
+    MemGetReport(&report);
+    TEST_EQUAL(report.stackMax, TEST_STACK_WORDS * 4u);
+    TEST_EQUAL(report.free, 0u);
+    TEST_EQUAL(TestGuardsIntact(), ENABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestHeap
+********************************************************************************
+*
+* Summary:
+*   Moves the heap break up and down and past the reserved heap.
+*
+*******************************************************************************/
+static void TestHeap(void)
+{
+    MEM_REPORT_T report;
+    uint8 *heap = (uint8 *)testRam.ram;
+
+    TEST_CHECK(_sbrk(0) == heap);
+    TEST_CHECK(_sbrk(64) == heap);
+    TEST_CHECK(_sbrk(CYDEV_HEAP_SIZE - 64) == &heap[64]);
+    TEST_CHECK(_sbrk(1) == (void *)-1);
+    TEST_EQUAL(errno, ENOMEM);
+    TEST_CHECK(_sbrk(-(CYDEV_HEAP_SIZE - 16)) == &heap[CYDEV_HEAP_SIZE]);
+    TEST_CHECK(_sbrk(-17) == (void *)-1);
+    TEST_CHECK(_sbrk(32) == &heap[16]);
+
+    MemGetReport(&report);
+    TEST_EQUAL(report.heapUsed, CYDEV_HEAP_SIZE);
+    TEST_EQUAL(report.heapFailed, 2u);
+    TEST_EQUAL(TestGuardsIntact(), ENABLED);
+}
+
+
+int main(void)
+{
+    uint32 i;
+
+    for(i = 0u; i < TEST_GUARD_WORDS; i++)
+    {
+        testRam.below[i] = i;
+        testRam.above[i] = i;
+    }
+
+    /* The linker symbols sit where the model expects them */
+    TEST_CHECK(TestAddress(end) == TestAddress(testRam.ram));
+    TEST_CHECK(TestAddress(__cy_heap_limit) == (TestAddress(testRam.ram) + CYDEV_HEAP_SIZE));
+    TEST_CHECK(TestAddress(__cy_stack) == (TestAddress(testRam.ram) + TEST_RAM_SIZE));
+
+    TestPaintScan();
+    TestReport();
+    TestHeap();
+
+    return(TestResult("mem"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,291 @@
+/*******************************************************************************
+* File Name: test_power.c
+*
+* Version 1.0
+*
+* Description:
+*  Power mode governor in a simulation of the main loop: every iteration
+*  the BLE stack, the debug UART, the SAR, the event queue and the votes of
+*  the subsystems take random states, PowerIdle() enters a power mode and
+*  the model sleeps in it. The mode has to be the deepest the rules of the
+*  governor permit, Deep Sleep must never be entered while anything needs
+*  HFCLK, and the energy accounting has to match the residency and the
+*  blocker counts of the model.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#include "power.c"
+#include "energy.c"
+#include "event.c"
+
+#define TEST_ITERATIONS             (200000u)
+#define TEST_ACTIVE_TICKS_MAX       (64u)       /* Loop iteration, up to 2 ms */
+#define TEST_SLEEP_TICKS_MAX        (8192u)     /* Up to the 250 ms connection interval */
+#define TEST_NO_MODE                (ENERGY_MODE_COUNT)
+
+static uint32 testTicks;
+static CYBLE_LP_MODE_T testLpMode;
+static CYBLE_BLESS_STATE_T testBlessState;
+static uint32 testTxBuffer;
+static ENERGY_MODE_T testEntered;
+static uint32 testSleepTicks;
+static uint32 testRandom = 11u;
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((testRandom >> 8u) % limit);
+}
+
+
+/***************************************
+*       Components and BLE stack
+***************************************/
+uint32 WDT_ReadTicks(void)
+{
+    return(testTicks);
+}
+
+uint32 UART_DEB_SpiUartGetTxBufferSize(void)
+{
+    return(testTxBuffer);
+}
+
+CYBLE_LP_MODE_T CyBle_EnterLPM(CYBLE_LP_MODE_T pwrMode)
+{
+    return(testLpMode);
+}
+
+CYBLE_BLESS_STATE_T CyBle_GetBleSsState(void)
+{
+    return(testBlessState);
+}
+
+void CySysPmSleep(void)
+{
+    testEntered = ENERGY_MODE_SLEEP;
+    testTicks += testSleepTicks;
+}
+
+void CySysPmDeepSleep(void)
+{
+    testEntered = ENERGY_MODE_DEEPSLEEP;
+    testTicks += testSleepTicks;
+}
+
+
+/*******************************************************************************
+* Function Name: TestTicks
+********************************************************************************
+*
+* Summary:
+*   Returns the accumulated time in WDT ticks.
+*
+*******************************************************************************/
+static uint32 TestTicks(const ENERGY_TIME_T *time)
+{
+    return((time->seconds << ENERGY_TICKS_SHIFT) + time->ticks);
+}
+
+
+/*******************************************************************************
+* Function Name: TestSelect
+********************************************************************************
+*
+* Summary:
+*   PowerSelect() on every combination of votes.
+*
+*******************************************************************************/
+static void TestSelect(void)
+{
+    uint32 noSleep;
+    uint32 noDeepSleep;
+    uint32 blockers;
+    uint32 errors = 0u;
+    ENERGY_MODE_T mode;
+    ENERGY_MODE_T expected;
+
+    for(noSleep = 0u; noSleep < ENERGY_BLOCK_MASK(ENERGY_BLOCK_COUNT); noSleep++)
+    {
+        for(noDeepSleep = 0u; noDeepSleep < ENERGY_BLOCK_MASK(ENERGY_BLOCK_COUNT); noDeepSleep++)
+        {
+            expected = (noSleep != 0u) ? ENERGY_MODE_ACTIVE :
+                       ((noDeepSleep != 0u) ? ENERGY_MODE_SLEEP : ENERGY_MODE_DEEPSLEEP);
+            mode = PowerSelect(noSleep, noDeepSleep, &blockers);
+            errors += ((mode == expected) && (blockers == (noSleep | noDeepSleep))) ? 0u : 1u;
+        }
+    }
+    TEST_EQUAL(errors, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestLoop
+********************************************************************************
+*
+* Summary:
+*   Runs the main loop model and checks each power mode entered, the
+*   residency, the charge and the blockers of the energy accounting.
+*
+*******************************************************************************/
+static void TestLoop(void)
+{
+    static const uint16 current[ENERGY_MODE_COUNT] = {ENERGY_UA_ACTIVE, ENERGY_UA_SLEEP, ENERGY_UA_DEEPSLEEP};
+    uint32 held[POWER_VOTE_COUNT] = {0u, 0u};
+    uint32 residency[ENERGY_MODE_COUNT] = {0u, 0u, 0u};
+    uint32 blockTicks[ENERGY_BLOCK_COUNT] = {0u};
+    uint32 blockCount[ENERGY_BLOCK_COUNT] = {0u};
+    uint64 charge = 0u;
+    uint32 noSleep;
+    uint32 noDeepSleep;
+    uint32 blockers = 0u;
+    uint32 ticks;
+    uint32 unsafe = 0u;
+    uint32 errors = 0u;
+    uint32 i;
+    uint32 b;
+    EVENT_T event;
+    ENERGY_MODE_T expected;
+    ENERGY_BLOCK_T reason;
+    POWER_VOTE_T vote;
+    uint8 needsCpu;
+    uint8 pending;
+
+    testTicks = 0x12345678u;
+    EnergyInit();
+    for(i = 0u; i < TEST_ITERATIONS; i++)
+    {
+        /* A subsystem holds or releases a vote, held for a few iterations */
+        if(TestRand(4u) == 0u)
+        {
+            vote = (POWER_VOTE_T)TestRand(POWER_VOTE_COUNT);
+            reason = (ENERGY_BLOCK_T)(ENERGY_BLOCK_NONE + 1u + TestRand(ENERGY_BLOCK_COUNT - 1u));
+            if(TestRand(8u) == 0u)
+            {
+                PowerHold(vote, reason);
+                held[vote] |= ENERGY_BLOCK_MASK(reason);
+            }
+            else
+            {
+                PowerRelease(vote, reason);
+                held[vote] &= ~ENERGY_BLOCK_MASK(reason);
+            }
+        }
+
+        /* The loop handles its events, the stack and the peripherals move on */
+        ticks = 1u + TestRand(TEST_ACTIVE_TICKS_MAX);
+        testTicks += ticks;
+        residency[ENERGY_MODE_ACTIVE] += ticks;
+        charge += (uint64)ticks * ENERGY_UA_ACTIVE;
+        for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+        {
+            blockTicks[b] += ((blockers & ENERGY_BLOCK_MASK(b)) != 0u) ? ticks : 0u;
+        }
+        testLpMode = (TestRand(2u) == 0u) ? CYBLE_BLESS_DEEPSLEEP :
+                     ((TestRand(2u) == 0u) ? CYBLE_BLESS_SLEEP : CYBLE_BLESS_ACTIVE);
+        testBlessState = (CYBLE_BLESS_STATE_T)(CYBLE_BLESS_STATE_ACTIVE + TestRand(CYBLE_BLESS_STATE_HIBERNATE));
+        testTxBuffer = (TestRand(8u) == 0u) ? (1u + TestRand(8u)) : 0u;
+        testReg.uartTxFifo = (TestRand(8u) == 0u) ? 1u : 0u;
+        testReg.sarStatus = (TestRand(8u) == 0u) ? ADC_STATUS_BUSY : 0u;
+        pending = (TestRand(16u) == 0u) ? ENABLED : DISABLED;
+        if(pending != DISABLED)
+        {
+            (void)EventPost(&timerQueue, EVENT_TIMER, 0u);
+        }
+
+        /* The rules of the governor */
+        needsCpu = (testLpMode == CYBLE_BLESS_DEEPSLEEP) ?
+            (((testBlessState != CYBLE_BLESS_STATE_ECO_ON) && (testBlessState != CYBLE_BLESS_STATE_DEEPSLEEP)) ?
+                ENABLED : DISABLED) :
+            ((testBlessState == CYBLE_BLESS_STATE_EVENT_CLOSE) ? ENABLED : DISABLED);
+        noSleep = held[POWER_NO_SLEEP] | ((needsCpu != DISABLED) ? ENERGY_BLOCK_MASK(ENERGY_BLOCK_BLESS) : 0u) |
+                  ((pending != DISABLED) ? ENERGY_BLOCK_MASK(ENERGY_BLOCK_EVENT) : 0u);
+        noDeepSleep = held[POWER_NO_DEEPSLEEP] |
+                      (((testLpMode != CYBLE_BLESS_DEEPSLEEP) && (needsCpu == DISABLED)) ?
+                          ENERGY_BLOCK_MASK(ENERGY_BLOCK_BLESS) : 0u) |
+                      (((testTxBuffer + testReg.uartTxFifo) != 0u) ? ENERGY_BLOCK_MASK(ENERGY_BLOCK_UART_TX) : 0u) |
+                      ((testReg.sarStatus != 0u) ? ENERGY_BLOCK_MASK(ENERGY_BLOCK_ADC) : 0u);
+        expected = (noSleep != 0u) ? ENERGY_MODE_ACTIVE :
+                   ((noDeepSleep != 0u) ? ENERGY_MODE_SLEEP : ENERGY_MODE_DEEPSLEEP);
+        blockers = noSleep | noDeepSleep;
+
+        testEntered = TEST_NO_MODE;
+        testSleepTicks = 1u + TestRand(TEST_SLEEP_TICKS_MAX);
+        PowerIdle();
+
+        if(expected == ENERGY_MODE_ACTIVE)
+        {
+            errors += (testEntered == TEST_NO_MODE) ? 0u : 1u;
+        }
+        else
+        {
+            errors += (testEntered == expected) ? 0u : 1u;
+            residency[expected] += testSleepTicks;
+            charge += (uint64)testSleepTicks * current[expected];
+            for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+            {
+                blockTicks[b] += ((blockers & ENERGY_BLOCK_MASK(b)) != 0u) ? testSleepTicks : 0u;
+            }
+        }
+        for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+        {
+            blockCount[b] += ((blockers & ENERGY_BLOCK_MASK(b)) != 0u) ? 1u : 0u;
+        }
+        if(testEntered == ENERGY_MODE_DEEPSLEEP)
+        {
+            unsafe += ((held[POWER_NO_SLEEP] | held[POWER_NO_DEEPSLEEP] | testTxBuffer | testReg.uartTxFifo |
+                        testReg.sarStatus) != 0u) ? 1u : 0u;
+            unsafe += (pending != DISABLED) ? 1u : 0u;
+        }
+        blockers = (expected == ENERGY_MODE_ACTIVE) ? blockers : 0u;
+
+        while(EventGet(&timerQueue, &event) != DISABLED)
+        {
+        }
+    }
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+
+    TEST_EQUAL(errors, 0u);
+    TEST_EQUAL(unsafe, 0u);
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_ACTIVE]), residency[ENERGY_MODE_ACTIVE]);
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_SLEEP]), residency[ENERGY_MODE_SLEEP]);
+    TEST_EQUAL(TestTicks(&energyMode[ENERGY_MODE_DEEPSLEEP]), residency[ENERGY_MODE_DEEPSLEEP]);
+    TEST_EQUAL(energyCharge, (uint32)(charge >> ENERGY_TICKS_SHIFT));
+    for(b = ENERGY_BLOCK_NONE + 1u; b < ENERGY_BLOCK_COUNT; b++)
+    {
+        TEST_EQUAL(energyBlockCount[b], blockCount[b]);
+        TEST_EQUAL(TestTicks(&energyBlock[b]), blockTicks[b]);
+    }
+    TEST_CHECK(residency[ENERGY_MODE_DEEPSLEEP] != 0u);
+    TEST_CHECK(residency[ENERGY_MODE_SLEEP] != 0u);
+
+    printf("Power loop, %ld iterations: \r\n", TEST_ITERATIONS);
+    EnergyPrint();
+}
+
+
+int main(void)
+{
+    TestSelect();
+    TestLoop();
+
+    return(TestResult("power"));
+}
+
+
+/* [] END OF FILE */
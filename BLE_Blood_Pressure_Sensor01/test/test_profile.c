@@ -0,0 +1,370 @@
+/*******************************************************************************
+* File Name: test_profile.c
+*
+* Version 1.0
+*
+* Description:
+*  SysTick cycle profiler on a model of the SysTick. The trace record of a
+*  probe costs a known number of cycles, and the regions run for known
+*  bodies, so the overhead measured by ProfileInit(), the cycles of each
+*  region after the overhead is subtracted, the trace ring and the printed
+*  statistics are checked exactly, across the wrap of the 24-bit counter.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "profile.c"
+
+#define TEST_OUT_SIZE               (8192u)
+#define TEST_CYCLES_RECORD          (37u)       /* Trace record of a probe, with its critical section */
+#define TEST_CYCLES_PREEMPT         (500u)      /* Interrupt during one calibration pair */
+#define TEST_CYCLES_BLESS           (1200u)     /* BLESS interrupt handler */
+#define TEST_CYCLES_MAX             (100000u)   /* Longest random region body */
+#define TEST_REGIONS                (10000u)
+
+static char testOut[TEST_OUT_SIZE];
+static uint32 testOutLen;
+static uint8 testCapture;
+static uint32 testRecordCycles;
+static uint32 testPreemptAt;                    /* Record that an interrupt delays, 0 for none */
+static uint32 testRecords;
+static cyisraddress testBlessVector;
+static uint32 testBlessCalls;
+static uint32 testRandom = 3u;
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return(((testRandom >> 8u) | (testRandom << 24u)) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestAdvance
+********************************************************************************
+*
+* Summary:
+*   Runs the SysTick model for the cycles, counting down and wrapping at
+*   24 bits.
+*
+*******************************************************************************/
+static void TestAdvance(uint32 cycles)
+{
+    testReg.systCvr = (testReg.systCvr - cycles) & CY_SYS_SYST_RVR_CNT_MASK;
+}
+
+
+/***************************************
+*       Components and BLE stack
+***************************************/
+
+/* The trace record is the only code between the stamps of a probe pair
+*  in the model, so its cost is the overhead ProfileInit() must measure.
+*/
+uint8 CyEnterCriticalSection(void)
+{
+    testRecords++;
+    TestAdvance(testRecordCycles);
+    if(testRecords == testPreemptAt)
+    {
+        TestAdvance(TEST_CYCLES_PREEMPT);
+    }
+    return(0u);
+}
+
+void CYBLE_bless_isr_SetVector(cyisraddress address)
+{
+    testBlessVector = address;
+}
+
+void CyBLE_Bless_Interrupt(void)
+{
+    testBlessCalls++;
+    TestAdvance(TEST_CYCLES_BLESS);
+}
+
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testCapture == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+    else if(testOutLen < (TEST_OUT_SIZE - 1u))
+    {
+        testOut[testOutLen] = (char)txData;
+        testOutLen++;
+    }
+    else
+    {
+        /* A longer output fails on the missing lines */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestInit
+********************************************************************************
+*
+* Summary:
+*   Clears the trace and runs ProfileInit() with the SysTick model at the
+*   count, capturing its output.
+*
+*******************************************************************************/
+static void TestInit(uint32 count, uint32 preemptAt)
+{
+    (void)memset(profileTrace, 0, sizeof(profileTrace));
+    profileTraceIdx = 0u;
+    testReg.systCvr = count;
+    testRecordCycles = TEST_CYCLES_RECORD;
+    testRecords = 0u;
+    testPreemptAt = preemptAt;
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    ProfileInit();
+    testCapture = DISABLED;
+    testOut[testOutLen] = '\0';
+    testPreemptAt = 0u;
+}
+
+
+/*******************************************************************************
+* Function Name: TestRegion
+********************************************************************************
+*
+* Summary:
+*   Runs the region for the body cycles.
+*
+*******************************************************************************/
+static void TestRegion(PROFILE_REGION_T region, uint32 body)
+{
+    PROFILE_ENTER(region);
+    TestAdvance(body);
+    PROFILE_EXIT(region);
+}
+
+
+/*******************************************************************************
+* Function Name: TestOverhead
+********************************************************************************
+*
+* Summary:
+*   The overhead measured by ProfileInit() is the cost of the trace record
+*   between the stamps, also when an interrupt delays one calibration pair
+*   or the counter wraps during the calibration, and it is printed.
+*
+*******************************************************************************/
+static void TestOverhead(void)
+{
+    char line[64];
+
+    TestInit(CY_SYS_SYST_RVR_CNT_MASK, 0u);
+    TEST_EQUAL(profileOverhead, TEST_CYCLES_RECORD);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].count, PROFILE_CALIB_LOOPS);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].min, TEST_CYCLES_RECORD);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].max, TEST_CYCLES_RECORD);
+    TEST_EQUAL(testRecords, 2u * PROFILE_CALIB_LOOPS);
+    TEST_CHECK(testBlessVector == &ProfileBlessInterrupt);
+    (void)snprintf(line, sizeof(line), "Profiler probe overhead: %u cycles", TEST_CYCLES_RECORD);
+    TEST_CHECK(strstr(testOut, line) != NULL);
+
+    /* The entry record of the third pair is delayed by an interrupt */
+    TestInit(0x123456u, 5u);
+    TEST_EQUAL(profileOverhead, TEST_CYCLES_RECORD);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].max, TEST_CYCLES_RECORD + TEST_CYCLES_PREEMPT);
+
+    /* The counter wraps in the middle of the calibration */
+    TestInit((TEST_CYCLES_RECORD * PROFILE_CALIB_LOOPS) - 1u, 0u);
+    TEST_EQUAL(profileOverhead, TEST_CYCLES_RECORD);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].max, TEST_CYCLES_RECORD);
+
+    /* A region after the calibration measures its body only */
+    TestRegion(PROFILE_EMPTY, 0u);
+    TEST_EQUAL(profileStat[PROFILE_EMPTY].min, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRegions
+********************************************************************************
+*
+* Summary:
+*   Random bodies in each application region are measured exactly after the
+*   overhead is subtracted, with their min, max and mean, across many wraps
+*   of the counter. A nested region adds the cost of its probes to the
+*   enclosing region, and the BLESS interrupt wrapper measures the handler.
+*
+*******************************************************************************/
+static void TestRegions(void)
+{
+    uint64 sum[PROFILE_REGION_COUNT];
+    uint32 min[PROFILE_REGION_COUNT];
+    uint32 max[PROFILE_REGION_COUNT];
+    uint32 count[PROFILE_REGION_COUNT];
+    PROFILE_REGION_T region;
+    uint32 body;
+    uint32 n;
+    uint32 errors = 0u;
+    uint8 i;
+
+    TestInit(0x00FFFFu, 0u);
+    (void)memset(sum, 0, sizeof(sum));
+    (void)memset(max, 0, sizeof(max));
+    (void)memset(count, 0, sizeof(count));
+    for(i = 0u; i < PROFILE_REGION_COUNT; i++)
+    {
+        min[i] = CY_SYS_SYST_RVR_CNT_MASK;
+    }
+
+    for(n = 0u; n < TEST_REGIONS; n++)
+    {
+        region = (PROFILE_REGION_T)(PROFILE_APP_CALLBACK + TestRand(PROFILE_DEBUG_OUT));
+        body = TestRand(TEST_CYCLES_MAX);
+        TestRegion(region, body);
+        count[region]++;
+        sum[region] += body;
+        min[region] = (body < min[region]) ? body : min[region];
+        max[region] = (body > max[region]) ? body : max[region];
+    }
+    for(i = PROFILE_APP_CALLBACK; i <= PROFILE_DEBUG_OUT; i++)
+    {
+        errors += (profileStat[i].count == count[i]) ? 0u : 1u;
+        errors += (profileStat[i].sum == sum[i]) ? 0u : 1u;
+        errors += (profileStat[i].min == min[i]) ? 0u : 1u;
+        errors += (profileStat[i].max == max[i]) ? 0u : 1u;
+    }
+    TEST_EQUAL(errors, 0u);
+    TEST_CHECK(count[PROFILE_WDT_ISR] != 0u);
+
+    /* Nested: the outer region counts both records of the inner probes */
+    TestInit(0x000100u, 0u);
+    PROFILE_ENTER(PROFILE_PROCESS_EVENTS);
+    TestAdvance(100u);
+    TestRegion(PROFILE_BLS_NTF, 250u);
+    TestAdvance(50u);
+    PROFILE_EXIT(PROFILE_PROCESS_EVENTS);
+    TEST_EQUAL(profileStat[PROFILE_BLS_NTF].max, 250u);
+    TEST_EQUAL(profileStat[PROFILE_PROCESS_EVENTS].max, 100u + 250u + 50u + (2u * TEST_CYCLES_RECORD));
+
+    /* The interrupt vector installed by ProfileInit() */
+    testBlessCalls = 0u;
+    testBlessVector();
+    TEST_EQUAL(testBlessCalls, 1u);
+    TEST_EQUAL(profileStat[PROFILE_BLESS_ISR].count, 1u);
+    TEST_EQUAL(profileStat[PROFILE_BLESS_ISR].max, TEST_CYCLES_BLESS);
+}
+
+
+/*******************************************************************************
+* Function Name: TestTrace
+********************************************************************************
+*
+* Summary:
+*   The ring keeps the raw stamps of the last PROFILE_TRACE_SIZE probes with
+*   their region and exit flag, and ProfilePrint() prints the statistics
+*   and the ring from the oldest record.
+*
+*******************************************************************************/
+static void TestTrace(void)
+{
+    uint32 stamps[PROFILE_TRACE_SIZE];
+    uint32 record;
+    uint32 idx;
+    uint32 errors = 0u;
+    uint32 n;
+    char line[64];
+    char *next;
+
+    TestInit(0x000040u, 0u);
+    for(n = 0u; n < (PROFILE_TRACE_SIZE / 2u) + 5u; n++)
+    {
+        stamps[(2u * n) & PROFILE_TRACE_MASK] = testReg.systCvr;
+        PROFILE_ENTER(PROFILE_BLS_IND);
+        TestAdvance(n);
+        stamps[((2u * n) + 1u) & PROFILE_TRACE_MASK] = testReg.systCvr;
+        PROFILE_EXIT(PROFILE_BLS_IND);
+    }
+    TEST_EQUAL(profileTraceIdx, (2u * PROFILE_CALIB_LOOPS) + (2u * n));
+    for(idx = 0u; idx < PROFILE_TRACE_SIZE; idx++)
+    {
+        record = profileTrace[(profileTraceIdx - PROFILE_TRACE_SIZE + idx) & PROFILE_TRACE_MASK];
+        n = (profileTraceIdx - (2u * PROFILE_CALIB_LOOPS) - PROFILE_TRACE_SIZE + idx) & PROFILE_TRACE_MASK;
+        errors += ((record & CY_SYS_SYST_RVR_CNT_MASK) == stamps[n]) ? 0u : 1u;
+        errors += ((record >> PROFILE_TRACE_TAG_SHIFT) ==
+            ((uint32)PROFILE_BLS_IND | (((n & 1u) != 0u) ? PROFILE_TRACE_EXIT : 0u))) ? 0u : 1u;
+    }
+    TEST_EQUAL(errors, 0u);
+
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    ProfilePrint();
+    testCapture = DISABLED;
+    testOut[testOutLen] = '\0';
+    (void)snprintf(line, sizeof(line), "(cycles, %u of overhead subtracted)", TEST_CYCLES_RECORD);
+    TEST_CHECK(strstr(testOut, line) != NULL);
+    (void)snprintf(line, sizeof(line), "  %u %u 0 %u %u ", PROFILE_BLS_IND, (PROFILE_TRACE_SIZE / 2u) + 5u,
+        ((PROFILE_TRACE_SIZE / 2u) + 4u) / 2u, (PROFILE_TRACE_SIZE / 2u) + 4u);
+    TEST_CHECK(strstr(testOut, line) != NULL);
+
+    /* The ring follows the statistics, oldest record first */
+    next = strstr(testOut, "Trace:");
+    TEST_CHECK(next != NULL);
+    for(idx = 0u; (next != NULL) && (idx < PROFILE_TRACE_SIZE); idx++)
+    {
+        n = (profileTraceIdx - (2u * PROFILE_CALIB_LOOPS) - PROFILE_TRACE_SIZE + idx) & PROFILE_TRACE_MASK;
+        (void)snprintf(line, sizeof(line), "  %u %u %x ", PROFILE_BLS_IND, n & 1u, stamps[n]);
+        next = strstr(next, line);
+    }
+    TEST_CHECK(next != NULL);
+}
+
+
+/*******************************************************************************
+* Function Name: TestBench
+********************************************************************************
+*
+* Summary:
+*   ProfileBench() decodes what it encodes and measures each benchmark
+*   region once per step.
+*
+*******************************************************************************/
+static void TestBench(void)
+{
+    TestInit(CY_SYS_SYST_RVR_CNT_MASK, 0u);
+    TEST_EQUAL(ProfileBench(), 0u);
+    TEST_EQUAL(profileStat[PROFILE_BENCH_ADC_TO_MV].count, PROFILE_BENCH_STEPS);
+    TEST_EQUAL(profileStat[PROFILE_BENCH_MV_TO_LEVEL].count, PROFILE_BENCH_STEPS);
+    TEST_EQUAL(profileStat[PROFILE_BENCH_CODEC_PUT].count, PROFILE_BENCH_STEPS);
+    TEST_CHECK(profileStat[PROFILE_BENCH_CODEC_DECODE].count > 1u);
+
+    /* No cycles pass in the model other than the records */
+    TEST_EQUAL(profileStat[PROFILE_BENCH_CODEC_PUT].max, 0u);
+}
+
+
+int main(void)
+{
+    TestOverhead();
+    TestRegions();
+    TestTrace();
+    TestBench();
+
+    return(TestResult("profile"));
+}
+
+
+/* [] END OF FILE */
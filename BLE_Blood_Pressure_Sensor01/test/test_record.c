@@ -0,0 +1,773 @@
+/*******************************************************************************
+* File Name: test_record.c
+*
+* Version 1.0
+*
+* Description:
+*  Checks the record store: the user partition a peer is given, and the
+*  indexed queries against linear scans over an empty partition, a single
+*  row, a full ring of 1000 appended records and deleted ranges. The
+*  queries are timed against the linear scan they replace. The delta codec
+*  has to give back every field of random records exactly, and its
+*  capacity and decode time are measured on readings of a home monitor.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <time.h>
+#include "test.h"
+#include "record.c"
+
+#define TEST_PEERS                  (CYBLE_GAP_MAX_BONDED_DEVICE + 1u)
+#define TEST_USER                   (1u)
+#define TEST_RECORDS                (1000u)
+#define TEST_BENCH_QUERIES          (20000u)
+#define TEST_CODEC_RECORDS          (200000u)
+#define TEST_RAW_PER_ROW            (5u)        /* 19-byte records of the previous layout in a row */
+
+static const CYBLE_DATE_TIME_T testBase = {2016u, 3u, 1u, 8u, 0u, 0u};
+
+/* Peer addresses by device handle, and the bonded device list of the stack */
+static CYBLE_GAP_BD_ADDR_T testPeer[TEST_PEERS];
+static CYBLE_GAP_BONDED_DEV_ADDR_LIST_T testBonded;
+
+/* Seconds after testBase of every appended record, by sequence number */
+static uint32 testTime[TEST_RECORDS + 1u];
+static uint8 testDeleted[TEST_RECORDS + 1u];
+
+static uint32 testRandom = 1u;
+
+
+/*******************************************************************************
+* Function Name: CyBle_GapGetPeerBdAddr
+********************************************************************************
+*
+* Summary:
+*   Returns the address of the simulated peer.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GapGetPeerBdAddr(uint8 bdHandle, CYBLE_GAP_BD_ADDR_T* peerBdAddr)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_NO_DEVICE_ENTITY;
+
+    if(bdHandle < TEST_PEERS)
+    {
+        *peerBdAddr = testPeer[bdHandle];
+        apiResult = CYBLE_ERROR_OK;
+    }
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GapGetBondedDevicesList
+********************************************************************************
+*
+* Summary:
+*   Returns the simulated bonded device list.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GapGetBondedDevicesList(CYBLE_GAP_BONDED_DEV_ADDR_LIST_T* bondedDevList)
+{
+    *bondedDevList = testBonded;
+    return(CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: TestUsers
+********************************************************************************
+*
+* Summary:
+*   Gives every peer a distinct address, bonds two of them, and checks that
+*   only the bonded peers get a partition of their own.
+*
+*******************************************************************************/
+static void TestUsers(void)
+{
+    uint8 i;
+
+    for(i = 0u; i < TEST_PEERS; i++)
+    {
+        testPeer[i].bdAddr[0u] = (uint8)(0xA0u + i);
+        testPeer[i].bdAddr[5u] = 0x00u;
+        testPeer[i].type = 0u;
+    }
+
+    /* Nothing bonded: every peer is a guest */
+    for(i = 0u; i < TEST_PEERS; i++)
+    {
+        TEST_EQUAL(RecordUserOf(i), REC_USER_GUEST);
+    }
+
+    /* Handles 1 and 3 bonded, listed in a different order than their handles */
+    testBonded.count = 2u;
+    testBonded.bdAddrList[0u] = testPeer[3u];
+    testBonded.bdAddrList[1u] = testPeer[1u];
+    TEST_EQUAL(RecordUserOf(0u), REC_USER_GUEST);
+    TEST_EQUAL(RecordUserOf(1u), 1u);
+    TEST_EQUAL(RecordUserOf(2u), REC_USER_GUEST);
+    TEST_EQUAL(RecordUserOf(3u), 3u);
+    TEST_EQUAL(RecordUserOf(CYBLE_GAP_MAX_BONDED_DEVICE), REC_USER_GUEST);
+    TEST_EQUAL(RecordUid(RecordUserOf(3u)), 4u);
+    TEST_EQUAL(RecordUid(REC_USER_GUEST), REC_UID_UNKNOWN);
+
+    /* Same address, other type: a different device */
+    testPeer[1u].type = 1u;
+    TEST_EQUAL(RecordUserOf(1u), REC_USER_GUEST);
+    testPeer[1u].type = 0u;
+
+    /* A guest that is handed the handle of a bond slot does not get its records */
+    testBonded.count = 1u;
+    TEST_EQUAL(RecordUserOf(1u), REC_USER_GUEST);
+}
+
+
+/*******************************************************************************
+* Function Name: TestErase
+********************************************************************************
+*
+* Summary:
+*   Erases all partitions and the acknowledgements, as a new device.
+*
+*******************************************************************************/
+static void TestErase(void)
+{
+    uint8 row[CY_FLASH_SIZEOF_ROW] = {0u};
+    uint8 user;
+    uint8 i;
+
+    for(user = 0u; user < REC_USERS; user++)
+    {
+        for(i = 0u; i < REC_ROWS_PER_USER; i++)
+        {
+            (void)CyBle_StoreAppData(row, recFlash[user][i], sizeof(row), 0u);
+        }
+    }
+    (void)CyBle_StoreAppData(row, recAckFlash, sizeof(row), 0u);
+    (void)memset(testDeleted, 0, sizeof(testDeleted));
+    RecordInit();
+}
+
+
+/*******************************************************************************
+* Function Name: TestAppend
+********************************************************************************
+*
+* Summary:
+*   Appends a record stamped the given number of seconds after testBase.
+*   The values wander, so the rows hold varying numbers of delta records.
+*
+*******************************************************************************/
+static void TestAppend(uint32 seconds)
+{
+    CYBLE_BLS_BPM_T rec = {0x1Eu, 120u, 80u, 93u, {0u}, 70u, 0u, 0u};
+    uint32 seq = RecordLastSeq(TEST_USER) + 1u;
+
+    rec.sys = (sfloat)(110u + ((seq * 7u) % 40u));
+    rec.dia = (sfloat)(70u + ((seq * 3u) % 20u));
+    rec.prt = (sfloat)(60u + (seq % 30u));
+    rec.mst = ((seq % 11u) == 0u) ? 0x0004u : 0u;
+    rec.time = testBase;
+    RtcAddSeconds(&rec.time, seconds);
+    testTime[seq] = seconds;
+    TEST_EQUAL(RecordAppend(TEST_USER, &rec), CYBLE_ERROR_OK);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRefFindRow
+********************************************************************************
+*
+* Summary:
+*   RecordFindRow() as a linear scan over the row headers.
+*
+*******************************************************************************/
+static uint32 TestRefFindRow(uint32 seq)
+{
+    uint32 rowSeq;
+    const REC_ROW_T *row;
+
+    for(rowSeq = RecordOldest(TEST_USER); rowSeq < recPart[TEST_USER].headSeq; rowSeq++)
+    {
+        row = RecordRow(TEST_USER, rowSeq);
+        if((row->firstSeq + row->count - 1u) >= seq)
+        {
+            break;
+        }
+    }
+    return(rowSeq);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRefSeqAtTime
+********************************************************************************
+*
+* Summary:
+*   RecordSeqAtTime() as a linear scan over the records that were appended.
+*
+*******************************************************************************/
+static uint32 TestRefSeqAtTime(uint32 seconds, uint8 after)
+{
+    uint32 seq;
+    uint32 last = RecordLastSeq(TEST_USER);
+
+    for(seq = RecordFirstSeq(TEST_USER); seq <= last; seq++)
+    {
+        if((testTime[seq] > seconds) || ((testTime[seq] == seconds) && (after == DISABLED)))
+        {
+            break;
+        }
+    }
+    return(seq);
+}
+
+
+/*******************************************************************************
+* Function Name: TestScanSeqAtTime
+********************************************************************************
+*
+* Summary:
+*   RecordSeqAtTime() as the firmware would do it without the row index:
+*   every record read through a cursor and compared.
+*
+*******************************************************************************/
+static uint32 TestScanSeqAtTime(const CYBLE_DATE_TIME_T *time, uint8 after)
+{
+    REC_CURSOR_T cursor;
+    CYBLE_BLS_BPM_T rec;
+    CYBLE_DATE_TIME_COMP_T comp;
+    uint32 seq;
+    uint32 result = RecordLastSeq(TEST_USER) + 1u;
+
+    RecordCursorInit(&cursor, TEST_USER);
+    while(RecordRead(&cursor, &rec, &seq) != DISABLED)
+    {
+        comp = RtcCompare(&rec.time, time);
+        if((comp == CYBLE_TIME_GREAT) || ((comp == CYBLE_TIME_EQUAL) && (after == DISABLED)))
+        {
+            result = seq;
+            break;
+        }
+        RecordNext(&cursor);
+    }
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCheckQueries
+********************************************************************************
+*
+* Summary:
+*   Compares the indexed queries with the linear scans for every stored
+*   sequence number and time stamp, their neighbours, and the values before
+*   the first and after the last record.
+*
+*******************************************************************************/
+static void TestCheckQueries(void)
+{
+    CYBLE_DATE_TIME_T time;
+    uint32 first = RecordFirstSeq(TEST_USER);
+    uint32 last = RecordLastSeq(TEST_USER);
+    uint32 seq;
+    uint32 count = 0u;
+    uint32 mismatches = 0u;
+    int32 delta;
+    uint8 after;
+
+    for(seq = (first > 2u) ? (first - 2u) : 0u; seq <= (last + 2u); seq++)
+    {
+        if(RecordFindRow(TEST_USER, seq) != TestRefFindRow(seq))
+        {
+            mismatches++;
+        }
+    }
+    TEST_EQUAL(mismatches, 0u);
+
+    for(seq = first; seq <= last; seq++)
+    {
+        for(delta = -1; delta <= 1; delta++)
+        {
+            if(((int32)testTime[seq] + delta) < 0)
+            {
+                continue;
+            }
+            time = testBase;
+            RtcAddSeconds(&time, (uint32)((int32)testTime[seq] + delta));
+            for(after = DISABLED; after <= ENABLED; after++)
+            {
+                if(RecordSeqAtTime(TEST_USER, &time, after) !=
+                   TestRefSeqAtTime((uint32)((int32)testTime[seq] + delta), after))
+                {
+                    mismatches++;
+                }
+            }
+        }
+        count += (testDeleted[seq] == 0u) ? 1u : 0u;
+    }
+    TEST_EQUAL(mismatches, 0u);
+    TEST_EQUAL(RecordCount(TEST_USER), count);
+
+    /* Before the first and after the last record */
+    time = testBase;
+    TEST_EQUAL(RecordSeqAtTime(TEST_USER, &time, DISABLED), (last != 0u) ? first : 1u);
+    time.year++;
+    TEST_EQUAL(RecordSeqAtTime(TEST_USER, &time, DISABLED), last + 1u);
+    TEST_EQUAL(RecordSeqAtTime(TEST_USER, &time, ENABLED), last + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestDelete
+********************************************************************************
+*
+* Summary:
+*   Deletes the range and checks the count of every range around its edges
+*   and that a cursor skips exactly the deleted records.
+*
+*******************************************************************************/
+static void TestDelete(uint32 from, uint32 to)
+{
+    REC_CURSOR_T cursor;
+    CYBLE_BLS_BPM_T rec;
+    uint32 first = RecordFirstSeq(TEST_USER);
+    uint32 last = RecordLastSeq(TEST_USER);
+    uint32 seq;
+    uint32 expected = first;
+    uint32 mismatches = 0u;
+    uint32 count;
+    uint32 i;
+
+    TEST_EQUAL(RecordDeleteRange(TEST_USER, from, to), CYBLE_ERROR_OK);
+    for(seq = from; seq <= to; seq++)
+    {
+        if((seq >= first) && (seq <= last))
+        {
+            testDeleted[seq] = 1u;
+        }
+    }
+
+    /* Ranges starting and ending one before, at and one after each edge */
+    for(seq = from - 1u; seq <= (from + 1u); seq++)
+    {
+        for(i = to - 1u; i <= (to + 1u); i++)
+        {
+            count = 0u;
+            for(expected = ((seq > first) ? seq : first); (expected <= i) && (expected <= last); expected++)
+            {
+                count += (testDeleted[expected] == 0u) ? 1u : 0u;
+            }
+            if(RecordCountRange(TEST_USER, seq, i) != count)
+            {
+                mismatches++;
+            }
+        }
+    }
+    TEST_EQUAL(mismatches, 0u);
+
+    RecordCursorSeek(&cursor, TEST_USER, from - 1u);
+    expected = ((from - 1u) > first) ? (from - 1u) : first;
+    while((expected <= last) && (testDeleted[expected] != 0u))
+    {
+        expected++;
+    }
+    while(RecordRead(&cursor, &rec, &seq) != DISABLED)
+    {
+        if(seq != expected)
+        {
+            mismatches++;
+        }
+        RecordNext(&cursor);
+        expected++;
+        while((expected <= last) && (testDeleted[expected] != 0u))
+        {
+            expected++;
+        }
+    }
+    TEST_EQUAL(mismatches, 0u);
+    TEST_EQUAL(expected, last + 1u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRand
+********************************************************************************
+*
+* Summary:
+*   Returns a pseudo random number below the limit.
+*
+*******************************************************************************/
+static uint32 TestRand(uint32 limit)
+{
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    return((testRandom >> 8u) % limit);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandField
+********************************************************************************
+*
+* Summary:
+*   Changes a 16-bit field the way the codec has to handle: unchanged, a
+*   small step either way, or any value, NaN and reserved SFLOATs included.
+*
+*******************************************************************************/
+static uint16 TestRandField(uint16 val)
+{
+    uint32 kind = TestRand(20u);
+
+    if(kind < 6u)
+    {
+        /* Unchanged */
+    }
+    else if(kind < 16u)
+    {
+        val = (uint16)(val + TestRand(41u) - 20u);
+    }
+    else if(kind < 18u)
+    {
+        val = (uint16)TestRand(0x10000u);
+    }
+    else
+    {
+        val = (TestRand(2u) == 0u) ? 0x07FFu : 0x0800u;
+    }
+    return(val);
+}
+
+
+/*******************************************************************************
+* Function Name: TestRandRecord
+********************************************************************************
+*
+* Summary:
+*   Derives a random record from the previous one. The time stamp stays,
+*   steps by seconds, minutes or weeks, or goes back, and wraps to the
+*   first supported year before the last one is reached.
+*
+*******************************************************************************/
+static void TestRandRecord(CYBLE_BLS_BPM_T *rec)
+{
+    uint32 kind = TestRand(20u);
+
+    rec->flags = (TestRand(20u) == 0u) ? (uint8)TestRand(0x20u) : rec->flags;
+    rec->sys = TestRandField(rec->sys);
+    rec->dia = TestRandField(rec->dia);
+    rec->map = TestRandField(rec->map);
+    rec->prt = TestRandField(rec->prt);
+    rec->mst = (TestRand(20u) == 0u) ? (uint16)TestRand(0x10000u) : rec->mst;
+
+    if(kind < 2u)
+    {
+        /* Same time stamp */
+    }
+    else if(kind < 16u)
+    {
+        RtcAddSeconds(&rec->time, TestRand((kind < 8u) ? 60u : 86400u) + 1u);
+    }
+    else if(kind < 18u)
+    {
+        RtcAddSeconds(&rec->time, TestRand(60u * RTC_SECONDS_PER_DAY));
+    }
+    else
+    {
+        /* Clock set back by up to two days */
+        RtcAddSeconds(&rec->time, RTC_SECONDS_PER_DAY * 4u);
+        rec->time.day = (uint8)((rec->time.day > 2u) ? (rec->time.day - 2u) : 1u);
+        rec->time.hours = (uint8)TestRand(24u);
+    }
+    if(rec->time.year >= (RTC_YEAR_MAX - 1u))
+    {
+        rec->time.year = RTC_YEAR_MIN + (uint16)TestRand(10u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestSameRecord
+********************************************************************************
+*
+* Summary:
+*   Compares all fields of two records.
+*
+*******************************************************************************/
+static uint8 TestSameRecord(const CYBLE_BLS_BPM_T *a, const CYBLE_BLS_BPM_T *b)
+{
+    return(((a->flags == b->flags) && (a->sys == b->sys) && (a->dia == b->dia) && (a->map == b->map) &&
+            (RtcCompare(&a->time, &b->time) == CYBLE_TIME_EQUAL) && (a->time.year == b->time.year) &&
+            (a->prt == b->prt) && (a->uid == b->uid) && (a->mst == b->mst)) ? ENABLED : DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCodecRoundTrip
+********************************************************************************
+*
+* Summary:
+*   Packs random records into rows the way RecordAppend() does and decodes
+*   every row back, in sequence and by index.
+*
+*******************************************************************************/
+static void TestCodecRoundTrip(void)
+{
+    static REC_ROW_T row;
+    static CYBLE_BLS_BPM_T in[REC_PER_ROW];
+    CYBLE_BLS_BPM_T rec = {0x1Eu, 120u, 80u, 93u, {0u}, 70u, 0u, 0u};
+    CYBLE_BLS_BPM_T out;
+    uint8 buf[REC_DELTA_MAX];
+    uint8 len;
+    uint8 pos;
+    uint8 i;
+    uint32 n = 0u;
+    uint32 mismatches = 0u;
+    uint32 bytes = 0u;
+
+    rec.time = testBase;
+    rec.uid = 3u;
+    (void)memset(&row, 0, sizeof(row));
+    row.uid = rec.uid;
+    while(n < TEST_CODEC_RECORDS)
+    {
+        TestRandRecord(&rec);
+        len = RecordEncode(buf, (row.count == 0u) ? 0 : &in[row.count - 1u], &rec);
+        if((row.count == REC_PER_ROW) || ((row.used + len) > REC_ROW_DATA_SIZE))
+        {
+            /* Row full: decode it and start the next one with a keyframe */
+            pos = 0u;
+            for(i = 0u; i < row.count; i++)
+            {
+                RecordDecode(&row, &pos, &out);
+                mismatches += (TestSameRecord(&out, &in[i]) == ENABLED) ? 0u : 1u;
+                TEST_EQUAL(RecordDecodeAt(&row, i, &out), pos);
+                mismatches += (TestSameRecord(&out, &in[i]) == ENABLED) ? 0u : 1u;
+            }
+            TEST_EQUAL(pos, row.used);
+            row.count = 0u;
+            row.used = 0u;
+            len = RecordEncode(buf, 0, &rec);
+        }
+        TEST_CHECK(len <= REC_DELTA_MAX);
+        (void)memcpy(&row.data[row.used], buf, len);
+        row.used += len;
+        in[row.count] = rec;
+        row.count++;
+        bytes += len;
+        n++;
+    }
+    TEST_EQUAL(mismatches, 0u);
+    printf("Codec: %ld random records round trip, %ld bytes each on average \r\n", n, bytes / n);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCodecCapacity
+********************************************************************************
+*
+* Summary:
+*   Stores readings of a home monitor taken the given seconds apart and
+*   reads them back through a cursor. Returns the records a row holds on
+*   average; the decode time of a record is returned in ns.
+*
+*******************************************************************************/
+static uint32 TestCodecCapacity(uint32 interval, uint32 *decodeNs)
+{
+    CYBLE_BLS_BPM_T rec = {0x1Eu, 124u, 82u, 96u, {0u}, 68u, 0u, 0u};
+    CYBLE_BLS_BPM_T out;
+    REC_CURSOR_T cursor;
+    struct timespec start;
+    struct timespec end;
+    uint32 seq;
+    uint32 n;
+    uint32 mismatches = 0u;
+    uint32 reads = 0u;
+
+    TestErase();
+    rec.time = testBase;
+    for(n = 0u; n < TEST_RECORDS; n++)
+    {
+        rec.sys = (uint16)(rec.sys + TestRand(13u) - 6u);
+        rec.dia = (uint16)(rec.dia + TestRand(9u) - 4u);
+        rec.map = (uint16)(rec.dia + ((rec.sys - rec.dia) / 3u));
+        rec.prt = (uint16)(rec.prt + TestRand(9u) - 4u);
+        rec.mst = (TestRand(16u) == 0u) ? 0x0004u : 0u;
+        RtcAddSeconds(&rec.time, interval + TestRand(interval / 8u));
+        TEST_EQUAL(RecordAppend(TEST_USER, &rec), CYBLE_ERROR_OK);
+
+        /* The newest record reads back as stored */
+        RecordCursorSeek(&cursor, TEST_USER, n + 1u);
+        TEST_EQUAL(RecordRead(&cursor, &out, &seq), ENABLED);
+        TEST_EQUAL(seq, n + 1u);
+        mismatches += (TestSameRecord(&out, &rec) == ENABLED) ? 0u : 1u;
+    }
+    TEST_EQUAL(mismatches, 0u);
+    TEST_EQUAL(recPart[TEST_USER].rows, REC_ROWS_PER_USER);
+
+    /* Rebuilding every kept record, as the upload does for each indication */
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(n = 0u; n < 100u; n++)
+    {
+        RecordCursorSeek(&cursor, TEST_USER, 1u);
+        while(RecordRead(&cursor, &out, &seq) == ENABLED)
+        {
+            RecordNext(&cursor);
+            reads++;
+        }
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    *decodeNs = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) / reads);
+    TEST_EQUAL(TestSameRecord(&out, &rec), ENABLED);
+    return(RecordCount(TEST_USER) / REC_ROWS_PER_USER);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCodec
+********************************************************************************
+*
+* Summary:
+*   Round trip of the codec, and the capacity of a partition with readings
+*   a minute apart and three a day.
+*
+*******************************************************************************/
+static void TestCodec(void)
+{
+    uint32 perRowMinute;
+    uint32 perRowDaily;
+    uint32 decodeNs;
+
+    TestCodecRoundTrip();
+    perRowMinute = TestCodecCapacity(60u, &decodeNs);
+    perRowDaily = TestCodecCapacity(8u * 3600u, &decodeNs);
+    TEST_CHECK(perRowMinute >= (2u * TEST_RAW_PER_ROW));
+    TEST_CHECK(perRowDaily >= (2u * TEST_RAW_PER_ROW));
+    printf("Records per row: %ld a minute apart, %ld three a day, %d before; %ld ns to rebuild a record \r\n",
+        perRowMinute, perRowDaily, TEST_RAW_PER_ROW, decodeNs);
+}
+
+
+/*******************************************************************************
+* Function Name: TestQueries
+********************************************************************************
+*
+* Summary:
+*   Runs the query checks on an empty partition, a single row, and a ring
+*   that has overwritten its oldest rows many times, then times them.
+*
+*******************************************************************************/
+static void TestQueries(void)
+{
+    CYBLE_DATE_TIME_T time = testBase;
+    CYBLE_BLS_BPM_T rec;
+    REC_CURSOR_T cursor;
+    struct timespec start;
+    struct timespec end;
+    uint32 indexedNs;
+    uint32 scanNs;
+    uint32 seconds = 60u;
+    uint32 seq;
+    uint32 i;
+
+    /* Empty partition */
+    TestErase();
+    TEST_EQUAL(RecordFirstSeq(TEST_USER), 1u);
+    TEST_EQUAL(RecordLastSeq(TEST_USER), 0u);
+    TEST_EQUAL(RecordCount(TEST_USER), 0u);
+    TEST_EQUAL(RecordSeqAtTime(TEST_USER, &time, DISABLED), 1u);
+    TEST_EQUAL(RecordCountRange(TEST_USER, 1u, REC_SEQ_MAX), 0u);
+    TEST_EQUAL(RecordDeleteRange(TEST_USER, 1u, REC_SEQ_MAX), CYBLE_ERROR_OK);
+    RecordCursorSeek(&cursor, TEST_USER, 1u);
+    TEST_EQUAL(RecordRead(&cursor, &rec, &seq), DISABLED);
+
+    /* A single record, then a single row */
+    TestAppend(seconds);
+    TEST_EQUAL(recPart[TEST_USER].rows, 1u);
+    TEST_EQUAL(RecordFindRow(TEST_USER, 0u), 1u);
+    TEST_EQUAL(RecordFindRow(TEST_USER, 5u), 1u);
+    TestCheckQueries();
+    for(i = 1u; i < 5u; i++)
+    {
+        seconds += ((i % 3u) == 0u) ? 0u : 60u;
+        TestAppend(seconds);
+    }
+    TEST_EQUAL(recPart[TEST_USER].rows, 1u);
+    TestCheckQueries();
+    TestDelete(2u, 3u);
+    TestCheckQueries();
+
+    /* Many records: the ring wraps and the oldest records are gone */
+    TestErase();
+    seconds = 0u;
+    for(i = 1u; i <= TEST_RECORDS; i++)
+    {
+        seconds += ((i % 5u) == 0u) ? 0u : (60u + (i % 7u) * 600u);
+        TestAppend(seconds);
+    }
+    TEST_EQUAL(RecordLastSeq(TEST_USER), TEST_RECORDS);
+    TEST_EQUAL(recPart[TEST_USER].rows, REC_ROWS_PER_USER);
+    TEST_CHECK(RecordFirstSeq(TEST_USER) > 1u);
+    TestCheckQueries();
+
+    /* Deleted ranges: one row exactly, across rows, the oldest and the newest record */
+    seq = RecordRow(TEST_USER, recPart[TEST_USER].headSeq - 5u)->firstSeq;
+    TestDelete(seq, seq + RecordRow(TEST_USER, recPart[TEST_USER].headSeq - 5u)->count - 1u);
+    seq = RecordRow(TEST_USER, recPart[TEST_USER].headSeq - 2u)->firstSeq;
+    TestDelete(seq - 3u, seq + 2u);
+    TestDelete(RecordFirstSeq(TEST_USER), RecordFirstSeq(TEST_USER));
+    TestDelete(TEST_RECORDS, TEST_RECORDS);
+    TestCheckQueries();
+
+    /* State rebuilt from flash after a reset */
+    seq = RecordFirstSeq(TEST_USER);
+    RecordInit();
+    TEST_EQUAL(RecordFirstSeq(TEST_USER), seq);
+    TEST_EQUAL(RecordLastSeq(TEST_USER), TEST_RECORDS);
+    TestCheckQueries();
+
+    /* Indexed search against the cursor scan it replaces */
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0u; i < TEST_BENCH_QUERIES; i++)
+    {
+        time = testBase;
+        RtcAddSeconds(&time, (i * 7919u) % (seconds + 600u));
+        seq += TestScanSeqAtTime(&time, DISABLED);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    scanNs = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) /
+                      TEST_BENCH_QUERIES);
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &start);
+    for(i = 0u; i < TEST_BENCH_QUERIES; i++)
+    {
+        time = testBase;
+        RtcAddSeconds(&time, (i * 7919u) % (seconds + 600u));
+        seq += RecordSeqAtTime(TEST_USER, &time, DISABLED);
+    }
+    (void)clock_gettime(CLOCK_MONOTONIC, &end);
+    indexedNs = (uint32)(((end.tv_sec - start.tv_sec) * 1000000000L + (end.tv_nsec - start.tv_nsec)) /
+                         TEST_BENCH_QUERIES);
+    TEST_CHECK(seq != 0u);
+
+    printf("%d records appended, %ld kept in %d rows: seq at time %ld ns indexed, %ld ns by cursor scan \r\n",
+        TEST_RECORDS, RecordLastSeq(TEST_USER) - RecordFirstSeq(TEST_USER) + 1u, recPart[TEST_USER].rows,
+        indexedNs, scanNs);
+}
+
+
+int main(void)
+{
+    TestUsers();
+    TestQueries();
+    TestCodec();
+
+    return(TestResult("record"));
+}
+
+
+/* [] END OF FILE */
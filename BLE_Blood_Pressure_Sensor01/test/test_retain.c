@@ -0,0 +1,299 @@
+/*******************************************************************************
+* File Name: test_retain.c
+*
+* Version 1.0
+*
+* Description:
+*  State retained through Hibernate. The snapshot taken by RetainSave() is
+*  kept in place while a reset clears the state of the modules, as the
+*  start-up code does, and RetainRestore() runs with the reset reason of
+*  the model. A Hibernate wakeup must bring back the measurement counter,
+*  the drift estimate, the calendar and the energy accounting; a corrupted
+*  snapshot, another layout version or another reset must start cold.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "retain.c"
+#include "rtc.c"
+#include "energy.c"
+
+#define TEST_OUT_SIZE               (256u)
+#define TEST_CYCLES                 (20u)       /* Hibernate cycles in a row */
+#define TEST_SECOND_TICKS           (1u << WDT_TICKS_SHIFT)
+
+uint8 blsSim;
+
+static char testOut[TEST_OUT_SIZE];
+static uint32 testOutLen;
+static uint8 testCapture;
+static uint32 testResetReason = CY_PM_RESET_REASON_XRES;
+static uint32 testTicks;
+static uint32 testAckStores;
+
+
+/***************************************
+*       Components and modules
+***************************************/
+uint32 CySysPmGetResetReason(void)
+{
+    return(testResetReason);
+}
+
+uint32 WDT_ReadTicks(void)
+{
+    return(testTicks);
+}
+
+CYBLE_API_RESULT_T RecordAckStore(void)
+{
+    testAckStores++;
+    return(CYBLE_ERROR_OK);
+}
+
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testCapture == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+    else if(testOutLen < (TEST_OUT_SIZE - 1u))
+    {
+        testOut[testOutLen] = (char)txData;
+        testOutLen++;
+    }
+    else
+    {
+        /* A longer output fails on the missing line */
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestRun
+********************************************************************************
+*
+* Summary:
+*   Runs the application between two resets: a number of measurements, a
+*   drift estimate, a calendar and some seconds in each power mode.
+*
+*******************************************************************************/
+static void TestRun(uint8 measurements, int32 driftPpm, const CYBLE_DATE_TIME_T *time)
+{
+    blsSim = (uint8)(blsSim + measurements);
+    rtcDriftPpm = driftPpm;
+    RtcResume(time);
+
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+    testTicks += 3u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_SLEEP, 0u);
+    testTicks += 5u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_DEEPSLEEP, 0u);
+    testTicks += 60u * TEST_SECOND_TICKS;
+    EnergySetMode(ENERGY_MODE_ACTIVE, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestReset
+********************************************************************************
+*
+* Summary:
+*   Resets the model for the reason: the module state is initialized as at
+*   start-up, the snapshot stays where it is, and RetainRestore() runs.
+*
+* Return:
+*   The result of RetainRestore().
+*
+*******************************************************************************/
+static uint8 TestReset(uint32 reason)
+{
+    uint8 result;
+
+    blsSim = 0u;
+    rtcDriftPpm = 0;
+    (void)memset(energyMode, 0, sizeof(energyMode));
+    energyCharge = 0u;
+    energyChargeFrac = 0u;
+    testTicks = 0u;
+    EnergyInit();
+    RtcInit();
+
+    testResetReason = reason;
+    testOutLen = 0u;
+    testCapture = ENABLED;
+    result = RetainRestore();
+    testCapture = DISABLED;
+    testOut[testOutLen] = '\0';
+    return(result);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCold
+********************************************************************************
+*
+* Summary:
+*   Checks that the state is the one of a cold start and that the snapshot
+*   is invalidated.
+*
+*******************************************************************************/
+static void TestCold(uint32 line)
+{
+    CYBLE_DATE_TIME_T time;
+    ENERGY_REPORT_T report;
+
+    RtcGetTime(&time);
+    EnergyGetReport(&report);
+    if((TEST_EQUAL(blsSim, 0u) == DISABLED) || (TEST_EQUAL(rtcDriftPpm, 0) == DISABLED) ||
+       (TEST_EQUAL(time.year, RTC_DEFAULT_YEAR) == DISABLED) || (TEST_EQUAL(report.charge, 0u) == DISABLED) ||
+       (TEST_EQUAL(report.deepSleep, 0u) == DISABLED) || (TEST_EQUAL(retain.magic, 0u) == DISABLED) ||
+       (TEST_EQUAL(testOutLen, 0u) == DISABLED))
+    {
+        printf("  after the reset of line %ld \r\n", line);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestWakeup
+********************************************************************************
+*
+* Summary:
+*   Saves the state and restores it after a Hibernate wakeup, for a number
+*   of cycles: the state continues where it was saved and the counter of
+*   Hibernate cycles counts up.
+*
+*******************************************************************************/
+static void TestWakeup(void)
+{
+    CYBLE_DATE_TIME_T saved = {2016u, 2u, 29u, 23u, 59u, 58u};
+    CYBLE_DATE_TIME_T time;
+    ENERGY_REPORT_T expected;
+    ENERGY_REPORT_T report;
+    char line[48];
+    uint32 errors = 0u;
+    uint32 i;
+
+    TEST_EQUAL(TestReset(CY_PM_RESET_REASON_XRES), DISABLED);
+    for(i = 1u; i <= TEST_CYCLES; i++)
+    {
+        saved.minutes = (uint8)i;
+        TestRun(3u, -(int32)(i * 7u), &saved);
+        EnergyGetReport(&expected);
+        RetainSave();
+        errors += (testAckStores == i) ? 0u : 1u;
+
+        errors += (TestReset(CY_PM_RESET_REASON_WAKEUP_HIB) == ENABLED) ? 0u : 1u;
+        RtcGetTime(&time);
+        EnergyGetReport(&report);
+        errors += (blsSim == (uint8)(3u * i)) ? 0u : 1u;
+        errors += (rtcDriftPpm == -(int32)(i * 7u)) ? 0u : 1u;
+        errors += (memcmp(&time, &saved, sizeof(time)) == 0) ? 0u : 1u;
+        errors += (memcmp(&report, &expected, sizeof(report)) == 0) ? 0u : 1u;
+        errors += (report.deepSleep == (60u * i)) ? 0u : 1u;
+        errors += (retain.hibernations == i) ? 0u : 1u;
+        (void)snprintf(line, sizeof(line), "Resumed from Hibernate %u ", i);
+        errors += (strstr(testOut, line) != NULL) ? 0u : 1u;
+    }
+    TEST_EQUAL(errors, 0u);
+    TEST_CHECK(report.charge != 0u);
+    TEST_EQUAL(report.active, 3u * TEST_CYCLES);
+    TEST_EQUAL(report.sleep, 5u * TEST_CYCLES);
+}
+
+
+/*******************************************************************************
+* Function Name: TestInvalid
+********************************************************************************
+*
+* Summary:
+*   A snapshot with a wrong CRC, a snapshot of another version and any reset
+*   other than a Hibernate wakeup start cold, and the next snapshot counts
+*   the Hibernate cycles from one again.
+*
+*******************************************************************************/
+static void TestInvalid(void)
+{
+    CYBLE_DATE_TIME_T saved = {2016u, 3u, 1u, 12u, 0u, 0u};
+    const uint32 reasons[] = {CY_PM_RESET_REASON_XRES, CY_PM_RESET_REASON_UNKN, CY_PM_RESET_REASON_WAKEUP_STOP};
+    uint8 i;
+
+    /* A valid snapshot after a few cycles */
+    (void)TestReset(CY_PM_RESET_REASON_XRES);
+    for(i = 0u; i < 3u; i++)
+    {
+        TestRun(1u, 15, &saved);
+        RetainSave();
+        TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), ENABLED);
+    }
+    TEST_EQUAL(retain.hibernations, 3u);
+
+    /* A bit flipped in the calendar */
+    TestRun(1u, 15, &saved);
+    RetainSave();
+    retain.time.hours ^= 0x04u;
+    TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), DISABLED);
+    TestCold(__LINE__);
+    TestRun(1u, 15, &saved);
+    RetainSave();
+    TEST_EQUAL(retain.hibernations, 1u);
+
+    /* The CRC itself corrupted */
+    TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), ENABLED);
+    TestRun(1u, 15, &saved);
+    RetainSave();
+    TEST_EQUAL(retain.hibernations, 2u);
+    retain.crc ^= 0x8000u;
+    TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), DISABLED);
+    TestCold(__LINE__);
+
+    /* A snapshot of another layout, with a CRC that matches */
+    TestRun(1u, 15, &saved);
+    RetainSave();
+    retain.version = RETAIN_VERSION + 1u;
+    retain.crc = CalCrc16((const uint8 *)&retain, offsetof(RETAIN_T, crc));
+    TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), DISABLED);
+    TestCold(__LINE__);
+    TestRun(1u, 15, &saved);
+    RetainSave();
+    TEST_EQUAL(retain.hibernations, 1u);
+    TEST_EQUAL(retain.version, RETAIN_VERSION);
+
+    /* A valid snapshot after a power-on, an external reset or a Stop wakeup */
+    for(i = 0u; i < (sizeof(reasons) / sizeof(reasons[0u])); i++)
+    {
+        TestRun(1u, 15, &saved);
+        RetainSave();
+        TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), ENABLED);
+        TestRun(1u, 15, &saved);
+        RetainSave();
+        TEST_CHECK(retain.hibernations > 1u);
+        TEST_EQUAL(TestReset(reasons[i]), DISABLED);
+        TestCold(__LINE__);
+
+        /* A Hibernate wakeup after it finds no snapshot either */
+        TEST_EQUAL(TestReset(CY_PM_RESET_REASON_WAKEUP_HIB), DISABLED);
+        TestRun(1u, 15, &saved);
+        RetainSave();
+        TEST_EQUAL(retain.hibernations, 1u);
+    }
+}
+
+
+int main(void)
+{
+    TestWakeup();
+    TestInvalid();
+
+    return(TestResult("retain"));
+}
+
+
+/* [] END OF FILE */
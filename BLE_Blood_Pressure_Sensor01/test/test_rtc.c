@@ -0,0 +1,205 @@
+/*******************************************************************************
+* File Name: test_rtc.c
+*
+* Version 1.0
+*
+* Description:
+*  Checks the calendar rollovers, the interval arithmetic against second by
+*  second stepping, the month bounds, and the drift correction against a
+*  simulated WDT that runs fast.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include "test.h"
+#include "rtc.c"
+
+#define TEST_WDT_PPM                (250)       /* The simulated WDT runs fast by this much */
+#define TEST_DRIFT_SPAN_DAYS        (2u)        /* Between the two reference times */
+#define TEST_RUN_DAYS               (30u)       /* Free running after the drift estimate */
+#define TEST_STEP_DAYS              (366u)      /* Second by second stepping */
+
+static uint64 testWdtTicks;                     /* WDT time, 1/32768 s */
+static int32 testWdtPpm;
+
+
+/*******************************************************************************
+* Function Name: WDT_ReadTime
+********************************************************************************
+*
+* Summary:
+*   Returns the simulated WDT time.
+*
+*******************************************************************************/
+uint32 WDT_ReadTime(uint32 *ticks)
+{
+    *ticks = (uint32)(testWdtTicks & ((1u << WDT_TICKS_SHIFT) - 1u));
+    return((uint32)(testWdtTicks >> WDT_TICKS_SHIFT));
+}
+
+
+/*******************************************************************************
+* Function Name: TestRunTo
+********************************************************************************
+*
+* Summary:
+*   Runs the WDT up to the given true time, delivering every one second
+*   tick to the calendar as the main loop does.
+*
+* Parameters:
+*   trueSeconds - true time since the start of the test.
+*
+*******************************************************************************/
+static void TestRunTo(uint32 trueSeconds)
+{
+    uint64 target = ((((uint64)trueSeconds << WDT_TICKS_SHIFT) * (uint64)(RTC_PPM + testWdtPpm)) /
+                     (uint64)RTC_PPM);
+
+    while(wdtSeconds < (uint32)(target >> WDT_TICKS_SHIFT))
+    {
+        wdtSeconds++;
+        testWdtTicks = (uint64)wdtSeconds << WDT_TICKS_SHIFT;
+        RtcUpdate();
+    }
+    testWdtTicks = target;
+}
+
+
+/*******************************************************************************
+* Function Name: TestTime
+********************************************************************************
+*
+* Summary:
+*   Packs a time into one word for the checks.
+*
+*******************************************************************************/
+static int32 TestTime(const CYBLE_DATE_TIME_T *time)
+{
+    return((int32)((((uint32)(time->year - RTC_YEAR_MIN) << 26u) | ((uint32)time->month << 22u) |
+                    ((uint32)time->day << 17u) | ((uint32)time->hours << 12u) |
+                    ((uint32)time->minutes << 6u) | time->seconds)));
+}
+
+
+/*******************************************************************************
+* Function Name: TestRollover
+********************************************************************************
+*
+* Summary:
+*   Resumes the calendar one second before the given time and checks the
+*   time after one tick.
+*
+*******************************************************************************/
+static void TestRollover(uint16 year, uint8 month, uint8 day, uint16 nextYear, uint8 nextMonth, uint8 nextDay)
+{
+    CYBLE_DATE_TIME_T time = {year, month, day, 23u, 59u, 59u};
+    CYBLE_DATE_TIME_T next = {nextYear, nextMonth, nextDay, 0u, 0u, 0u};
+
+    RtcResume(&time);
+    wdtSeconds++;
+    testWdtTicks = (uint64)wdtSeconds << WDT_TICKS_SHIFT;
+    RtcGetTime(&time);
+    TEST_EQUAL(TestTime(&time), TestTime(&next));
+}
+
+
+int main(void)
+{
+    CYBLE_DATE_TIME_T time;
+    CYBLE_DATE_TIME_T step;
+    CYBLE_DATE_TIME_T reference = {2016u, 3u, 1u, 0u, 0u, 0u};
+    uint32 epoch0;
+    uint32 seconds;
+    uint32 mismatches = 0u;
+    int32 error;
+    int32 uncorrected;
+
+    RtcInit();
+
+    /* Rollovers */
+    TestRollover(2015u, 12u, 31u, 2016u, 1u, 1u);
+    TestRollover(2015u, 2u, 28u, 2015u, 3u, 1u);
+    TestRollover(2016u, 2u, 28u, 2016u, 2u, 29u);
+    TestRollover(2016u, 2u, 29u, 2016u, 3u, 1u);
+    TestRollover(2015u, 4u, 30u, 2015u, 5u, 1u);
+    TestRollover(2015u, 7u, 31u, 2015u, 8u, 1u);
+
+    /* Month out of range: refused as a reference, rolled over if resumed */
+    time = reference;
+    time.month = 0u;
+    TEST_EQUAL(RtcSetTime(&time), DISABLED);
+    time.month = 13u;
+    TEST_EQUAL(RtcSetTime(&time), DISABLED);
+    TEST_EQUAL(RtcDaysInMonth(&time), 0u);
+    TestRollover(2015u, 13u, 31u, 2016u, 1u, 1u);
+    time.month = 13u;
+    RtcAddSeconds(&time, RTC_SECONDS_PER_DAY);
+    TEST_EQUAL(time.month, 1u);
+    TEST_EQUAL(time.year, 2017u);
+
+    /* RtcAddSeconds() and RtcToEpoch() agree with stepping second by second over a leap year */
+    step = reference;
+    step.year = 2015u;
+    epoch0 = RtcToEpoch(&step);
+    RtcResume(&step);
+    for(seconds = 1u; seconds <= (TEST_STEP_DAYS * RTC_SECONDS_PER_DAY); seconds++)
+    {
+        RtcAddSecond();
+        if((seconds % 3607u) == 0u)
+        {
+            time = step;
+            RtcAddSeconds(&time, seconds);
+            if((TestTime(&time) != TestTime(&rtcTime)) || (RtcToEpoch(&rtcTime) != (epoch0 + seconds)))
+            {
+                mismatches++;
+            }
+        }
+    }
+    TEST_EQUAL(mismatches, 0u);
+    TEST_EQUAL(rtcTime.year, 2016u);
+    TEST_EQUAL(rtcTime.month, 3u);
+    TEST_EQUAL(rtcTime.day, 1u);
+
+    /* Drift: two references a few days apart with a fast WDT */
+    rtcAnchorValid = DISABLED;
+    rtcDriftPpm = 0;
+    testWdtPpm = TEST_WDT_PPM;
+    testWdtTicks = 0u;
+    wdtSeconds = 0u;
+    RtcInit();
+    TEST_EQUAL(RtcSetTime(&reference), ENABLED);
+    epoch0 = RtcToEpoch(&reference);
+
+    TestRunTo(TEST_DRIFT_SPAN_DAYS * RTC_SECONDS_PER_DAY);
+    RtcGetTime(&time);
+    uncorrected = (int32)(RtcToEpoch(&time) - epoch0) - (int32)(TEST_DRIFT_SPAN_DAYS * RTC_SECONDS_PER_DAY);
+    TEST_CHECK(uncorrected > 0);
+    time = reference;
+    RtcAddSeconds(&time, TEST_DRIFT_SPAN_DAYS * RTC_SECONDS_PER_DAY);
+    TEST_EQUAL(RtcSetTime(&time), ENABLED);
+    TEST_CHECK((rtcDriftPpm >= (TEST_WDT_PPM - 1)) && (rtcDriftPpm <= (TEST_WDT_PPM + 1)));
+
+    TestRunTo((TEST_DRIFT_SPAN_DAYS + TEST_RUN_DAYS) * RTC_SECONDS_PER_DAY);
+    RtcGetTime(&time);
+    error = (int32)(RtcToEpoch(&time) - epoch0) - (int32)((TEST_DRIFT_SPAN_DAYS + TEST_RUN_DAYS) * RTC_SECONDS_PER_DAY);
+    TEST_CHECK((error >= -1) && (error <= 1));
+
+    /* A reference earlier than the first one restarts the estimate */
+    time = reference;
+    time.month = 2u;
+    time.day = 29u;
+    TEST_EQUAL(RtcSetTime(&time), ENABLED);
+    TEST_EQUAL(rtcAnchorEpoch, epoch0 - RTC_SECONDS_PER_DAY);
+    TEST_EQUAL(rtcAnchorSeconds, wdtSeconds);
+
+    printf("WDT fast by %d ppm: %ld s ahead after %d days uncorrected, estimate %ld ppm, %ld s off after %d days \r\n",
+        TEST_WDT_PPM, uncorrected, TEST_DRIFT_SPAN_DAYS, rtcDriftPpm, error, TEST_RUN_DAYS);
+    return(TestResult("rtc"));
+}
+
+
+/* [] END OF FILE */
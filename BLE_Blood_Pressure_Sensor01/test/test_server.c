@@ -0,0 +1,370 @@
+/*******************************************************************************
+* File Name: test_server.c
+*
+* Version 1.0
+*
+* Description:
+*  CCCD cache of the bond slots, with the record upload of the Blood
+*  Pressure service. Collectors connect on a model of the component, which
+*  loads the CCCDs of a bonded peer from flash, and of the link, which runs
+*  one ATT exchange per connection event. The time from connect to the first
+*  record indication is measured for a bonded collector that relies on its
+*  subscription and for one that writes its CCCD again, and peers that are
+*  not bonded must neither get nor change the subscriptions of a bond slot.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <string.h>
+#include "test.h"
+#include "server.c"
+
+#define TEST_PEERS                  (CYBLE_GAP_MAX_BONDED_DEVICE + 1u)
+#define TEST_EVENTS                 (100u)      /* Connection events per connection */
+#define TEST_INTERVAL_MS            (30u)       /* Connection interval of the collector */
+#define TEST_NONE                   (0xFFFFFFFFu)
+
+/* Collectors: bonded patients, guests that never pair, one that pairs */
+#define TEST_PATIENT                (0u)
+#define TEST_PATIENT2               (1u)
+#define TEST_GUEST                  (2u)
+#define TEST_GUEST2                 (3u)
+#define TEST_LATE                   (4u)
+#define TEST_COLLECTORS             (5u)
+
+const uint8 cyBle_attValuesCCCDFlashMemory[CYBLE_GAP_MAX_BONDED_DEVICE + 1u][CYBLE_GATT_DB_CCCD_COUNT];
+
+static CYBLE_GAP_BD_ADDR_T testAddr[TEST_COLLECTORS];
+static CYBLE_GAP_BD_ADDR_T testPeer[TEST_PEERS];        /* Address of the peer by device handle */
+static CYBLE_GAP_BONDED_DEV_ADDR_LIST_T testBonded;
+static uint8 testQuiet;
+static uint32 testEvent;                                /* Connection event on the air */
+static uint32 testFirst;                                /* Event of the first indication */
+static uint8 testFirstUser;                             /* Partition it was read from */
+static uint8 testAir;
+static uint32 testMinute;
+
+extern CYBLE_BLS_BPM_T blsBpm[];
+
+
+/***************************************
+*       BLE stack
+***************************************/
+CYBLE_API_RESULT_T CyBle_GapGetPeerBdAddr(uint8 bdHandle, CYBLE_GAP_BD_ADDR_T* peerBdAddr)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_NO_DEVICE_ENTITY;
+
+    if(bdHandle < TEST_PEERS)
+    {
+        *peerBdAddr = testPeer[bdHandle];
+        apiResult = CYBLE_ERROR_OK;
+    }
+    return(apiResult);
+}
+
+CYBLE_API_RESULT_T CyBle_GapGetBondedDevicesList(CYBLE_GAP_BONDED_DEV_ADDR_LIST_T* bondedDevList)
+{
+    *bondedDevList = testBonded;
+    return(CYBLE_ERROR_OK);
+}
+
+CYBLE_API_RESULT_T CyBle_BlssSendIndication(CYBLE_CONN_HANDLE_T connHandle, CYBLE_BLS_CHAR_INDEX_T charIndex,
+    uint8 attrSize, uint8 *attrValue)
+{
+    TEST_EQUAL(testAir, DISABLED);
+    if(testFirst == TEST_NONE)
+    {
+        testFirst = testEvent;
+        testFirstUser = blsUser;
+    }
+    testAir = ENABLED;
+    return(CYBLE_ERROR_OK);
+}
+
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testQuiet == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+}
+
+uint8 RacpBusy(void)
+{
+    return(DISABLED);
+}
+
+void RacpReportDone(uint8 rspCode)
+{
+    TEST_CHECK(DISABLED);
+}
+
+
+/*******************************************************************************
+* Function Name: TestBonded
+********************************************************************************
+*
+* Summary:
+*   Returns ENABLED if the address is in the bonded device list.
+*
+*******************************************************************************/
+static uint8 TestBonded(const CYBLE_GAP_BD_ADDR_T *addr)
+{
+    uint8 bonded = DISABLED;
+    uint8 i;
+
+    for(i = 0u; i < testBonded.count; i++)
+    {
+        if(memcmp(&testBonded.bdAddrList[i], addr, sizeof(*addr)) == 0)
+        {
+            bonded = ENABLED;
+        }
+    }
+    return(bonded);
+}
+
+
+/*******************************************************************************
+* Function Name: TestSubscribe
+********************************************************************************
+*
+* Summary:
+*   The collector writes the CCCD of the Blood Pressure Measurement: the
+*   component updates the database and calls the service back.
+*
+*******************************************************************************/
+static void TestSubscribe(void)
+{
+    CyBle_Set16ByPtr(CYBLE_GATT_DB_ATTR_GET_ATTR_GEN_PTR(cyBle_blss.charInfo[CYBLE_BLS_BPM].cccdHandle),
+        CYBLE_CCCD_INDICATION);
+    BlsCallBack(CYBLE_EVT_BLSS_INDICATION_ENABLED, NULL);
+}
+
+
+/*******************************************************************************
+* Function Name: TestConnection
+********************************************************************************
+*
+* Summary:
+*   Runs a connection of the collector on the device handle the stack hands
+*   out. A new record waits in the partition of the peer. The component
+*   loads the CCCDs stored in flash for a bonded peer and clears them for
+*   any other, then the application handles the connection. In each
+*   connection event the main loop has run the upload before, the
+*   indication goes out, and the collector's write request is processed
+*   after it; the confirmation returns in the next event. The link is lost
+*   after TEST_EVENTS events, without the component storing the CCCDs.
+*
+* Parameters:
+*   collector - the collector.
+*   bdHandle - its device handle.
+*   rewrite - ENABLED if it writes its CCCD in the first event.
+*
+* Return:
+*   The connection event of the first indication, TEST_NONE if there was none.
+*
+*******************************************************************************/
+static uint32 TestConnection(uint8 collector, uint8 bdHandle, uint8 rewrite)
+{
+    CYBLE_BLS_BPM_T bpm = blsBpm[0u];
+    uint8 confirm = DISABLED;
+
+    testPeer[bdHandle] = testAddr[collector];
+    bpm.time.minutes = (uint8)(testMinute % 60u);
+    testMinute++;
+    testQuiet = ENABLED;
+    (void)RecordAppend(RecordUserOf(bdHandle), &bpm);
+
+    cyBle_connHandle.bdHandle = bdHandle;
+    cyBle_state = CYBLE_STATE_CONNECTED;
+    if(TestBonded(&testAddr[collector]) == ENABLED)
+    {
+        (void)memcpy(cyBle_attValuesCCCD, cyBle_attValuesCCCDFlashMemory[bdHandle], CYBLE_GATT_DB_CCCD_COUNT);
+    }
+    else
+    {
+        (void)memset(cyBle_attValuesCCCD, 0, CYBLE_GATT_DB_CCCD_COUNT);
+    }
+    ServerConnected();
+    BlsConnected();
+
+    testFirst = TEST_NONE;
+    testAir = DISABLED;
+    for(testEvent = 1u; testEvent <= TEST_EVENTS; testEvent++)
+    {
+        if(confirm == ENABLED)
+        {
+            testAir = DISABLED;
+            confirm = DISABLED;
+            BlsCallBack(CYBLE_EVT_BLSS_INDICATION_CONFIRMED, NULL);
+        }
+        if(0u != (blsFlag & IND))
+        {
+            BlsUpload();
+        }
+        confirm = testAir;
+        if((rewrite == ENABLED) && (testEvent == 1u))
+        {
+            TestSubscribe();
+        }
+    }
+
+    cyBle_state = CYBLE_STATE_DISCONNECTED;
+    cyBle_connHandle.bdHandle = 0u;
+    ServerDisconnected();
+    testQuiet = DISABLED;
+    return(testFirst);
+}
+
+
+/*******************************************************************************
+* Function Name: TestFirstData
+********************************************************************************
+*
+* Summary:
+*   A bonded patient subscribes and the link is lost before the component
+*   stores the CCCDs. On the next connections the cache gets the first
+*   record out in the first connection event; without it nothing comes until
+*   the collector writes its CCCD again.
+*
+*******************************************************************************/
+static void TestFirstData(void)
+{
+    uint32 cached;
+    uint32 rewritten;
+
+    TEST_EQUAL(TestConnection(TEST_PATIENT, 1u, ENABLED), 2u);
+
+    cached = TestConnection(TEST_PATIENT, 1u, DISABLED);
+    rewritten = TestConnection(TEST_PATIENT, 1u, ENABLED);
+#if (SERVER_CCCD_CACHE != 0)
+    TEST_EQUAL(cached, 1u);
+    TEST_EQUAL(rewritten, 1u);
+    TEST_EQUAL(testFirstUser, 1u);
+    printf("Connect to first data: %ld ms, %ld ms with a CCCD write \r\n",
+        cached * TEST_INTERVAL_MS, rewritten * TEST_INTERVAL_MS);
+#else
+    TEST_EQUAL(cached, TEST_NONE);
+    TEST_EQUAL(rewritten, 2u);
+    printf("Connect to first data: none in %ld ms, %ld ms with a CCCD write \r\n",
+        TEST_EVENTS * TEST_INTERVAL_MS, rewritten * TEST_INTERVAL_MS);
+#endif /* (SERVER_CCCD_CACHE != 0) */
+
+    /* Once the component has stored them, the CCCDs come from flash as well */
+    CyBle_Set16ByPtr(CYBLE_GATT_DB_ATTR_GET_ATTR_GEN_PTR(cyBle_blss.charInfo[CYBLE_BLS_BPM].cccdHandle),
+        CYBLE_CCCD_INDICATION);
+    (void)CyBle_StoreAppData(cyBle_attValuesCCCD, cyBle_attValuesCCCDFlashMemory[1u], CYBLE_GATT_DB_CCCD_COUNT, 0u);
+    TEST_EQUAL(TestConnection(TEST_PATIENT, 1u, DISABLED), 1u);
+    (void)memset(cyBle_attValuesCCCD, 0, CYBLE_GATT_DB_CCCD_COUNT);
+    (void)CyBle_StoreAppData(cyBle_attValuesCCCD, cyBle_attValuesCCCDFlashMemory[1u], CYBLE_GATT_DB_CCCD_COUNT, 0u);
+}
+
+
+/*******************************************************************************
+* Function Name: TestGuests
+********************************************************************************
+*
+* Summary:
+*   A guest handed the device handle of a bonded patient starts unsubscribed
+*   and its own subscription does not reach the patient's slot. A guest on
+*   another handle does not inherit the subscription of the previous guest,
+*   and a second patient keeps a slot of its own.
+*
+*******************************************************************************/
+static void TestGuests(void)
+{
+    uint32 patient;
+
+    patient = TestConnection(TEST_PATIENT, 1u, DISABLED);
+
+    TEST_EQUAL(TestConnection(TEST_GUEST, 1u, DISABLED), TEST_NONE);
+    TEST_EQUAL(blsFlag, 0u);
+    TEST_EQUAL(TestConnection(TEST_GUEST, 1u, ENABLED), 2u);
+    TEST_EQUAL(testFirstUser, REC_USER_GUEST);
+
+    /* The patient is back on its handle with its own subscription */
+    TEST_EQUAL(TestConnection(TEST_PATIENT, 1u, DISABLED), patient);
+
+    /* The guest subscribed last: neither it nor the next guest keeps it */
+    TEST_EQUAL(TestConnection(TEST_GUEST, 1u, ENABLED), 2u);
+    TEST_EQUAL(TestConnection(TEST_GUEST2, 0u, DISABLED), TEST_NONE);
+    TEST_EQUAL(TestConnection(TEST_GUEST, 2u, DISABLED), TEST_NONE);
+    TEST_EQUAL(TestConnection(TEST_GUEST, 1u, DISABLED), TEST_NONE);
+
+    /* The unsubscribed second patient is not given the first one's CCCDs */
+    TEST_EQUAL(TestConnection(TEST_PATIENT2, 3u, DISABLED), TEST_NONE);
+    TEST_EQUAL(TestConnection(TEST_PATIENT2, 3u, ENABLED), 2u);
+    TEST_EQUAL(testFirstUser, 3u);
+    TEST_EQUAL(TestConnection(TEST_PATIENT, 1u, DISABLED), patient);
+}
+
+
+/*******************************************************************************
+* Function Name: TestBonding
+********************************************************************************
+*
+* Summary:
+*   A peer that subscribes and bonds during the connection keeps its
+*   subscription for the next connection.
+*
+*******************************************************************************/
+static void TestBonding(void)
+{
+    CYBLE_BLS_BPM_T bpm = blsBpm[0u];
+
+    TEST_EQUAL(TestConnection(TEST_LATE, 2u, DISABLED), TEST_NONE);
+
+    /* Subscribes, then pairs with bonding before the link is lost */
+    testQuiet = ENABLED;
+    testPeer[2u] = testAddr[TEST_LATE];
+    (void)RecordAppend(REC_USER_GUEST, &bpm);
+    cyBle_connHandle.bdHandle = 2u;
+    (void)memset(cyBle_attValuesCCCD, 0, CYBLE_GATT_DB_CCCD_COUNT);
+    ServerConnected();
+    BlsConnected();
+    TestSubscribe();
+    testBonded.bdAddrList[testBonded.count] = testAddr[TEST_LATE];
+    testBonded.count++;
+    ServerDisconnected();
+    testQuiet = DISABLED;
+
+#if (SERVER_CCCD_CACHE != 0)
+    TEST_EQUAL(TestConnection(TEST_LATE, 2u, DISABLED), 1u);
+    TEST_EQUAL(testFirstUser, 2u);
+#else
+    TEST_EQUAL(TestConnection(TEST_LATE, 2u, DISABLED), TEST_NONE);
+#endif /* (SERVER_CCCD_CACHE != 0) */
+}
+
+
+int main(void)
+{
+    uint8 i;
+
+    for(i = 0u; i < TEST_COLLECTORS; i++)
+    {
+        testAddr[i].bdAddr[0u] = (uint8)(0xC0u + i);
+        testAddr[i].bdAddr[5u] = 0x5Au;
+    }
+    testBonded.count = 2u;
+    testBonded.bdAddrList[0u] = testAddr[TEST_PATIENT2];
+    testBonded.bdAddrList[1u] = testAddr[TEST_PATIENT];
+
+    testQuiet = ENABLED;
+    RecordInit();
+    ServerCccdInit();
+    testQuiet = DISABLED;
+
+    TestFirstData();
+    TestGuests();
+    TestBonding();
+
+    return(TestResult("server"));
+}
+
+
+/* [] END OF FILE */
@@ -0,0 +1,472 @@
+/*******************************************************************************
+* File Name: test_wave.c
+*
+* Version 1.0
+*
+* Description:
+*  Streams a simulated cuff waveform over a simulated link. The sample clock
+*  interrupt, the main loop, the stack buffers and the connection events run
+*  on the WDT clock. The collector decodes every notification and checks the
+*  samples against the converted ones. At the 20-byte payload of the
+*  default MTU a fast link has to carry the full rate without a loss; a
+*  slow link has to lose whole packets and report every one.
+*
+*  The link layer of the BLE 4.1 stack carries 27 bytes of a notification
+*  in a data packet, the rest goes in further packets. The radio is on for
+*  the packets of both sides, the interframe spaces between them and the
+*  start of every connection event it takes part in; the same stream is
+*  measured at the MTUs a collector may negotiate up to CYBLE_GATT_MTU,
+*  with and without a slave latency.
+*
+********************************************************************************
+* Copyright 2015, Cypress Semiconductor Corporation.  All rights reserved.
+* You may use this file only in accordance with the license, terms, conditions,
+* disclaimers, and limitations in the end user license agreement accompanying
+* the software package with which this file was provided.
+*******************************************************************************/
+
+#include <math.h>
+#include "test.h"
+#include "wave.c"
+
+#define TEST_SECONDS                (20u)
+#define TEST_MAIN_LOOP_TICKS        (33u)       /* The main loop runs about every millisecond */
+#define TEST_STACK_BUFFERS          (3u)        /* Notifications the stack holds for the link */
+#define TEST_INPUT_MAX              (WAVE_RATE_MAX * (TEST_SECONDS + 1u))
+#define TEST_BLOCK_SLACK            ((CODEC_ESCAPE + CODEC_RAW_BITS) / 8u)  /* Bytes a block may end short by */
+
+/* Link layer at 1 Mbit/s, encrypted as a bonded link is */
+#define TEST_LL_PAYLOAD             (27u)       /* Data packet payload without the length extension */
+#define TEST_LL_OVERHEAD            (10u)       /* Preamble, access address, header and CRC */
+#define TEST_LL_MIC                 (4u)        /* Added to a packet with a payload */
+#define TEST_L2CAP_HDR_SIZE         (4u)
+#define TEST_US_PER_BYTE            (8u)
+#define TEST_T_IFS                  (150u)      /* Interframe space, us */
+#define TEST_EVENT_START            (200u)      /* Radio start-up and receive window widening, us, assumed */
+
+/* Link of one run */
+typedef struct
+{
+    uint16 rate;                                /* Requested samples per second */
+    uint16 interval;                            /* Connection interval, 1.25 ms units */
+    uint8  perEvent;                            /* Data packets sent in a connection event */
+    uint16 mtu;                                 /* ATT MTU negotiated by the collector */
+    uint8  latency;                             /* Connection events the server may skip without data */
+}TEST_LINK_T;
+
+static uint32 testPeriod;                       /* Sample clock period, WDT ticks */
+static uint32 testRandom = 1u;
+static uint8 testQuiet;
+
+/* Converted samples, by sample number */
+static int16 testInput[TEST_INPUT_MAX];
+static uint32 testInputs;
+
+/* Notifications held by the stack */
+static uint8 testStack[TEST_STACK_BUFFERS][WAVE_PKT_MAX];
+static uint8 testStackLen[TEST_STACK_BUFFERS];
+static uint8 testStackCount;
+static uint8 testStackSent;                     /* Data packets of the first one already sent */
+static uint32 testPayloadMax;
+static uint16 testMtu;
+
+/* Radio */
+static uint32 testLlPackets;                    /* Data packets with a payload */
+static uint32 testRadioUs;                      /* Radio on time */
+
+/* Collector */
+static uint16 testSeq;                          /* Next expected packet */
+static uint32 testReceived;                     /* Samples received */
+static uint32 testLost;                         /* Packets seen missing */
+static uint32 testMismatches;
+static uint32 testShort;                        /* Blocks ended before they were full */
+
+
+/*******************************************************************************
+* Function Name: UART_DEB_SpiUartWriteTxData
+********************************************************************************
+*
+* Summary:
+*   Discards the traces of the simulation.
+*
+*******************************************************************************/
+void UART_DEB_SpiUartWriteTxData(uint32 txData)
+{
+    if(testQuiet == DISABLED)
+    {
+        (void)putchar((int)txData);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: CySysWdtWriteMatch
+********************************************************************************
+*
+* Summary:
+*   Takes the sample clock period.
+*
+*******************************************************************************/
+void CySysWdtWriteMatch(uint32 counterNum, uint32 match)
+{
+    TEST_EQUAL(counterNum, WAVE_WDT_COUNTER);
+    testPeriod = match + 1u;
+}
+
+
+/*******************************************************************************
+* Function Name: ADC_GetResult16
+********************************************************************************
+*
+* Summary:
+*   Converts the cuff pressure: a deflation ramp with oscillations growing
+*   and fading around the mean arterial pressure, and a few counts of noise.
+*
+*******************************************************************************/
+int16 ADC_GetResult16(uint32 chan)
+{
+    double t = (double)testInputs / (double)waveStats.rate;
+    double ramp = 1600.0 - (60.0 * t);
+    double envelope = 30.0 * exp(-((ramp - 1000.0) * (ramp - 1000.0)) / (2.0 * 250.0 * 250.0));
+    int16 sample;
+
+    TEST_EQUAL(chan, ADC_PRESSURE_CHANNEL);
+    testRandom = (testRandom * 1103515245u) + 12345u;
+    sample = (int16)(ramp + (envelope * sin(2.0 * 3.14159265 * 1.2 * t)) + (double)((testRandom >> 16u) % 7u) - 3.0);
+    if(testInputs < TEST_INPUT_MAX)
+    {
+        testInput[testInputs] = sample;
+        testInputs++;
+    }
+    return(sample);
+}
+
+
+/*******************************************************************************
+* Function Name: CyBle_GattsNotification
+********************************************************************************
+*
+* Summary:
+*   Takes the notification into a stack buffer, or refuses it while they
+*   are all in use.
+*
+*******************************************************************************/
+CYBLE_API_RESULT_T CyBle_GattsNotification(CYBLE_CONN_HANDLE_T connHandle, CYBLE_GATTS_HANDLE_VALUE_NTF_T *ntfParam)
+{
+    CYBLE_API_RESULT_T apiResult = CYBLE_ERROR_MEMORY_ALLOCATION_FAILED;
+
+    TEST_EQUAL(ntfParam->attrHandle, CYBLE_WAVEFORM_DATA_CHAR_HANDLE);
+    TEST_CHECK(ntfParam->value.len <= (testMtu - WAVE_ATT_HDR_SIZE));
+    if(testStackCount < TEST_STACK_BUFFERS)
+    {
+        (void)memcpy(testStack[testStackCount], ntfParam->value.val, ntfParam->value.len);
+        testStackLen[testStackCount] = (uint8)ntfParam->value.len;
+        testStackCount++;
+        testPayloadMax = (ntfParam->value.len > testPayloadMax) ? ntfParam->value.len : testPayloadMax;
+        apiResult = CYBLE_ERROR_OK;
+    }
+    return(apiResult);
+}
+
+
+/*******************************************************************************
+* Function Name: TestCollect
+********************************************************************************
+*
+* Summary:
+*   The collector decodes a packet. Until the first loss the samples are
+*   compared with the converted ones; after it only the sequence numbers
+*   are followed. A block ends when the next sample does not fit in the
+*   payload, or at the sample count limit.
+*
+*******************************************************************************/
+static void TestCollect(const uint8 *pkt, uint8 len)
+{
+    int16 samples[CODEC_COUNT_MAX];
+    uint16 seq = (uint16)pkt[CODEC_HDR_SEQ] | ((uint16)pkt[CODEC_HDR_SEQ + 1u] << 8u);
+    uint8 count;
+    uint8 i;
+
+    count = CodecDecode(pkt, len, samples, CODEC_COUNT_MAX);
+    TEST_EQUAL(count, pkt[CODEC_HDR_COUNT]);
+    if((count != CODEC_COUNT_MAX) && ((len + TEST_BLOCK_SLACK) < (testMtu - WAVE_ATT_HDR_SIZE)))
+    {
+        testShort++;
+    }
+    testLost += (uint16)(seq - testSeq);
+    testSeq = seq + 1u;
+    if(testLost == 0u)
+    {
+        for(i = 0u; i < count; i++)
+        {
+            testMismatches += (samples[i] == testInput[testReceived + i]) ? 0u : 1u;
+        }
+    }
+    testReceived += count;
+}
+
+
+/*******************************************************************************
+* Function Name: TestPacketUs
+********************************************************************************
+*
+* Summary:
+*   Returns the air time of a data packet with the payload, in us.
+*
+*******************************************************************************/
+static uint32 TestPacketUs(uint32 payload)
+{
+    return((TEST_LL_OVERHEAD + payload + ((payload != 0u) ? TEST_LL_MIC : 0u)) * TEST_US_PER_BYTE);
+}
+
+
+/*******************************************************************************
+* Function Name: TestEvent
+********************************************************************************
+*
+* Summary:
+*   Connection event: the collector polls with an empty packet and the
+*   server answers with the next data packet of the stack buffers, in order,
+*   up to the limit of the link; a notification is delivered with its last
+*   data packet. Without data the server answers with an empty packet.
+*
+*******************************************************************************/
+static void TestEvent(const TEST_LINK_T *link)
+{
+    uint32 pdu;
+    uint32 packets;
+    uint8 sent = 0u;
+
+    testRadioUs += TEST_EVENT_START;
+    while((sent < link->perEvent) && (testStackCount != 0u))
+    {
+        pdu = (uint32)testStackLen[0u] + WAVE_ATT_HDR_SIZE + TEST_L2CAP_HDR_SIZE;
+        packets = (pdu + TEST_LL_PAYLOAD - 1u) / TEST_LL_PAYLOAD;
+        pdu = (testStackSent == (packets - 1u)) ? (pdu - (testStackSent * TEST_LL_PAYLOAD)) : TEST_LL_PAYLOAD;
+        testRadioUs += ((sent != 0u) ? TEST_T_IFS : 0u) + TestPacketUs(0u) + TEST_T_IFS + TestPacketUs(pdu);
+        testLlPackets++;
+        testStackSent++;
+        sent++;
+        if(testStackSent == packets)
+        {
+            TestCollect(testStack[0u], testStackLen[0u]);
+            testStackCount--;
+            testStackSent = 0u;
+            (void)memmove(testStack[0u], testStack[1u], (uint32)testStackCount * WAVE_PKT_MAX);
+            (void)memmove(testStackLen, &testStackLen[1u], testStackCount);
+        }
+    }
+    if(sent == 0u)
+    {
+        testRadioUs += TestPacketUs(0u) + TEST_T_IFS + TestPacketUs(0u);
+    }
+}
+
+
+/*******************************************************************************
+* Function Name: TestStream
+********************************************************************************
+*
+* Summary:
+*   Streams over the link for TEST_SECONDS and returns the throughput of the
+*   last second, as published in the Stats characteristic.
+*
+*******************************************************************************/
+static uint16 TestStream(const TEST_LINK_T *link)
+{
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T ctrl;
+    uint8 val[WAVE_CTRL_START_LEN] = {WAVE_CTRL_START, 0u, 0u};
+    uint32 eventTicks = ((uint32)link->interval * WAVE_CLOCK_HZ * 5u) / 4000u;
+    uint32 tick;
+    uint8 skipped = 0u;
+    uint8 queued;
+    uint8 i;
+
+    testInputs = 0u;
+    testStackCount = 0u;
+    testStackSent = 0u;
+    testLlPackets = 0u;
+    testRadioUs = 0u;
+    testSeq = 0u;
+    testReceived = 0u;
+    testLost = 0u;
+    testMismatches = 0u;
+    testShort = 0u;
+
+    testMtu = link->mtu;
+    WaveSetMtu(link->mtu);
+    val[1u] = LO8(link->rate);
+    val[2u] = HI8(link->rate);
+    ctrl.attrHandle = CYBLE_WAVEFORM_CTRL_CHAR_HANDLE;
+    ctrl.value.val = val;
+    ctrl.value.len = sizeof(val);
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_NONE);
+    TEST_EQUAL(WaveRunning(), ENABLED);
+
+    for(tick = 1u; tick <= (TEST_SECONDS * WAVE_CLOCK_HZ); tick++)
+    {
+        if((tick % testPeriod) == 0u)
+        {
+            WaveSample();
+        }
+        if((tick % TEST_MAIN_LOOP_TICKS) == 0u)
+        {
+            WaveProcess();
+        }
+        if((tick % eventTicks) == 0u)
+        {
+            if((testStackCount != 0u) || (skipped == link->latency))
+            {
+                TestEvent(link);
+                skipped = 0u;
+            }
+            else
+            {
+                skipped++;
+            }
+        }
+        if((tick % WAVE_CLOCK_HZ) == 0u)
+        {
+            WaveTick();
+        }
+    }
+
+    /* The link drains the stack buffers; the packets still queued are discarded at the stop */
+    for(i = 0u; i < testStackCount; i++)
+    {
+        TestCollect(testStack[i], testStackLen[i]);
+    }
+    testStackCount = 0u;
+    queued = (uint8)(waveHead - waveTail);
+
+    /* Every packet notified arrives, every packet dropped is reported, the samples are exact */
+    TEST_EQUAL(testMismatches, 0u);
+    TEST_EQUAL(testShort, 0u);
+    TEST_EQUAL(waveStats.packets, testSeq - testLost);
+    TEST_EQUAL(waveStats.dropped, testLost + ((waveSeq - testSeq) - queued));
+
+    val[0u] = WAVE_CTRL_STOP;
+    ctrl.value.len = 1u;
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_NONE);
+    TEST_EQUAL(WaveRunning(), DISABLED);
+
+    testQuiet = DISABLED;
+    printf("%d samples/s requested, %ld us interval, %d per event, MTU %d: %d samples/s, %ld samples in %ld packets, "
+        "%ld dropped \r\n", link->rate, (uint32)link->interval * 1250u, link->perEvent, link->mtu,
+        waveStats.throughput, testReceived, waveStats.packets, waveStats.dropped);
+    testQuiet = ENABLED;
+    return(waveStats.throughput);
+}
+
+
+/*******************************************************************************
+* Function Name: TestMtu
+********************************************************************************
+*
+* Summary:
+*   Streams the full rate over a link of a 30 ms interval at each MTU and
+*   reports the notifications and data packets per second, the radio on
+*   time per second and the time a block takes to fill. Returns the radio
+*   on time at the default MTU and at CYBLE_GATT_MTU, in us per second.
+*
+*******************************************************************************/
+static void TestMtu(uint8 latency, uint32 *radioUsDefault, uint32 *radioUsMax)
+{
+    static const uint16 mtus[] = {CYBLE_GATT_DEFAULT_MTU, 64u, 128u, CYBLE_GATT_MTU};
+    TEST_LINK_T link = {WAVE_RATE_MAX, 24u, 6u, 0u, 0u};
+    uint32 notifications;
+    uint32 lastNotifications = 0xFFFFFFFFu;
+    uint32 radioUs = 0u;
+    uint8 i;
+
+    link.latency = latency;
+    for(i = 0u; i < (sizeof(mtus) / sizeof(mtus[0u])); i++)
+    {
+        link.mtu = mtus[i];
+        (void)TestStream(&link);
+        TEST_EQUAL(testLost, 0u);
+        TEST_EQUAL(waveStats.dropped, 0u);
+
+        notifications = waveStats.packets / TEST_SECONDS;
+        radioUs = testRadioUs / TEST_SECONDS;
+        TEST_CHECK(notifications <= lastNotifications);
+        lastNotifications = notifications;
+        if(i == 0u)
+        {
+            *radioUsDefault = radioUs;
+        }
+
+        testQuiet = DISABLED;
+        printf("MTU %d, latency %d: %ld notifications/s, %ld data packets/s, radio on %ld us/s, "
+            "a block fills in %ld ms \r\n", link.mtu, link.latency, notifications, testLlPackets / TEST_SECONDS,
+            radioUs, (testReceived * 1000u) / (waveStats.packets * (uint32)waveStats.rate));
+        testQuiet = ENABLED;
+    }
+    *radioUsMax = radioUs;
+}
+
+
+int main(void)
+{
+    /* At the default MTU, before or without an MTU exchange */
+    static const TEST_LINK_T fast = {WAVE_RATE_MAX, 6u, 4u, CYBLE_GATT_DEFAULT_MTU, 0u};       /* 7.5 ms, several per event */
+    static const TEST_LINK_T slow = {250u, 40u, 1u, CYBLE_GATT_DEFAULT_MTU, 0u};                /* 50 ms, one per event */
+    static const TEST_LINK_T congested = {WAVE_RATE_MAX, 80u, 1u, CYBLE_GATT_DEFAULT_MTU, 0u};  /* 100 ms, one per event */
+    CYBLE_GATT_HANDLE_VALUE_PAIR_T ctrl;
+    uint8 val[WAVE_CTRL_START_LEN] = {WAVE_CTRL_START, LO8(WAVE_RATE_MAX + 1u), HI8(WAVE_RATE_MAX + 1u)};
+    uint16 throughput;
+    uint32 radioUsDefault;
+    uint32 radioUsMax;
+
+    testQuiet = ENABLED;
+    TEST_EQUAL(WAVE_PKT_MAX, CYBLE_GATT_MTU - WAVE_ATT_HDR_SIZE);
+
+    /* Control writes out of range or malformed are refused */
+    ctrl.attrHandle = CYBLE_WAVEFORM_CTRL_CHAR_HANDLE;
+    ctrl.value.val = val;
+    ctrl.value.len = sizeof(val);
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_OUT_OF_RANGE);
+    val[1u] = 0u;
+    val[2u] = 0u;
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_OUT_OF_RANGE);
+    ctrl.value.len = 2u;
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_INVALID_ATTRIBUTE_LEN);
+    val[0u] = WAVE_CTRL_START + 1u;
+    TEST_EQUAL(WaveWriteRequest(&ctrl), CYBLE_GATT_ERR_REQUEST_NOT_SUPPORTED);
+    TEST_EQUAL(WaveRunning(), DISABLED);
+
+    /* A fast link carries the full rate */
+    throughput = TestStream(&fast);
+    TEST_EQUAL(testLost, 0u);
+    TEST_EQUAL(testPayloadMax, fast.mtu - WAVE_ATT_HDR_SIZE);
+    TEST_CHECK((throughput + 40u) >= waveStats.rate);
+    TEST_CHECK(throughput <= (waveStats.rate + 40u));
+    TEST_CHECK(testReceived >= ((TEST_SECONDS - 1u) * waveStats.rate));
+
+    /* A slow link that keeps up with a low rate */
+    throughput = TestStream(&slow);
+    TEST_EQUAL(testLost, 0u);
+    TEST_CHECK((throughput + 40u) >= waveStats.rate);
+
+    /* A link too slow for the rate loses whole packets and reports them */
+    throughput = TestStream(&congested);
+    TEST_CHECK(testLost > 0u);
+    TEST_CHECK(throughput < (waveStats.rate / 2u));
+
+    /* Without a slave latency the connection events set the radio on time, a larger MTU does not
+    *  save any; with it the server sleeps through the events without data and a larger MTU leaves
+    *  more of them */
+    TestMtu(0u, &radioUsDefault, &radioUsMax);
+    TestMtu(4u, &radioUsDefault, &radioUsMax);
+    TEST_CHECK(radioUsMax < radioUsDefault);
+
+    /* At the full rate the sample count ends a block before CYBLE_GATT_MTU is full; the unused
+    *  bytes are not sent */
+    TEST_CHECK(testPayloadMax < WAVE_PKT_MAX);
+
+    testQuiet = DISABLED;
+    return(TestResult("wave"));
+}
+
+
+/* [] END OF FILE */